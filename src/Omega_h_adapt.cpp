@@ -5,12 +5,16 @@
 #include "Omega_h_coarsen.hpp"
 #include "Omega_h_confined.hpp"
 #include "Omega_h_conserve.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_ghost.hpp"
 #include "Omega_h_histogram.hpp"
 #include "Omega_h_laplace.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_metric.hpp"
 #include "Omega_h_profile.hpp"
 #include "Omega_h_quality.hpp"
 #include "Omega_h_refine.hpp"
+#include "Omega_h_smooth.hpp"
 #include "Omega_h_swap.hpp"
 #include "Omega_h_timer.hpp"
 #include "Omega_h_transfer.hpp"
@@ -82,6 +86,17 @@ AdaptOpts::AdaptOpts(Int dim) {
   should_swap = true;
   should_coarsen_slivers = true;
   should_prevent_coarsen_flip = false;
+  should_combine_refine_coarsen = false;
+  should_refine_multiple_edges = false;
+  nindset_quality_buckets = 0;
+  nswap_rebuilds_per_ghost = 1;
+  should_unghost_locally = false;
+  nsmooth_sets = 0;
+  max_adapt_seconds = -1.0;
+  max_adapt_rebuilds = -1;
+  min_pass_improvement = 0.0;
+  max_imbalance = -1.0;
+  should_weight_imbalance = false;
 }
 
 static Reals get_fixable_qualities(Mesh* mesh, AdaptOpts const&) {
@@ -96,53 +111,106 @@ Real min_fixable_quality(Mesh* mesh, AdaptOpts const& opts) {
   return get_min(mesh->comm(), get_fixable_qualities(mesh, opts));
 }
 
+void unghost_for_rebuild(Mesh* mesh, AdaptOpts const& opts) {
+  if (opts.should_unghost_locally && mesh->comm()->size() > 1 &&
+      mesh->parting() == OMEGA_H_GHOSTED && !mesh->has_any_parents()) {
+    unghost_mesh(mesh);
+  }
+  mesh->set_parting(OMEGA_H_ELEM_BASED, false);
+}
+
 AdaptOpts::AdaptOpts(Mesh* mesh) : AdaptOpts(mesh->dim()) {}
 
-static void adapt_summary(Mesh* mesh, AdaptOpts const& opts,
-    MinMax<Real> qualstats, MinMax<Real> lenstats) {
-  print_goal_stats(mesh, "quality", mesh->dim(),
-      get_fixable_qualities(mesh, opts),
-      {opts.min_quality_allowed, opts.min_quality_desired}, qualstats);
-  print_goal_stats(mesh, "length", EDGE, mesh->ask_lengths(),
-      {opts.min_length_desired, opts.max_length_desired}, lenstats);
+LOs get_length_candidates(Mesh* mesh, AdaptOpts const& opts) {
+  auto lengths = mesh->ask_lengths();
+  auto min_length = opts.min_length_desired;
+  auto max_length = opts.max_length_desired;
+  auto active2edges = LOs(mesh->nedges(), 0, 1);
+  auto has_active = mesh->has_tag(EDGE, "length_active");
+  if (has_active) {
+    active2edges = collect_marked(mesh->get_array<I8>(EDGE, "length_active"));
+  }
+  auto nactive = active2edges.size();
+  Write<I8> out_of_range(nactive);
+  auto f = OMEGA_H_LAMBDA(LO active) {
+    auto length = lengths[active2edges[active]];
+    out_of_range[active] = (length < min_length) || (length > max_length);
+  };
+  parallel_for(nactive, f, "get_length_candidates");
+  auto cands2active = collect_marked(Read<I8>(out_of_range));
+  auto cands2edges = unmap(cands2active, active2edges, 1);
+  if (has_active) {
+    mesh->set_tag(
+        EDGE, "length_active", mark_image(cands2edges, mesh->nedges()));
+  }
+  return cands2edges;
 }
 
-bool print_adapt_status(Mesh* mesh, AdaptOpts const& opts) {
-  OMEGA_H_TIME_FUNCTION;
-  auto qualstats = get_minmax(mesh->comm(), get_fixable_qualities(mesh, opts));
-  auto lenstats = get_minmax(mesh->comm(), mesh->ask_lengths());
+/* quality and length statistics in one pass over each array, with
+   histograms only when they will be printed */
+static std::vector<FieldStats> get_adapt_stats(
+    Mesh* mesh, AdaptOpts const& opts, bool with_histograms) {
+  FieldStatsInput quality = {mesh->dim(), get_fixable_qualities(mesh, opts),
+      with_histograms ? opts.nquality_histogram_bins : 0, 0.0, 1.0,
+      {opts.min_quality_allowed, opts.min_quality_desired}};
+  FieldStatsInput length = {EDGE, mesh->ask_lengths(),
+      with_histograms ? opts.nlength_histogram_bins : 0,
+      opts.length_histogram_min, opts.length_histogram_max,
+      {opts.min_length_desired, opts.max_length_desired}};
+  return get_field_stats(mesh, {quality, length});
+}
+
+static bool print_adapt_status(
+    Mesh* mesh, AdaptOpts const& opts, std::vector<FieldStats> const& stats) {
+  auto const& qualstats = stats[0];
+  auto const& lenstats = stats[1];
   if (opts.verbosity > SILENT) {
-    adapt_summary(mesh, opts, qualstats, lenstats);
+    print_goal_stats(mesh, "quality", mesh->dim(), qualstats,
+        {opts.min_quality_allowed, opts.min_quality_desired});
+    print_goal_stats(mesh, "length", EDGE, lenstats,
+        {opts.min_length_desired, opts.max_length_desired});
   }
-  return (qualstats.min >= opts.min_quality_desired &&
-          lenstats.min >= opts.min_length_desired &&
-          lenstats.max <= opts.max_length_desired);
+  return (qualstats.minmax.min >= opts.min_quality_desired &&
+          lenstats.minmax.min >= opts.min_length_desired &&
+          lenstats.minmax.max <= opts.max_length_desired);
 }
 
-void print_adapt_histograms(Mesh* mesh, AdaptOpts const& opts) {
-  auto qh = get_histogram(mesh, mesh->dim(), opts.nquality_histogram_bins, 0.0,
-      1.0, mesh->ask_qualities());
-  auto lh = get_histogram(mesh, EDGE, opts.nlength_histogram_bins,
-      opts.length_histogram_min, opts.length_histogram_max,
-      mesh->ask_lengths());
-  auto owned_qualities =
-      mesh->owned_array(mesh->dim(), mesh->ask_qualities(), 1);
-  auto qual_sum = get_sum(mesh->comm(), owned_qualities);
-  auto global_nelems = mesh->nglobal_ents(mesh->dim());
-  auto avg_qual = qual_sum / global_nelems;
+static void print_adapt_histograms(
+    Mesh* mesh, std::vector<FieldStats> const& stats) {
   if (can_print(mesh)) {
-    print_histogram(qh, "quality");
-    print_histogram(lh, "length");
-    std::cout << "average quality: " << avg_qual << '\n';
+    auto const& qualstats = stats[0];
+    print_histogram(qualstats.histogram, "quality");
+    print_histogram(stats[1].histogram, "length");
+    std::cout << "average quality: " << qualstats.mean << '\n';
+    std::cout << "quality quartiles: " << qualstats.quantile(0.25) << ' '
+              << qualstats.quantile(0.5) << ' ' << qualstats.quantile(0.75)
+              << '\n';
   }
 }
 
+bool print_adapt_status(Mesh* mesh, AdaptOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  return print_adapt_status(mesh, opts, get_adapt_stats(mesh, opts, false));
+}
+
+void print_adapt_histograms(Mesh* mesh, AdaptOpts const& opts) {
+  print_adapt_histograms(mesh, get_adapt_stats(mesh, opts, true));
+}
+
 static void validate(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_CHECK(0.0 <= opts.min_quality_allowed);
   OMEGA_H_CHECK(opts.min_quality_allowed <= opts.min_quality_desired);
   OMEGA_H_CHECK(opts.min_quality_desired <= 1.0);
   OMEGA_H_CHECK(opts.nsliver_layers >= 0);
   OMEGA_H_CHECK(opts.nsliver_layers < 100);
+  auto const nranks = mesh->comm()->size();
+  if (opts.max_imbalance > 0.0 && (nranks & (nranks - 1))) {
+    /* Mesh::balance() bisects recursively and cannot split the
+       ranks evenly otherwise */
+    Omega_h_fail(
+        "AdaptOpts::max_imbalance needs a power-of-two rank count, not %d\n",
+        nranks);
+  }
   auto mq = min_fixable_quality(mesh, opts);
   if (mq < opts.min_quality_allowed && !mesh->comm()->rank()) {
     std::cout << "WARNING: worst input element has quality " << mq
@@ -156,60 +224,216 @@ static bool pre_adapt(Mesh* mesh, AdaptOpts const& opts) {
   if (opts.verbosity >= EACH_ADAPT && !mesh->comm()->rank()) {
     std::cout << "before adapting:\n";
   }
-  if (print_adapt_status(mesh, opts)) return false;
-  if (opts.verbosity >= EXTRA_STATS) {
-    print_adapt_histograms(mesh, opts);
-  }
+  auto const extra_stats = (opts.verbosity >= EXTRA_STATS);
+  auto const stats = get_adapt_stats(mesh, opts, extra_stats);
+  if (print_adapt_status(mesh, opts, stats)) return false;
+  if (extra_stats) print_adapt_histograms(mesh, stats);
   if ((opts.verbosity >= EACH_REBUILD) && !mesh->comm()->rank()) {
     std::cout << "addressing edge lengths\n";
   }
   return true;
 }
 
-static void post_rebuild(Mesh* mesh, AdaptOpts const& opts) {
+/* what one adapt() call has spent so far, and the imbalance that
+   triggers the next rebalance. status stays ADAPT_SATISFIED until
+   something stops adaptation early */
+struct AdaptState {
+  Now start;
+  Int nrebuilds;
+  Int nrebalances;
+  GO nviolations;
+  Real max_imbalance;
+  AdaptStatus status;
+};
+
+static bool has_budget(AdaptOpts const& opts) {
+  return opts.max_adapt_seconds >= 0.0 || opts.max_adapt_rebuilds >= 0 ||
+         opts.min_pass_improvement > 0.0;
+}
+
+static GO count_length_violations(Mesh* mesh, AdaptOpts const& opts) {
+  auto lengths = mesh->ask_lengths();
+  auto edges_are_bad = lor_each(each_lt(lengths, opts.min_length_desired),
+      each_gt(lengths, opts.max_length_desired));
+  return get_sum(mesh->comm(), mesh->owned_array(EDGE, edges_are_bad, 1));
+}
+
+static GO count_quality_violations(Mesh* mesh, AdaptOpts const& opts) {
+  auto elems_are_bad =
+      each_lt(get_fixable_qualities(mesh, opts), opts.min_quality_desired);
+  return get_sum(
+      mesh->comm(), mesh->owned_array(mesh->dim(), elems_are_bad, 1));
+}
+
+/* the load imbalance compared to AdaptOpts::max_imbalance */
+static Real get_adapt_imbalance(Mesh* mesh, AdaptOpts const& opts) {
+  if (!opts.should_weight_imbalance) return mesh->imbalance();
+  auto complexity =
+      get_complexity_per_elem(mesh, mesh->get_array<Real>(VERT, "metric"));
+  auto local = get_sum(mesh->owned_array(mesh->dim(), complexity, 1));
+  auto comm = mesh->comm();
+  auto total = comm->allreduce(local, OMEGA_H_SUM);
+  if (total == 0.0) return 1.0;
+  auto max = comm->allreduce(local, OMEGA_H_MAX);
+  return max / (total / comm->size());
+}
+
+static void rebalance_if_needed(
+    Mesh* mesh, AdaptOpts const& opts, AdaptState* state) {
+  if (!(opts.max_imbalance > 0.0) || mesh->comm()->size() == 1) return;
+  auto imbalance = get_adapt_imbalance(mesh, opts);
+  if (imbalance <= state->max_imbalance) return;
+  if ((opts.verbosity >= EACH_REBUILD) && can_print(mesh)) {
+    std::cout << "rebalancing, imbalance was " << imbalance << '\n';
+  }
+  mesh->change_all_rcFieldsTorc();
+  mesh->balance(true);
+  mesh->change_all_rcFieldsToMesh();
+  ++state->nrebalances;
+  /* predictive weights differ from the loads measured here, so the next
+     rebalance waits until the imbalance has also grown by the allowed
+     factor over what this one reached */
+  state->max_imbalance = max2(opts.max_imbalance,
+      get_adapt_imbalance(mesh, opts) * opts.max_imbalance);
+}
+
+/* returns false once the budget has run out */
+static bool post_rebuild(
+    Mesh* mesh, AdaptOpts const& opts, AdaptState* state) {
   if (opts.verbosity >= EACH_REBUILD) print_adapt_status(mesh, opts);
+  ++state->nrebuilds;
+  if (opts.max_adapt_rebuilds >= 0 &&
+      state->nrebuilds >= opts.max_adapt_rebuilds) {
+    state->status = ADAPT_OUT_OF_REBUILDS;
+    return false;
+  }
+  if (opts.max_adapt_seconds >= 0.0) {
+    /* ranks must agree on when to stop */
+    auto seconds = mesh->comm()->allreduce(now() - state->start, OMEGA_H_MAX);
+    if (seconds >= opts.max_adapt_seconds) {
+      state->status = ADAPT_OUT_OF_TIME;
+      return false;
+    }
+  }
+  rebalance_if_needed(mesh, opts, state);
+  return true;
+}
+
+/* returns false if a pass left too many of the violations
+   counted before it (see AdaptOpts::min_pass_improvement).
+   passes that add violations, as refinement does while it cascades
+   through much too long edges, are not judged */
+static bool made_progress(
+    AdaptOpts const& opts, GO nviolations, AdaptState* state) {
+  auto old_nviolations = state->nviolations;
+  state->nviolations = nviolations;
+  if (nviolations > old_nviolations ||
+      Real(old_nviolations - nviolations) >=
+      opts.min_pass_improvement * Real(old_nviolations)) {
+    return true;
+  }
+  state->status = ADAPT_SLOW_PROGRESS;
+  return false;
+}
+
+/* under a budget, each pass first addresses the worse of
+   the longest and the shortest edge, relative to the desired range */
+static bool should_coarsen_first(Mesh* mesh, AdaptOpts const& opts) {
+  if (!has_budget(opts) || !opts.should_refine || !opts.should_coarsen) {
+    return false;
+  }
+  auto lengths = mesh->ask_lengths();
+  auto min_length = get_min(mesh->comm(), lengths);
+  auto max_length = get_max(mesh->comm(), lengths);
+  return opts.min_length_desired * opts.max_length_desired >
+         min_length * max_length;
 }
 
-static void satisfy_lengths(Mesh* mesh, AdaptOpts const& opts) {
+/* returns false if adaptation should stop here */
+static bool satisfy_lengths(
+    Mesh* mesh, AdaptOpts const& opts, AdaptState* state) {
   OMEGA_H_TIME_FUNCTION;
+  /* the metric and the vertices of surviving edges do not change while
+     lengths are being satisfied, so an edge found within the desired range
+     stays there until a rebuild replaces it. rebuilt edges are marked
+     active again by transfer_length */
+  mesh->add_tag(EDGE, "length_active", 1, Read<I8>(mesh->nedges(), I8(1)));
+  auto const check_progress = opts.min_pass_improvement > 0.0;
+  if (check_progress) state->nviolations = count_length_violations(mesh, opts);
   bool did_anything;
+  bool can_continue = true;
   do {
     did_anything = false;
-    if (opts.should_refine && refine_by_size(mesh, opts)) {
-      post_rebuild(mesh, opts);
-      did_anything = true;
+    if (opts.should_combine_refine_coarsen && opts.should_refine &&
+        opts.should_coarsen) {
+      if (refine_and_coarsen_by_size(mesh, opts)) {
+        did_anything = true;
+        can_continue = post_rebuild(mesh, opts, state);
+      }
+    } else {
+      auto const coarsen_first = should_coarsen_first(mesh, opts);
+      for (Int i = 0; i < 2 && can_continue; ++i) {
+        if ((i == 0) == coarsen_first) {
+          if (!(opts.should_coarsen && coarsen_by_size(mesh, opts))) continue;
+        } else {
+          if (!(opts.should_refine && refine_by_size(mesh, opts))) continue;
+        }
+        did_anything = true;
+        can_continue = post_rebuild(mesh, opts, state);
+      }
     }
-    if (opts.should_coarsen && coarsen_by_size(mesh, opts)) {
-      post_rebuild(mesh, opts);
-      did_anything = true;
+    if (did_anything && can_continue && check_progress) {
+      can_continue =
+          made_progress(opts, count_length_violations(mesh, opts), state);
+    }
+  } while (did_anything && can_continue);
+  mesh->remove_tag(EDGE, "length_active");
+  return can_continue;
+}
+
+/* returns true if smoothing alone satisfied the qualities */
+static bool smooth_quality(Mesh* mesh, AdaptOpts const& opts) {
+  for (Int i = 0; i < opts.nsmooth_sets; ++i) {
+    if (!smooth_verts(mesh, opts)) break;
+    if (min_fixable_quality(mesh, opts) >= opts.min_quality_desired) {
+      return true;
     }
-  } while (did_anything);
+  }
+  return false;
 }
 
-static bool satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
+static bool satisfy_quality(
+    Mesh* mesh, AdaptOpts const& opts, AdaptState* state) {
   OMEGA_H_TIME_FUNCTION;
   if (min_fixable_quality(mesh, opts) >= opts.min_quality_desired) return true;
   if ((opts.verbosity >= EACH_REBUILD) && can_print(mesh)) {
     std::cout << "addressing element qualities\n";
   }
+  auto const check_progress = opts.min_pass_improvement > 0.0;
+  if (check_progress) {
+    state->nviolations = count_quality_violations(mesh, opts);
+  }
   do {
-    if (opts.should_swap && swap_edges(mesh, opts)) {
-      post_rebuild(mesh, opts);
-      continue;
-    }
-    if (opts.should_coarsen_slivers && coarsen_slivers(mesh, opts)) {
-      post_rebuild(mesh, opts);
-      continue;
+    if (smooth_quality(mesh, opts)) break;
+    if (!(opts.should_swap && swap_edges(mesh, opts)) &&
+        !(opts.should_coarsen_slivers && coarsen_slivers(mesh, opts))) {
+      if ((opts.verbosity > SILENT) && can_print(mesh)) {
+        std::cout << "could not satisfy quality\n";
+      }
+      state->status = ADAPT_QUALITY_UNSATISFIED;
+      return false;
     }
-    if ((opts.verbosity > SILENT) && can_print(mesh)) {
-      std::cout << "could not satisfy quality\n";
+    if (!post_rebuild(mesh, opts, state)) return false;
+    if (check_progress &&
+        !made_progress(opts, count_quality_violations(mesh, opts), state)) {
+      return false;
     }
-    return false;
   } while (min_fixable_quality(mesh, opts) < opts.min_quality_desired);
   return true;
 }
 
-static void snap_and_satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
+static void snap_and_satisfy_quality(
+    Mesh* mesh, AdaptOpts const& opts, AdaptState* state) {
 #ifdef OMEGA_H_USE_EGADS
   if (opts.egads_model) {
     ScopedTimer snap_timer("snap");
@@ -237,18 +461,18 @@ static void snap_and_satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
     }
     mesh->add_tag(VERT, "warp", mesh->dim(), warp);
     while (warp_to_limit(mesh, opts, opts.allow_snap_failure)) {
-      if (!satisfy_quality(mesh, opts)) {
+      if (!satisfy_quality(mesh, opts, state)) {
         mesh->remove_tag(VERT, "warp");
         break;
       }
     }
   } else
 #endif
-    satisfy_quality(mesh, opts);
+    satisfy_quality(mesh, opts, state);
 }
 
-static void post_adapt(
-    Mesh* mesh, AdaptOpts const& opts, Now t0, Now t1, Now t2, Now t3, Now t4) {
+static void post_adapt(Mesh* mesh, AdaptOpts const& opts,
+    AdaptState const& state, Now t0, Now t1, Now t2, Now t3, Now t4) {
   if (opts.verbosity == EACH_ADAPT) {
     if (!mesh->comm()->rank()) std::cout << "after adapting:\n";
     print_adapt_status(mesh, opts);
@@ -269,25 +493,46 @@ static void post_adapt(
     std::cout << "correcting integral errors took " << (t4 - t3)
               << " seconds\n";
   }
+  if (opts.verbosity > SILENT && !mesh->comm()->rank()) {
+    if (state.status == ADAPT_OUT_OF_TIME) {
+      std::cout << "stopped early: out of time\n";
+    } else if (state.status == ADAPT_OUT_OF_REBUILDS) {
+      std::cout << "stopped early: out of rebuilds\n";
+    } else if (state.status == ADAPT_SLOW_PROGRESS) {
+      std::cout << "stopped early: too little progress\n";
+    }
+  }
   Now t5 = now();
   if (opts.verbosity > SILENT && !mesh->comm()->rank()) {
-    std::cout << "adapting took " << (t5 - t0) << " seconds\n\n";
+    std::cout << "adapting took " << (t5 - t0) << " seconds and "
+              << state.nrebuilds << " rebuilds";
+    if (state.nrebalances) {
+      std::cout << ", " << state.nrebalances << " of them rebalanced";
+    }
+    std::cout << "\n\n";
   }
 }
 
-bool adapt(Mesh* mesh, AdaptOpts const& opts) {
+AdaptStatus adapt(Mesh* mesh, AdaptOpts const& opts) {
   ScopedTimer adapt_timer("adapt");
   OMEGA_H_CHECK(mesh->family() == OMEGA_H_SIMPLEX);
   auto t0 = now();
 
   mesh->change_all_rcFieldsToMesh();
 
-  if (!pre_adapt(mesh, opts)) return false;
+  if (!pre_adapt(mesh, opts)) return ADAPT_UNCHANGED;
   setup_conservation_tags(mesh, opts);
+  AdaptState state;
+  state.start = t0;
+  state.nrebuilds = 0;
+  state.nrebalances = 0;
+  state.nviolations = 0;
+  state.max_imbalance = opts.max_imbalance;
+  state.status = ADAPT_SATISFIED;
   auto t1 = now();
-  satisfy_lengths(mesh, opts);
+  auto const lengths_done = satisfy_lengths(mesh, opts, &state);
   auto t2 = now();
-  snap_and_satisfy_quality(mesh, opts);
+  if (lengths_done) snap_and_satisfy_quality(mesh, opts, &state);
   auto t3 = now();
   correct_integral_errors(mesh, opts);
   auto t4 = now();
@@ -298,11 +543,11 @@ bool adapt(Mesh* mesh, AdaptOpts const& opts) {
 
   mesh->change_all_rcFieldsToMesh();
 
-  post_adapt(mesh, opts, t0, t1, t2, t3, t4);
+  post_adapt(mesh, opts, state, t0, t1, t2, t3, t4);
 
   mesh->change_all_rcFieldsTorc();
 
-  return true;
+  return state.status;
 }
 
 void add_rcField_transferMap(AdaptOpts *opts, std::string const &name,
@@ -73,13 +73,75 @@ struct AdaptOpts {
   bool should_swap;
   bool should_coarsen_slivers;
   bool should_prevent_coarsen_flip;
+  /* apply length refinement and coarsening in one rebuild per pass */
+  bool should_combine_refine_coarsen;
+  /* split all long edges of an element in one rebuild, rather than
+     an independent set of edges */
+  bool should_refine_multiple_edges;
+  /* when positive, independent sets of operator keys compare qualities
+     only up to this many buckets and break ties with hashed random
+     priorities, bounding their rounds (see find_indset()) */
+  Int nindset_quality_buckets;
+  /* when greater than one, edge swapping applies up to this many
+     rebuilds per ghosting, the later ones to candidates kept whole on
+     one rank (see Omega_h_swap.hpp). only swapping does this;
+     refinement and coarsening always ghost once per rebuild */
+  Int nswap_rebuilds_per_ghost;
+  /* leave the ghosted partitioning before each rebuild by keeping the
+     local owned elements rather than migrating (see unghost_mesh()),
+     so only ownership is communicated and shared entities keep their
+     owners between rebuilds. the ghost layers are still rebuilt by
+     migration before the next operator */
+  bool should_unghost_locally;
+  /* when positive, quality is first addressed by moving up to this many
+     independent sets of vertices (see smooth_verts()), which needs no
+     rebuild, before each swap or sliver collapse. this is skipped
+     while conservative, momentum or user transfers are requested */
+  Int nsmooth_sets;
+  /* budget of one adapt() call, negative for none. once it runs out,
+     adapt() stops after the current rebuild, with a valid mesh */
+  Real max_adapt_seconds;
+  Int max_adapt_rebuilds;
+  /* when positive, a pass that removes less than this fraction of the
+     remaining length (or quality) violations ends adaptation.
+     passes that add violations do not count */
+  Real min_pass_improvement;
+  /* when positive, a rebuild that leaves the ranks more imbalanced than
+     this (see Mesh::imbalance()) is followed by Mesh::balance(true).
+     the loads are element counts, or the elements' metric complexity
+     if should_weight_imbalance is set. after rebalancing, the next
+     rebalance also waits for the imbalance to grow by this factor
+     over what the last one reached, to avoid thrashing.
+     rebalancing needs a power-of-two number of ranks */
+  Real max_imbalance;
+  bool should_weight_imbalance;
   TransferOpts xfer_opts;
 };
 
 Real min_fixable_quality(Mesh* mesh, AdaptOpts const& opts);
 
-/* returns false if the mesh was not modified. */
-bool adapt(Mesh* mesh, AdaptOpts const& opts);
+/* edges whose metric length is outside the desired range.
+   if the mesh has an I8 "length_active" edge tag, only the edges
+   it marks are measured, and it is updated to mark just the result */
+LOs get_length_candidates(Mesh* mesh, AdaptOpts const& opts);
+
+/* goes from the ghosted partitioning to the element-based one that
+   rebuilds need, following opts.should_unghost_locally */
+void unghost_for_rebuild(Mesh* mesh, AdaptOpts const& opts);
+
+/* how far adapt() got. the mesh was modified unless the result is
+   ADAPT_UNCHANGED; test that explicitly rather than relying on it
+   being the only zero value */
+enum AdaptStatus {
+  ADAPT_UNCHANGED,            // the mesh already met the goals
+  ADAPT_SATISFIED,            // lengths and qualities now meet the goals
+  ADAPT_QUALITY_UNSATISFIED,  // no operator could improve quality further
+  ADAPT_OUT_OF_TIME,          // AdaptOpts::max_adapt_seconds ran out
+  ADAPT_OUT_OF_REBUILDS,      // AdaptOpts::max_adapt_rebuilds ran out
+  ADAPT_SLOW_PROGRESS         // see AdaptOpts::min_pass_improvement
+};
+
+AdaptStatus adapt(Mesh* mesh, AdaptOpts const& opts);
 
 bool print_adapt_status(Mesh* mesh, AdaptOpts const& opts);
 void print_adapt_histograms(Mesh* mesh, AdaptOpts const& opts);
@@ -43,6 +43,14 @@ Write<T>::Write(LO size_in, std::string const& name_in) {
   end_code();
 }
 
+#if !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+template <typename T>
+Write<T>::Write(T* data_in, LO size_in, std::function<void()> release,
+    std::string const& name_in)
+    : shared_alloc_(data_in, sizeof(T) * static_cast<std::size_t>(size_in),
+          name_in, std::move(release)) {}
+#endif
+
 template <typename T>
 void fill(Write<T> a, T val) {
   auto f = OMEGA_H_LAMBDA(LO i) { a[i] = val; };
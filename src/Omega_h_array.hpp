@@ -46,6 +46,12 @@ class Write {
   Write(LO size_in, T offset, T stride, std::string const& name = "");
   Write(std::initializer_list<T> l, std::string const& name = "");
   Write(HostWrite<T> host_write);
+#if !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+  /* wraps memory owned elsewhere without copying it; release is called
+     once no array refers to it anymore */
+  Write(T* data_in, LO size_in, std::function<void()> release,
+      std::string const& name = "");
+#endif
   OMEGA_H_INLINE LO size() const OMEGA_H_NOEXCEPT {
 #ifdef OMEGA_H_CHECK_BOUNDS
     OMEGA_H_CHECK(exists());
@@ -1,5 +1,9 @@
 #include "Omega_h_base64.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
 #include "Omega_h_fail.hpp"
 
 namespace Omega_h {
@@ -89,6 +93,28 @@ void decode_4(char const* in, unsigned char* out, std::size_t nout = 3) {
       UC(((U(val[2]) << U(6)) & U(0xC0)) | ((U(val[3]) >> U(0)) & U(0x3F)));
 }
 
+/* decodes whole units straight from the lookup table; instead of checking
+   each character, the table values are OR-ed together and checked once by
+   the caller, since only characters outside the alphabet map above 63 */
+unsigned decode_units(char const* in, unsigned char* out, std::size_t nunits) {
+  auto const n = static_cast<std::ptrdiff_t>(nunits);
+  unsigned bad = 0;
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for reduction(| : bad)
+#endif
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    auto const a = U(char_to_value[UC(in[i * 4 + 0])]);
+    auto const b = U(char_to_value[UC(in[i * 4 + 1])]);
+    auto const c = U(char_to_value[UC(in[i * 4 + 2])]);
+    auto const d = U(char_to_value[UC(in[i * 4 + 3])]);
+    bad |= a | b | c | d;
+    out[i * 3 + 0] = UC((a << 2) | (b >> 4));
+    out[i * 3 + 1] = UC((b << 4) | (c >> 2));
+    out[i * 3 + 2] = UC((c << 6) | d);
+  }
+  return bad;
+}
+
 }  // end anonymous namespace
 
 std::size_t encoded_size(std::size_t size) {
@@ -120,14 +146,77 @@ std::string encode(void const* data, std::size_t size) {
   return out;
 }
 
+/* encodes a chunk at a time straight into the stream, so the full text
+   never exists in memory; each chunk is split across threads */
+void encode(std::ostream& stream, void const* data, std::size_t size) {
+  constexpr std::size_t units_per_chunk = std::size_t(1) << 16;
+  auto quot = size / 3;
+  auto rem = size % 3;
+  unsigned char const* in = static_cast<unsigned char const*>(data);
+  std::vector<char> chunk(std::min(quot, units_per_chunk) * 4);
+  for (std::size_t first = 0; first < quot; first += units_per_chunk) {
+    auto n = static_cast<std::ptrdiff_t>(std::min(units_per_chunk, quot - first));
+    auto chunk_in = in + first * 3;
+    auto chunk_out = chunk.data();
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      encode_3(&chunk_in[i * 3], &chunk_out[i * 4]);
+    }
+    stream.write(chunk_out, static_cast<std::streamsize>(n * 4));
+  }
+  char tail[4];
+  switch (rem) {
+    case 0:
+      return;
+    case 1:
+      encode_1(&in[quot * 3], tail);
+      break;
+    case 2:
+      encode_2(&in[quot * 3], tail);
+      break;
+  }
+  stream.write(tail, 4);
+}
+
 void decode(std::string const& text, void* data, std::size_t size) {
   std::size_t quot = size / 3;
   std::size_t rem = size % 3;
   unsigned char* out = static_cast<unsigned char*>(data);
-  for (std::size_t i = 0; i < quot; ++i) decode_4(&text[i * 4], &out[i * 3]);
+  OMEGA_H_CHECK(text.size() >= encoded_size(size));
+  OMEGA_H_CHECK(decode_units(text.data(), out, quot) < 64);
   if (rem) decode_4(&text[quot * 4], &out[quot * 3], rem);
 }
 
+/* the counterpart of the streaming encode: reads exactly the characters
+   that encode size bytes, a chunk at a time, and decodes them in place
+   into data, so neither the text nor a copy of it is ever held whole */
+void read_decoded(std::istream& stream, void* data, std::size_t size) {
+  constexpr std::size_t units_per_chunk = std::size_t(1) << 16;
+  auto quot = size / 3;
+  auto rem = size % 3;
+  unsigned char* out = static_cast<unsigned char*>(data);
+  auto nchunk_units = std::max(std::min(quot, units_per_chunk), std::size_t(1));
+  std::vector<char> chunk(nchunk_units * 4);
+  for (std::size_t first = 0; first < quot; first += units_per_chunk) {
+    auto n = std::min(units_per_chunk, quot - first);
+    auto nchars = static_cast<std::streamsize>(n * 4);
+    if (!stream.read(chunk.data(), nchars)) {
+      Omega_h_fail("base64: unexpected end of encoded data\n");
+    }
+    if (decode_units(chunk.data(), out + first * 3, n) > 63) {
+      Omega_h_fail("base64: invalid character in encoded data\n");
+    }
+  }
+  if (rem) {
+    if (!stream.read(chunk.data(), 4)) {
+      Omega_h_fail("base64: unexpected end of encoded data\n");
+    }
+    decode_4(chunk.data(), &out[quot * 3], rem);
+  }
+}
+
 std::string read_encoded(std::istream& f) {
   std::string out;
   while (true) {
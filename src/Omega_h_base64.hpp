@@ -2,6 +2,7 @@
 #define BASE64_HPP
 
 #include <istream>
+#include <ostream>
 #include <string>
 
 namespace Omega_h {
@@ -10,7 +11,9 @@ namespace base64 {
 
 std::size_t encoded_size(std::size_t size);
 std::string encode(void const* data, std::size_t size);
+void encode(std::ostream& stream, void const* data, std::size_t size);
 void decode(std::string const& text, void* data, std::size_t size);
+void read_decoded(std::istream& stream, void* data, std::size_t size);
 std::string read_encoded(std::istream& f);
 }  // namespace base64
 
@@ -148,6 +148,101 @@ Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
   return mesh;
 }
 
+/* Each rank builds its own slab of the grid: a contiguous range of cell
+   layers along the axis with the most cells.
+   Vertices and cells keep the lexicographic numbering of make_*_box,
+   so their global numbers follow from grid indices and nothing has to
+   migrate afterwards. */
+Mesh build_box_sliced(CommPtr comm, Omega_h_Family family, Real x, Real y,
+    Real z, LO nx, LO ny, LO nz, bool symmetric) {
+  OMEGA_H_CHECK(nx > 0);
+  OMEGA_H_CHECK(ny >= 0);
+  OMEGA_H_CHECK(nz >= 0);
+  Int const dim = (ny == 0) ? 1 : ((nz == 0) ? 2 : 3);
+  if (family == OMEGA_H_SIMPLEX && symmetric && dim > 1) {
+    /* the symmetric splits add center vertices numbered by local faces */
+    return build_box(comm, family, x, y, z, nx, ny, nz, symmetric);
+  }
+  LO const ncells[3] = {nx, ny, nz};
+  Real const lengths[3] = {x, y, z};
+  Int axis = 0;
+  for (Int d = 1; d < dim; ++d) {
+    if (ncells[d] >= ncells[axis]) axis = d;
+  }
+  GO begin, end;
+  suggest_slices(ncells[axis], comm->size(), comm->rank(), &begin, &end);
+  /* axes beyond dim hold one layer of cells and one layer of vertices */
+  Few<LO, 3> gc, gv, lo, lc, lv;
+  Vector<3> h;
+  for (Int d = 0; d < 3; ++d) {
+    gc[d] = (d < dim) ? ncells[d] : 1;
+    gv[d] = (d < dim) ? ncells[d] + 1 : 1;
+    lo[d] = (d == axis) ? LO(begin) : 0;
+    lc[d] = (d == axis) ? LO(end - begin) : gc[d];
+    lv[d] = (d < dim) ? lc[d] + 1 : 1;
+    h[d] = (d < dim) ? lengths[d] / ncells[d] : 0.0;
+  }
+  LO const nverts = lc[axis] ? lv[0] * lv[1] * lv[2] : 0;
+  LO const ncells_local = lc[0] * lc[1] * lc[2];
+  Write<GO> vert_globals(nverts);
+  Write<Real> coords(nverts * dim);
+  auto fill_verts = OMEGA_H_LAMBDA(LO v) {
+    LO const idx[3] = {v % lv[0] + lo[0], (v / lv[0]) % lv[1] + lo[1],
+        v / (lv[0] * lv[1]) + lo[2]};
+    vert_globals[v] = (GO(idx[2]) * gv[1] + idx[1]) * gv[0] + idx[0];
+    for (Int d = 0; d < dim; ++d) coords[v * dim + d] = idx[d] * h[d];
+  };
+  parallel_for(nverts, fill_verts, "build_box_sliced(verts)");
+  Int const deg = 1 << dim;
+  Write<GO> cell_globals(ncells_local);
+  Write<LO> cv2v(ncells_local * deg);
+  auto fill_cells = OMEGA_H_LAMBDA(LO c) {
+    LO const i = c % lc[0];
+    LO const j = (c / lc[0]) % lc[1];
+    LO const k = c / (lc[0] * lc[1]);
+    cell_globals[c] =
+        (GO(k + lo[2]) * gc[1] + (j + lo[1])) * gc[0] + (i + lo[0]);
+    /* same corner order as make_2d_box and make_3d_box */
+    for (Int n = 0; n < deg; ++n) {
+      Int const m = n % 4;
+      Int const di = (m == 1 || m == 2) ? 1 : 0;
+      Int const dj = m / 2;
+      Int const dk = n / 4;
+      cv2v[c * deg + n] = ((k + dk) * lv[1] + (j + dj)) * lv[0] + (i + di);
+    }
+  };
+  parallel_for(ncells_local, fill_cells, "build_box_sliced(cells)");
+  LOs ev2v = cv2v;
+  GOs elem_globals = cell_globals;
+  if (family == OMEGA_H_SIMPLEX && dim > 1) {
+    ev2v = (dim == 2) ? tris_from_quads(cv2v) : tets_from_hexes(cv2v);
+    /* local vertex numbers are ordered like their globals, and the split
+       only compares vertex numbers, so every cell is split exactly as in
+       the serial box and yields the same number of simplices */
+    auto const nelems = divide_no_remainder(ev2v.size(), dim + 1);
+    auto const per_cell =
+        ncells_local ? divide_no_remainder(nelems, ncells_local) : 1;
+    auto const simplex_globals = Write<GO>(nelems);
+    auto fill_simplices = OMEGA_H_LAMBDA(LO e) {
+      simplex_globals[e] =
+          cell_globals[e / per_cell] * per_cell + e % per_cell;
+    };
+    parallel_for(nelems, fill_simplices, "build_box_sliced(simplices)");
+    elem_globals = simplex_globals;
+  }
+  auto mesh = Mesh(comm->library());
+  mesh.set_comm(comm);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.set_family(family);
+  mesh.set_dim(dim);
+  build_verts_from_globals(&mesh, vert_globals);
+  build_ents_from_elems2verts(&mesh, ev2v, vert_globals, elem_globals);
+  mesh.add_coords(coords);
+  classify_box(&mesh, x, y, z, nx, ny, nz);
+  mesh.class_sets = get_box_class_sets(dim);
+  return mesh;
+}
+
 /* When we try to build a mesh from _partitioned_
    element-to-vertex connectivity only, we have to derive
    consistent edges and faces in parallel.
@@ -23,6 +23,10 @@ void build_from_elems_and_coords(
     Mesh* mesh, Omega_h_Family family, Int edim, LOs ev2v, Reals coords);
 Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
     LO nx, LO ny, LO nz, bool symmetric = false);
+// builds the same box with each rank generating only its own slab of cells,
+// instead of building on one rank and migrating through balance()
+Mesh build_box_sliced(CommPtr comm, Omega_h_Family family, Real x, Real y,
+    Real z, LO nx, LO ny, LO nz, bool symmetric = false);
 void build_box_internal(Mesh* mesh, Omega_h_Family family, Real x, Real y,
     Real z, LO nx, LO ny, LO nz, bool symmetric = false);
 
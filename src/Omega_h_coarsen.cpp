@@ -8,8 +8,11 @@
 #include "Omega_h_for.hpp"
 #include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_modify.hpp"
+#include "Omega_h_refine.hpp"
+#include "Omega_h_refine_topology.hpp"
 #include "Omega_h_transfer.hpp"
 
 namespace Omega_h {
@@ -92,17 +95,21 @@ static bool coarsen_ghosted(Mesh* mesh, AdaptOpts const& opts,
   auto vert_rails = Read<GO>();
   choose_rails(mesh, cands2edges, cand_edge_codes, cand_edge_quals,
       &verts_are_cands, &vert_quals, &vert_rails);
-  auto verts_are_keys = find_indset(mesh, VERT, vert_quals, verts_are_cands);
-  Graph verts2cav_elems;
-  verts2cav_elems = mesh->ask_up(VERT, mesh->dim());
+  auto verts_are_keys = find_indset(mesh, VERT, vert_quals,
+      verts_are_cands, opts.nindset_quality_buckets);
   mesh->add_tag(VERT, "key", 1, verts_are_keys);
   mesh->add_tag(VERT, "collapse_quality", 1, vert_quals);
   mesh->add_tag(VERT, "collapse_rail", 1, vert_rails);
-  auto keys2verts = collect_marked(verts_are_keys);
-  set_owners_by_indset(mesh, VERT, keys2verts, verts2cav_elems);
   return true;
 }
 
+static void set_coarsen_owners(Mesh* mesh) {
+  auto verts_are_keys = mesh->get_array<I8>(VERT, "key");
+  auto keys2verts = collect_marked(verts_are_keys);
+  set_owners_by_indset(
+      mesh, VERT, keys2verts, mesh->ask_up(VERT, mesh->dim()));
+}
+
 static void coarsen_element_based2(Mesh* mesh, AdaptOpts const& opts) {
   auto comm = mesh->comm();
   auto verts_are_keys = mesh->get_array<I8>(VERT, "key");
@@ -168,12 +175,13 @@ static bool coarsen(Mesh* mesh, AdaptOpts const& opts, OvershootLimit overshoot,
     mesh->change_all_rcFieldsToMesh();
 
     ret = coarsen_ghosted(mesh, opts, overshoot, improve);
+    if (ret) set_coarsen_owners(mesh);
   }
   if (ret) {
 
     mesh->change_all_rcFieldsTorc();
 
-    mesh->set_parting(OMEGA_H_ELEM_BASED, false);
+    unghost_for_rebuild(mesh, opts);
 
     mesh->change_all_rcFieldsToMesh();
 
@@ -183,8 +191,7 @@ static bool coarsen(Mesh* mesh, AdaptOpts const& opts, OvershootLimit overshoot,
   return ret;
 }
 
-bool coarsen_verts(Mesh* mesh, AdaptOpts const& opts,
-    Read<I8> vert_marks, OvershootLimit overshoot, Improve improve) {
+static void put_vert_codes(Mesh* mesh, Read<I8> vert_marks) {
   auto ev2v = mesh->ask_verts_of(EDGE);
   Write<I8> edge_codes_w(mesh->nedges(), DONT_COLLAPSE);
   auto f = OMEGA_H_LAMBDA(LO e) {
@@ -198,6 +205,11 @@ bool coarsen_verts(Mesh* mesh, AdaptOpts const& opts,
   };
   parallel_for(mesh->nedges(), f, "coarsen_verts(edge_codes)");
   mesh->add_tag(EDGE, "collapse_code", 1, Read<I8>(edge_codes_w));
+}
+
+bool coarsen_verts(Mesh* mesh, AdaptOpts const& opts,
+    Read<I8> vert_marks, OvershootLimit overshoot, Improve improve) {
+  put_vert_codes(mesh, vert_marks);
   return coarsen(mesh, opts, overshoot, improve);
 }
 
@@ -211,14 +223,193 @@ bool coarsen_by_size(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
-  auto edge_is_cand = each_lt(lengths, opts.min_length_desired);
-  auto ret = (get_max(comm, edge_is_cand) == 1);
+  auto cands2edges = get_length_candidates(mesh, opts);
+  auto cand_lengths = read(unmap(cands2edges, lengths, 1));
+  auto cand_is_short = each_lt(cand_lengths, opts.min_length_desired);
+  auto ret = (get_max(comm, cand_is_short) == 1);
   if (ret) {
+    auto edge_is_cand =
+        map_onto(cand_is_short, cands2edges, mesh->nedges(), I8(0), 1);
     ret = coarsen_ents(mesh, opts, EDGE, edge_is_cand, DESIRED, DONT_IMPROVE);
   }
   return ret;
 }
 
+/* a collapse may go into the same rebuild as the splits only if no
+   element is in both cavities, so vertices of split cavities are kept
+   from collapsing before the collapse keys are chosen */
+static void keep_collapses_off_splits(Mesh* mesh) {
+  auto dim = mesh->dim();
+  auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
+  auto elems_are_split = mark_up(mesh, EDGE, dim, edges_are_keys);
+  auto verts_are_split = mark_down(mesh, dim, VERT, elems_are_split);
+  auto edge_codes = get_edge_codes(mesh);
+  auto ev2v = mesh->ask_verts_of(EDGE);
+  Write<I8> new_codes_w(mesh->nedges());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    auto code = edge_codes[e];
+    for (Int eev = 0; eev < 2; ++eev) {
+      if (verts_are_split[ev2v[e * 2 + eev]]) code = dont_collapse(code, eev);
+    }
+    new_codes_w[e] = code;
+  };
+  parallel_for(mesh->nedges(), f, "keep_collapses_off_splits");
+  mesh->add_tag(EDGE, "collapse_code", 1, Read<I8>(new_codes_w));
+}
+
+static void refine_and_coarsen_element_based(
+    Mesh* mesh, AdaptOpts const& opts) {
+  auto comm = mesh->comm();
+  auto did_refine = mesh->has_tag(EDGE, "key");
+  auto did_coarsen = mesh->has_tag(VERT, "key");
+  auto edges_are_keys = did_refine ? mesh->get_array<I8>(EDGE, "key")
+                                   : Read<I8>(mesh->nedges(), I8(0));
+  auto verts_are_keys = did_coarsen ? mesh->get_array<I8>(VERT, "key")
+                                    : Read<I8>(mesh->nverts(), I8(0));
+  auto keys2edges = collect_marked(edges_are_keys);
+  auto keys2verts = collect_marked(verts_are_keys);
+  auto nsplits = keys2edges.size();
+  auto ncollapses = keys2verts.size();
+  if (opts.verbosity >= EACH_REBUILD) {
+    auto ntotal_splits = comm->allreduce(GO(nsplits), OMEGA_H_SUM);
+    auto ntotal_collapses = comm->allreduce(GO(ncollapses), OMEGA_H_SUM);
+    if (comm->rank() == 0) {
+      std::cout << "refining " << ntotal_splits << " edges and coarsening "
+                << ntotal_collapses << " vertices\n";
+    }
+  }
+  auto rails2edges = LOs();
+  auto rail_col_dirs = Read<I8>();
+  if (did_coarsen) {
+    auto vert_rails = mesh->get_array<GO>(VERT, "collapse_rail");
+    mesh->remove_tag(VERT, "collapse_rail");
+    find_rails(mesh, keys2verts, vert_rails, &rails2edges, &rail_col_dirs);
+  } else {
+    rails2edges = LOs({});
+    rail_col_dirs = Read<I8>({});
+  }
+  auto dead_ents = mark_dead_ents(mesh, rails2edges, rail_col_dirs);
+  auto keys2verts_onto = get_verts_onto(mesh, rails2edges, rail_col_dirs);
+  /* one modification set holds both operators: collapse keys at VERT and
+     split keys at EDGE, with the collapse products numbered first */
+  Few<LOs, 4> mods2mds;
+  Few<Bytes, 4> mds_are_mods;
+  mods2mds[VERT] = keys2verts;
+  mds_are_mods[VERT] = verts_are_keys;
+  mods2mds[EDGE] = keys2edges;
+  mds_are_mods[EDGE] =
+      lor_each(edges_are_keys, mark_up(mesh, VERT, EDGE, verts_are_keys));
+  for (Int mod_dim = EDGE + 1; mod_dim <= mesh->dim(); ++mod_dim) {
+    mds_are_mods[mod_dim] = mark_up(mesh, EDGE, mod_dim, mds_are_mods[EDGE]);
+  }
+  auto new_mesh = mesh->copy_meta();
+  auto keys2midverts = LOs();
+  auto old_verts2new_verts = LOs();
+  auto old_lows2new_lows = LOs();
+  for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
+    auto collapse_keys2prods = LOs();
+    auto split_keys2prods = LOs();
+    auto collapse_prod_verts2verts = LOs();
+    auto split_prod_verts2verts = LOs();
+    auto keys2doms = Adj();
+    if (ent_dim == VERT) {
+      collapse_keys2prods = LOs(ncollapses + 1, 0);
+      split_keys2prods = LOs(nsplits + 1, 0, 1);
+    } else {
+      keys2doms =
+          find_coarsen_domains(mesh, keys2verts, ent_dim, dead_ents[ent_dim]);
+      collapse_keys2prods = keys2doms.a2ab;
+      collapse_prod_verts2verts = coarsen_topology(
+          mesh, keys2verts_onto, ent_dim, keys2doms, old_verts2new_verts);
+      refine_products(mesh, ent_dim, keys2edges, keys2midverts,
+          old_verts2new_verts, split_keys2prods, split_prod_verts2verts);
+    }
+    auto ncollapse_prods = collapse_keys2prods.last();
+    auto nsplit_prods = split_keys2prods.last();
+    Few<LOs, 4> mods2prods;
+    if (did_coarsen) mods2prods[VERT] = collapse_keys2prods;
+    if (did_refine) {
+      mods2prods[EDGE] = add_to_each(split_keys2prods, ncollapse_prods);
+    }
+    auto prod_verts2verts = LOs();
+    if (ent_dim != VERT) {
+      prod_verts2verts =
+          concat(collapse_prod_verts2verts, split_prod_verts2verts);
+    }
+    auto prods2new_ents = LOs();
+    auto same_ents2old_ents = LOs();
+    auto same_ents2new_ents = LOs();
+    auto old_ents2new_ents = LOs();
+    modify_ents(mesh, &new_mesh, ent_dim, mods2mds, mds_are_mods, mods2prods,
+        prod_verts2verts, old_lows2new_lows, /*keep_mods*/ false,
+        /*mods_can_be_shared*/ false, &prods2new_ents, &same_ents2old_ents,
+        &same_ents2new_ents, &old_ents2new_ents);
+    auto collapse_prods2new_ents =
+        unmap_range(0, ncollapse_prods, prods2new_ents, 1);
+    auto split_prods2new_ents = unmap_range(
+        ncollapse_prods, ncollapse_prods + nsplit_prods, prods2new_ents, 1);
+    if (ent_dim == VERT) {
+      keys2midverts = split_prods2new_ents;
+      old_verts2new_verts = old_ents2new_ents;
+    }
+    transfer_refine_and_coarsen(mesh, opts.xfer_opts, &new_mesh, keys2edges,
+        keys2midverts, split_keys2prods, split_prods2new_ents, keys2verts,
+        keys2doms, collapse_prods2new_ents, ent_dim, same_ents2old_ents,
+        same_ents2new_ents);
+    old_lows2new_lows = old_ents2new_ents;
+  }
+  *mesh = new_mesh;
+}
+
+bool refine_and_coarsen_by_size(Mesh* mesh, AdaptOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  auto comm = mesh->comm();
+  auto lengths = mesh->ask_lengths();
+  auto cands2edges = get_length_candidates(mesh, opts);
+  auto cand_lengths = read(unmap(cands2edges, lengths, 1));
+  auto cand_is_long = each_gt(cand_lengths, opts.max_length_desired);
+  auto cand_is_short = each_lt(cand_lengths, opts.min_length_desired);
+  auto any_long = (get_max(comm, cand_is_long) == 1);
+  auto any_short = (get_max(comm, cand_is_short) == 1);
+  /* conservative and momentum transfers and user callbacks see one
+     operator at a time, so those meshes keep the separate rebuilds */
+  auto can_combine = any_long && any_short &&
+                     !has_densities_or_conserved(mesh, opts.xfer_opts) &&
+                     !has_momentum_velocity(mesh, opts.xfer_opts) &&
+                     !opts.xfer_opts.user_xfer;
+  if (!can_combine) {
+    bool did_anything = false;
+    if (any_long && refine_by_size(mesh, opts)) did_anything = true;
+    if (coarsen_by_size(mesh, opts)) did_anything = true;
+    return did_anything;
+  }
+  auto nedges = mesh->nedges();
+  auto edges_are_long = map_onto(cand_is_long, cands2edges, nedges, I8(0), 1);
+  auto edges_are_short =
+      map_onto(cand_is_short, cands2edges, nedges, I8(0), 1);
+  begin_code("refine_and_coarsen");
+  put_vert_codes(mesh, mark_down(mesh, EDGE, VERT, edges_are_short));
+  auto can_coarsen = coarsen_element_based1(mesh);
+  mesh->add_tag(EDGE, "candidate", 1, edges_are_long);
+  mesh->change_all_rcFieldsTorc();
+  mesh->set_parting(OMEGA_H_GHOSTED);
+  mesh->change_all_rcFieldsToMesh();
+  auto did_refine = refine_ghosted(mesh, opts);
+  if (did_refine && can_coarsen) keep_collapses_off_splits(mesh);
+  auto did_coarsen =
+      can_coarsen && coarsen_ghosted(mesh, opts, DESIRED, DONT_IMPROVE);
+  if (did_refine) set_refine_owners(mesh);
+  if (did_coarsen) set_coarsen_owners(mesh);
+  if (did_refine || did_coarsen) {
+    mesh->change_all_rcFieldsTorc();
+    unghost_for_rebuild(mesh, opts);
+    mesh->change_all_rcFieldsToMesh();
+    refine_and_coarsen_element_based(mesh, opts);
+  }
+  end_code();
+  return did_refine || did_coarsen;
+}
+
 bool coarsen_slivers(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
 
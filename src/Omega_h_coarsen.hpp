@@ -43,6 +43,10 @@ LOs coarsen_topology(Mesh* mesh, LOs keys2verts_onto, Int dom_dim,
 
 bool coarsen_by_size(Mesh* mesh, AdaptOpts const& opts);
 
+/* one pass of refine_by_size() and coarsen_by_size() that applies
+   both operators in a single rebuild where it can */
+bool refine_and_coarsen_by_size(Mesh* mesh, AdaptOpts const& opts);
+
 bool coarsen_slivers(Mesh* mesh, AdaptOpts const& opts);
 
 }  // end namespace Omega_h
@@ -205,6 +205,19 @@ T Comm::allreduce(T x, Omega_h_Op op) const {
   return x;
 }
 
+template <typename T>
+Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const {
+#ifdef OMEGA_H_USE_MPI
+  HostWrite<T> h_x(deep_copy(x));
+  CALL(MPI_Allreduce(MPI_IN_PLACE, nonnull(h_x.data()), h_x.size(),
+      MpiTraits<T>::datatype(), mpi_op(op), impl_));
+  return h_x.write();
+#else
+  (void)op;
+  return x;
+#endif
+}
+
 bool Comm::reduce_or(bool x) const {
   I8 y = x;
   y = allreduce(y, OMEGA_H_MAX);
@@ -570,6 +583,7 @@ void Comm::barrier() const {
 
 #define INST(T)                                                                \
   template T Comm::allreduce(T x, Omega_h_Op op) const;                        \
+  template Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const;            \
   template T Comm::exscan(T x, Omega_h_Op op) const;                           \
   template void Comm::bcast(T& x) const;                                       \
   template Read<T> Comm::allgather(T x) const;                                 \
@@ -63,6 +63,9 @@ class Comm {
   Read<I32> destinations() const;
   template <typename T>
   T allreduce(T x, Omega_h_Op op) const;
+  /* element-wise, so several values can share one reduction */
+  template <typename T>
+  Read<T> allreduce(Read<T> x, Omega_h_Op op) const;
   bool reduce_or(bool x) const;
   bool reduce_and(bool x) const;
   Int128 add_int128(Int128 x) const;
@@ -149,6 +152,7 @@ inline MPI_Op mpi_op(Omega_h_Op op) {
 
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
   extern template T Comm::allreduce(T x, Omega_h_Op op) const;                 \
+  extern template Read<T> Comm::allreduce(Read<T> x, Omega_h_Op op) const;     \
   extern template T Comm::exscan(T x, Omega_h_Op op) const;                    \
   extern template void Comm::bcast(T& x) const;                                \
   extern template Read<T> Comm::allgather(T x) const;                          \
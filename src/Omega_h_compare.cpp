@@ -1,5 +1,6 @@
 #include "Omega_h_compare.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -8,10 +9,12 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_cmdline.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_int_iterator.hpp"
 #include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_owners.hpp"
+#include "Omega_h_reduce.hpp"
 
 namespace Omega_h {
 
@@ -169,6 +172,144 @@ static bool compare_copy_data(Int dim, Read<T> a_data, Dist a_dist,
   return ret;
 }
 
+/* Checksums let compare_meshes skip the owner exchanges of
+   compare_copy_data for arrays that match. Each owned entity adds a hash
+   of its global number and its values, so the sum doesn't depend on the
+   ordering or partitioning of either mesh. Reals are hashed after
+   quantizing them to bins narrower than the tolerance, so matching
+   checksums imply the arrays compare equal (up to hash collisions),
+   while a mismatch only means the detailed comparison has to run. */
+
+struct ArrayChecksum {
+  /* the two 31-bit halves of the summed hashes, so the I64 sums can't
+     overflow, and the count of non-finite values, which always force the
+     detailed comparison */
+  I64 sums[3];
+};
+
+struct AddChecksums {
+  OMEGA_H_INLINE ArrayChecksum operator()(
+      ArrayChecksum a, ArrayChecksum b) const {
+    for (Int i = 0; i < 3; ++i) a.sums[i] += b.sums[i];
+    return a;
+  }
+};
+
+OMEGA_H_INLINE std::uint64_t mix_bits(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+struct ChecksumKeys {
+  enum { EXACT, ABSOLUTE, RELATIVE } mode;
+  Real quantum;
+  std::uint64_t mask;
+  ChecksumKeys(VarCompareOpts opts) : mode(EXACT), quantum(0.0), mask(0) {
+    if (opts.tolerance <= 0.0) return;
+    if (opts.type == VarCompareOpts::ABSOLUTE) {
+      mode = ABSOLUTE;
+      quantum = opts.tolerance;
+    } else if (opts.type == VarCompareOpts::RELATIVE) {
+      /* values sharing sign, exponent and the leading mantissa bits
+         differ relatively by less than 2^-nbits <= tolerance */
+      mode = RELATIVE;
+      auto nbits = Int(std::ceil(-std::log2(opts.tolerance)));
+      nbits = max2(0, min2(52, nbits));
+      mask = ~((std::uint64_t(1) << (52 - nbits)) - 1);
+    }
+  }
+  template <typename T>
+  OMEGA_H_INLINE std::uint64_t operator()(T x) const {
+    return std::uint64_t(I64(x));
+  }
+  OMEGA_H_INLINE std::uint64_t operator()(Real x) const {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    if (mode == ABSOLUTE) {
+      auto const bin = std::floor(x / quantum);
+      if (std::abs(bin) < 4.0e18) return std::uint64_t(I64(bin));
+    } else if (mode == RELATIVE) {
+      /* subnormals don't have the implicit leading bit */
+      if ((bits >> 52) & 0x7ff) return bits & mask;
+    }
+    return bits;
+  }
+};
+
+template <typename T>
+OMEGA_H_INLINE bool is_finite_value(T) {
+  return true;
+}
+
+OMEGA_H_INLINE bool is_finite_value(Real x) { return std::isfinite(x); }
+
+template <typename T>
+static ArrayChecksum get_checksum(Read<T> data, Read<GO> globals,
+    Read<I8> owned, Int ncomps, VarCompareOpts opts) {
+  auto const keys = ChecksumKeys(opts);
+  auto transform = OMEGA_H_LAMBDA(LO e)->ArrayChecksum {
+    ArrayChecksum out = {{0, 0, 0}};
+    if (!owned[e]) return out;
+    auto h = mix_bits(std::uint64_t(globals[e]));
+    for (Int c = 0; c < ncomps; ++c) {
+      auto const x = data[e * ncomps + c];
+      if (!is_finite_value(x)) ++out.sums[2];
+      h = mix_bits(h ^ mix_bits(keys(x) + std::uint64_t(c)));
+    }
+    out.sums[0] = I64(h & 0x7fffffff);
+    out.sums[1] = I64((h >> 32) & 0x7fffffff);
+    return out;
+  };
+  ArrayChecksum const init = {{0, 0, 0}};
+  return transform_reduce(IntIterator(0), IntIterator(globals.size()), init,
+      AddChecksums(), std::move(transform));
+}
+
+template <typename T>
+static void add_checksums(std::vector<I64>* sums, Mesh* a, Mesh* b, Int dim,
+    Read<T> a_data, Read<T> b_data, Int ncomps, VarCompareOpts opts) {
+  for (auto ab : {std::make_pair(a, a_data), std::make_pair(b, b_data)}) {
+    auto const checksum = get_checksum(ab.second, ab.first->globals(dim),
+        ab.first->owned(dim), ncomps, opts);
+    sums->insert(sums->end(), checksum.sums, checksum.sums + 3);
+  }
+}
+
+static void add_tag_checksums(std::vector<I64>* sums, Mesh* a, Mesh* b,
+    Int dim, TagBase const* tag, VarCompareOpts opts) {
+  auto const& name = tag->name();
+  auto const ncomps = tag->ncomps();
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      add_checksums(sums, a, b, dim, a->get_array<I8>(dim, name),
+          b->get_array<I8>(dim, name), ncomps, opts);
+      break;
+    case OMEGA_H_I32:
+      add_checksums(sums, a, b, dim, a->get_array<I32>(dim, name),
+          b->get_array<I32>(dim, name), ncomps, opts);
+      break;
+    case OMEGA_H_I64:
+      add_checksums(sums, a, b, dim, a->get_array<I64>(dim, name),
+          b->get_array<I64>(dim, name), ncomps, opts);
+      break;
+    case OMEGA_H_F64:
+      add_checksums(sums, a, b, dim, a->get_array<Real>(dim, name),
+          b->get_array<Real>(dim, name), ncomps, opts);
+      break;
+  }
+}
+
+/* sums holds 6 entries per array, a's checksum then b's */
+static bool checksums_match(HostRead<I64> sums, Int i) {
+  auto const first = i * 6;
+  if (sums[first + 2] || sums[first + 5]) return false;
+  return sums[first] == sums[first + 3] && sums[first + 1] == sums[first + 4];
+}
+
 static Read<GO> get_local_conn(Mesh* mesh, Int dim, Int low_dim) {
   auto h2l = mesh->ask_down(dim, low_dim);
   auto l_globals = mesh->globals(low_dim);
@@ -200,15 +341,45 @@ Omega_h_Comparison compare_meshes(
       return OMEGA_H_DIFF;
     }
     if (!full && (0 < dim) && (dim < a->dim())) continue;
-    auto a_globals = a->globals(dim);
-    auto b_globals = b->globals(dim);
-    auto a_dist = copies_to_linear_owners(comm, a_globals);
-    auto b_dist = copies_to_linear_owners(comm, b_globals);
+    auto low_dim = ((full) ? (dim - 1) : (VERT));
+    Read<GO> a_conn;
+    Read<GO> b_conn;
+    Int deg = 0;
+    std::vector<I64> local_sums;
     if (dim > 0) {
-      auto low_dim = ((full) ? (dim - 1) : (VERT));
-      auto a_conn = get_local_conn(a, dim, low_dim);
-      auto b_conn = get_local_conn(b, dim, low_dim);
-      auto deg = element_degree(a->family(), dim, low_dim);
+      a_conn = get_local_conn(a, dim, low_dim);
+      b_conn = get_local_conn(b, dim, low_dim);
+      deg = element_degree(a->family(), dim, low_dim);
+      add_checksums(&local_sums, a, b, dim, a_conn, b_conn, deg,
+          VarCompareOpts::zero_tolerance());
+    }
+    for (Int i = 0; i < a->ntags(dim); ++i) {
+      auto tag = a->get_tag(dim, i);
+      auto tag_opts = opts.tag_opts(dim, tag->name());
+      if (!b->has_tag(dim, tag->name())) continue;
+      if (tag_opts.type == VarCompareOpts::NONE) continue;
+      add_tag_checksums(&local_sums, a, b, dim, tag, tag_opts);
+    }
+    HostWrite<I64> h_local_sums(LO(local_sums.size()));
+    for (LO i = 0; i < h_local_sums.size(); ++i) {
+      h_local_sums[i] = local_sums[std::size_t(i)];
+    }
+    auto sums =
+        HostRead<I64>(comm->allreduce(Read<I64>(h_local_sums.write()),
+            OMEGA_H_SUM));
+    bool all_match = true;
+    for (Int i = 0; i < sums.size() / 6; ++i) {
+      if (!checksums_match(sums, i)) all_match = false;
+    }
+    /* the owner exchanges are only needed for arrays that don't match */
+    Dist a_dist;
+    Dist b_dist;
+    if (!all_match) {
+      a_dist = copies_to_linear_owners(comm, a->globals(dim));
+      b_dist = copies_to_linear_owners(comm, b->globals(dim));
+    }
+    Int next_sum = 0;
+    if (dim > 0 && !checksums_match(sums, next_sum++)) {
       auto ok = compare_copy_data(dim, a_conn, a_dist, b_conn, b_dist, deg,
           VarCompareOpts::zero_tolerance(), true);
       if (!ok) {
@@ -216,6 +387,7 @@ Omega_h_Comparison compare_meshes(
           std::cout << topological_singular_name(a->family(), dim)
                     << " connectivity doesn't match\n";
         }
+        if (opts.early_exit) return OMEGA_H_DIFF;
         result = OMEGA_H_DIFF;
         continue;
       }
@@ -228,11 +400,14 @@ Omega_h_Comparison compare_meshes(
           std::cout << topological_singular_name(a->family(), dim) << " tag \""
                     << name << "\" exists in first mesh but not second\n";
         }
+        if (opts.early_exit) return OMEGA_H_DIFF;
         result = OMEGA_H_DIFF;
         continue;
       }
       auto ncomps = tag->ncomps();
       auto tag_opts = opts.tag_opts(dim, name);
+      if (tag_opts.type == VarCompareOpts::NONE) continue;
+      if (checksums_match(sums, next_sum++)) continue;
       bool ok = false;
       switch (tag->type()) {
         case OMEGA_H_I8:
@@ -258,6 +433,7 @@ Omega_h_Comparison compare_meshes(
                     << name << "\" values are different\n";
         }
         comm->barrier();
+        if (opts.early_exit) return OMEGA_H_DIFF;
         result = OMEGA_H_DIFF;
       }
     }
@@ -290,6 +466,7 @@ void get_diff_program_cmdline(
   floorflag.add_arg<double>("value");
   p_cmdline->add_flag("-superset",
       std::string("Allow ") + b_name + " to have more variables than" + a_name);
+  p_cmdline->add_flag("-early-exit", "Stop at the first array that differs");
   auto& fileflag = p_cmdline->add_flag("-f", "Read exodiff command file");
   fileflag.add_arg<std::string>("cmd_file");
 }
@@ -438,6 +615,7 @@ void accept_diff_program_cmdline(CmdLine const& cmdline, Mesh const* mesh,
   } else {
     *p_opts = MeshCompareOpts::init(mesh, all_defaults);
   }
+  p_opts->early_exit = cmdline.parsed("-early-exit");
 }
 
 #define EXPL_INST(T)                                                           \
@@ -23,6 +23,8 @@ struct VarCompareOpts {
 struct MeshCompareOpts {
   std::map<std::string, VarCompareOpts> tags2opts[4];
   VarCompareOpts time_step_opts;
+  /* return OMEGA_H_DIFF at the first array that differs */
+  bool early_exit = false;
   VarCompareOpts tag_opts(int dim, std::string const& name) const;
   static MeshCompareOpts init(Mesh const* mesh, VarCompareOpts var_opts);
 };
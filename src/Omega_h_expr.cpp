@@ -1133,4 +1133,661 @@ any ExprOpsReader::at_reduce(int prod, std::vector<any>& rhs) {
 
 #undef OMEGA_H_BINARY_REDUCE
 
+namespace {
+
+/* Bytecode for CompiledExpr. Each instruction is six integers:
+   {code, dst, a, b, c, n}, where a, b and c are source registers (or
+   pool offsets and component indices) and n is the number of result
+   components written to register dst. */
+enum ExprCode {
+  EXPR_LOAD_LITERAL,
+  EXPR_LOAD_UNIFORM,
+  EXPR_LOAD_INPUT,
+  EXPR_COPY,
+  EXPR_ZERO,
+  EXPR_NEG,
+  EXPR_ADD,
+  EXPR_SUB,
+  EXPR_SCALE,
+  EXPR_DIV,
+  EXPR_POW,
+  EXPR_DOT,
+  EXPR_MATVEC,
+  EXPR_MATMAT,
+  EXPR_GT,
+  EXPR_LT,
+  EXPR_EQ,
+  EXPR_OR,
+  EXPR_AND,
+  EXPR_SELECT,
+  EXPR_EXP,
+  EXPR_SQRT,
+  EXPR_SIN,
+  EXPR_COS,
+  EXPR_ERF,
+  EXPR_NORM,
+  EXPR_GET_COMP,
+  EXPR_SET_COMP,
+};
+
+constexpr Int expr_instr_width = 6;
+constexpr Int expr_max_regs = 16;
+constexpr Int expr_max_inputs = 8;
+/* entities interpreted together by one thread, so that each instruction
+   is decoded once per block and its inner loop can be vectorized */
+#ifdef OMEGA_H_USE_CUDA
+constexpr Int expr_block = 1;
+#else
+constexpr Int expr_block = 32;
+#endif
+
+/* ncomps == 0 means the op produced no value (an assignment) */
+struct ExprType {
+  Int ncomps;
+  bool is_bool;
+};
+
+class ExprCompiler {
+ public:
+  ExprCompiler(ExprEnv const& env_in) : env(env_in), reserved(0) {}
+  ExprType compile(ExprOp const* op, Int reg);
+  ExprEnv const& env;
+  std::vector<LO> code;
+  std::vector<Real> literals;
+  std::vector<CompiledExpr::Variable> uniforms;
+  std::vector<CompiledExpr::Variable> inputs;
+
+ private:
+  struct Binding {
+    Int reg;
+    ExprType type;
+  };
+  std::map<std::string, Binding> bindings;
+  Int reserved;
+  void emit(Int op, Int dst, Int a, Int b, Int c, Int n);
+  void check_reg(Int reg);
+  ExprType compile_var(std::string const& name, Int reg);
+  ExprType compile_binary(Int prod, ExprOp const* lhs, ExprOp const* rhs,
+      Int reg, char const* symbol);
+  ExprType compile_call(CallOp const* op, Int reg);
+};
+
+[[noreturn]] void fail_compile(std::string const& what) {
+  throw ParserFail("CompiledExpr: " + what + "\n");
+}
+
+void ExprCompiler::emit(Int op, Int dst, Int a, Int b, Int c, Int n) {
+  LO const instr[expr_instr_width] = {op, dst, a, b, c, n};
+  code.insert(code.end(), instr, instr + expr_instr_width);
+}
+
+void ExprCompiler::check_reg(Int reg) {
+  OMEGA_H_CHECK(reg >= reserved);
+  if (reg >= expr_max_regs) {
+    fail_compile("expression needs more than 16 registers");
+  }
+}
+
+static bool is_real(ExprType t) { return t.ncomps > 0 && !t.is_bool; }
+
+static bool is_scalar(ExprType t) { return t.ncomps == 1 && !t.is_bool; }
+
+template <Int dim>
+bool get_uniform_type(any const& value, ExprType* type) {
+  if (value.type() == typeid(Vector<dim>)) {
+    *type = {dim, false};
+  } else if (value.type() == typeid(Tensor<dim>)) {
+    *type = {dim * dim, false};
+  } else {
+    return false;
+  }
+  return true;
+}
+
+ExprType ExprCompiler::compile_var(std::string const& name, Int reg) {
+  auto bit = bindings.find(name);
+  if (bit != bindings.end()) {
+    emit(EXPR_COPY, reg, bit->second.reg, 0, 0, bit->second.type.ncomps);
+    return bit->second.type;
+  }
+  auto it = env.variables.find(name);
+  if (it == env.variables.end()) {
+    fail_compile("unknown variable name \"" + name + "\"");
+  }
+  auto& value = it->second;
+  if (value.type() == typeid(Reals)) {
+    auto size = any_cast<Reals>(value).size();
+    auto ncomps = env.size ? size / env.size : 1;
+    if (size != ncomps * env.size ||
+        (ncomps != 1 && ncomps != env.dim && ncomps != env.dim * env.dim)) {
+      fail_compile("array \"" + name + "\" isn't sized per entity");
+    }
+    std::size_t index = 0;
+    while (index < inputs.size() && inputs[index].name != name) ++index;
+    if (index == inputs.size()) {
+      if (index == expr_max_inputs) {
+        fail_compile("expression reads more than 8 arrays");
+      }
+      inputs.push_back({name, ncomps, false});
+    }
+    emit(EXPR_LOAD_INPUT, reg, Int(index), 0, 0, ncomps);
+    return {ncomps, false};
+  }
+  ExprType type;
+  if (value.type() == typeid(Real)) {
+    type = {1, false};
+  } else if (value.type() == typeid(bool)) {
+    type = {1, true};
+  } else if (!((env.dim == 3 && get_uniform_type<3>(value, &type)) ||
+                 (env.dim == 2 && get_uniform_type<2>(value, &type)) ||
+                 (env.dim == 1 && get_uniform_type<1>(value, &type)))) {
+    fail_compile("variable \"" + name + "\" has an unsupported type");
+  }
+  Int offset = 0;
+  std::size_t index = 0;
+  for (; index < uniforms.size() && uniforms[index].name != name; ++index) {
+    offset += uniforms[index].ncomps;
+  }
+  if (index == uniforms.size()) {
+    uniforms.push_back({name, type.ncomps, type.is_bool});
+  }
+  emit(EXPR_LOAD_UNIFORM, reg, offset, 0, 0, type.ncomps);
+  return type;
+}
+
+ExprType ExprCompiler::compile_binary(Int prod, ExprOp const* lhs,
+    ExprOp const* rhs, Int reg, char const* symbol) {
+  auto const dim = env.dim;
+  auto lt = compile(lhs, reg);
+  auto rt = compile(rhs, reg + 1);
+  auto const a = reg;
+  auto const b = reg + 1;
+  switch (prod) {
+    case math_lang::PROD_ADD:
+    case math_lang::PROD_SUB:
+      if (!is_real(lt) || lt.ncomps != rt.ncomps || rt.is_bool) break;
+      emit(prod == math_lang::PROD_ADD ? EXPR_ADD : EXPR_SUB, reg, a, b, 0,
+          lt.ncomps);
+      return lt;
+    case math_lang::PROD_MUL:
+      if (!is_real(lt) || !is_real(rt)) break;
+      if (lt.ncomps == 1) {
+        emit(EXPR_SCALE, reg, a, b, 0, rt.ncomps);
+        return rt;
+      }
+      if (rt.ncomps == 1) {
+        emit(EXPR_SCALE, reg, b, a, 0, lt.ncomps);
+        return lt;
+      }
+      if (lt.ncomps == dim && rt.ncomps == dim) {
+        emit(EXPR_DOT, reg, a, b, 0, 1);
+        return {1, false};
+      }
+      if (lt.ncomps == dim * dim && rt.ncomps == dim) {
+        emit(EXPR_MATVEC, reg, a, b, 0, dim);
+        return rt;
+      }
+      if (lt.ncomps == dim * dim && rt.ncomps == dim * dim) {
+        emit(EXPR_MATMAT, reg, a, b, 0, dim * dim);
+        return lt;
+      }
+      break;
+    case math_lang::PROD_DIV:
+      if (!is_real(lt) || !is_scalar(rt)) break;
+      emit(EXPR_DIV, reg, a, b, 0, lt.ncomps);
+      return lt;
+    case math_lang::PROD_POW:
+      if (!is_scalar(lt) || !is_scalar(rt)) break;
+      emit(EXPR_POW, reg, a, b, 0, 1);
+      return lt;
+    case math_lang::PROD_GT:
+    case math_lang::PROD_LT:
+    case math_lang::PROD_EQ:
+      if (!is_scalar(lt) || !is_scalar(rt)) break;
+      emit(prod == math_lang::PROD_GT
+               ? EXPR_GT
+               : (prod == math_lang::PROD_LT ? EXPR_LT : EXPR_EQ),
+          reg, a, b, 0, 1);
+      return {1, true};
+    case math_lang::PROD_OR:
+    case math_lang::PROD_AND:
+      if (!lt.is_bool || !rt.is_bool) break;
+      emit(prod == math_lang::PROD_OR ? EXPR_OR : EXPR_AND, reg, a, b, 0, 1);
+      return lt;
+  }
+  fail_compile(std::string("invalid operand types to ") + symbol + " operator");
+}
+
+static Int get_literal_index(ExprOp const* op) {
+  auto literal = dynamic_cast<ConstOp const*>(op);
+  if (!literal) fail_compile("component indices must be constants");
+  return static_cast<Int>(literal->value);
+}
+
+ExprType ExprCompiler::compile_call(CallOp const* op, Int reg) {
+  auto const dim = env.dim;
+  auto const& name = op->name;
+  auto const nargs = Int(op->rhs.size());
+  if (bindings.count(name) || env.variables.count(name)) {
+    /* access operator for vector/matrix */
+    auto t = compile_var(name, reg);
+    Int comp = -1;
+    if (nargs == 1 && t.ncomps == dim) {
+      comp = get_literal_index(op->rhs[0].get());
+    } else if (nargs == 2 && t.ncomps == dim * dim) {
+      comp = get_literal_index(op->rhs[0].get()) * dim +
+             get_literal_index(op->rhs[1].get());
+    }
+    if (t.is_bool || comp < 0 || comp >= t.ncomps) {
+      fail_compile("invalid access to \"" + name + "\"");
+    }
+    emit(EXPR_GET_COMP, reg, reg, comp, 0, 1);
+    return {1, false};
+  }
+  std::map<std::string, Int> const scalar_funcs = {{"exp", EXPR_EXP},
+      {"sqrt", EXPR_SQRT}, {"sin", EXPR_SIN}, {"cos", EXPR_COS},
+      {"erf", EXPR_ERF}};
+  auto fit = scalar_funcs.find(name);
+  if (fit != scalar_funcs.end() || name == "norm") {
+    if (nargs != 1) fail_compile(name + "() takes exactly one argument");
+    auto t = compile(op->rhs[0].get(), reg);
+    if (fit != scalar_funcs.end() && is_scalar(t)) {
+      emit(fit->second, reg, reg, 0, 0, 1);
+      return t;
+    }
+    if (name == "norm" && is_real(t) && t.ncomps == dim) {
+      emit(EXPR_NORM, reg, reg, 0, 0, 1);
+      return {1, false};
+    }
+    fail_compile("invalid argument type to " + name + "()");
+  }
+  if (name == "vector" || name == "matrix" || name == "tensor") {
+    auto const ncomps = (name == "vector") ? dim : dim * dim;
+    if (name != "vector" && nargs == 1) {
+      auto literal = dynamic_cast<ConstOp const*>(op->rhs[0].get());
+      if (literal && literal->value == 0.0) {
+        emit(EXPR_ZERO, reg, 0, 0, 0, ncomps);
+        return {ncomps, false};
+      }
+    }
+    if (nargs < 1 || nargs > ncomps || (name != "vector" && nargs != ncomps)) {
+      fail_compile("wrong number of arguments to " + name + "()");
+    }
+    for (Int i = 0; i < nargs; ++i) {
+      check_reg(reg + 1 + i);
+      if (!is_scalar(compile(op->rhs[std::size_t(i)].get(), reg + 1 + i))) {
+        fail_compile("arguments to " + name + "() must be scalars");
+      }
+    }
+    /* like vector(), repeat the last argument into missing components */
+    for (Int i = 0; i < ncomps; ++i) {
+      emit(EXPR_SET_COMP, reg, reg + 1 + min2(i, nargs - 1), i, 0, 0);
+    }
+    return {ncomps, false};
+  }
+  fail_compile("function \"" + name + "\" can't be compiled");
+}
+
+ExprType ExprCompiler::compile(ExprOp const* op, Int reg) {
+  check_reg(reg);
+  if (auto literal = dynamic_cast<ConstOp const*>(op)) {
+    emit(EXPR_LOAD_LITERAL, reg, Int(literals.size()), 0, 0, 1);
+    literals.push_back(literal->value);
+    return {1, false};
+  }
+  if (auto var = dynamic_cast<VarOp const*>(op)) {
+    return compile_var(var->name, reg);
+  }
+  if (auto seq = dynamic_cast<SemicolonOp const*>(op)) {
+    compile(seq->lhs.get(), reg);
+    auto const rhs_reg = max2(reg, reserved);
+    auto t = compile(seq->rhs.get(), rhs_reg);
+    if (t.ncomps && rhs_reg != reg) {
+      /* bindings made by the statements are dead once the value exists */
+      reserved = reg;
+      emit(EXPR_COPY, reg, rhs_reg, 0, 0, t.ncomps);
+    }
+    return t;
+  }
+  if (auto assign = dynamic_cast<AssignOp const*>(op)) {
+    auto t = compile(assign->rhs.get(), reg);
+    if (!t.ncomps) fail_compile("assignment of a statement");
+    bindings[assign->name] = {reg, t};
+    reserved = reg + 1;
+    return {0, false};
+  }
+  if (auto neg = dynamic_cast<NegOp const*>(op)) {
+    auto t = compile(neg->rhs.get(), reg);
+    if (!is_real(t)) fail_compile("invalid operand type to negation");
+    emit(EXPR_NEG, reg, reg, 0, 0, t.ncomps);
+    return t;
+  }
+  if (auto tern = dynamic_cast<TernaryOp const*>(op)) {
+    check_reg(reg + 2);
+    auto ct = compile(tern->cond.get(), reg);
+    auto lt = compile(tern->lhs.get(), reg + 1);
+    auto rt = compile(tern->rhs.get(), reg + 2);
+    if (!ct.is_bool || ct.ncomps != 1 || lt.ncomps != rt.ncomps ||
+        lt.is_bool != rt.is_bool || !lt.ncomps) {
+      fail_compile("invalid operand types to ternary operator");
+    }
+    emit(EXPR_SELECT, reg, reg, reg + 1, reg + 2, lt.ncomps);
+    return lt;
+  }
+  if (auto call = dynamic_cast<CallOp const*>(op)) {
+    return compile_call(call, reg);
+  }
+  check_reg(reg + 1);
+#define OMEGA_H_COMPILE_BINARY(ClassName, prod, symbol)                        \
+  if (auto bin = dynamic_cast<ClassName const*>(op)) {                         \
+    return compile_binary(prod, bin->lhs.get(), bin->rhs.get(), reg, symbol);  \
+  }
+  OMEGA_H_COMPILE_BINARY(OrOp, math_lang::PROD_OR, "||")
+  OMEGA_H_COMPILE_BINARY(AndOp, math_lang::PROD_AND, "&&")
+  OMEGA_H_COMPILE_BINARY(GtOp, math_lang::PROD_GT, ">")
+  OMEGA_H_COMPILE_BINARY(LtOp, math_lang::PROD_LT, "<")
+  OMEGA_H_COMPILE_BINARY(EqOp, math_lang::PROD_EQ, "==")
+  OMEGA_H_COMPILE_BINARY(AddOp, math_lang::PROD_ADD, "+")
+  OMEGA_H_COMPILE_BINARY(SubOp, math_lang::PROD_SUB, "-")
+  OMEGA_H_COMPILE_BINARY(MulOp, math_lang::PROD_MUL, "*")
+  OMEGA_H_COMPILE_BINARY(DivOp, math_lang::PROD_DIV, "/")
+  OMEGA_H_COMPILE_BINARY(PowOp, math_lang::PROD_POW, "^")
+#undef OMEGA_H_COMPILE_BINARY
+  fail_compile("unsupported operation");
+}
+
+/* registers hold component k of lane j at [k][j] */
+#define OMEGA_H_EXPR_LANES(n, stmt)                                            \
+  for (Int k = 0; k < (n); ++k) {                                              \
+    for (Int j = 0; j < nj; ++j) stmt;                                         \
+  }
+
+template <Int dim>
+void run_compiled_expr(LO size, LOs code, Reals literals, Reals uniforms,
+    Few<Reals, expr_max_inputs> inputs, Int ncomps, Write<Real> out) {
+  constexpr Int w = dim * dim;
+  using Reg = Real[w][expr_block];
+  auto const ninstrs = code.size() / expr_instr_width;
+  auto const nblocks = (size + expr_block - 1) / expr_block;
+  auto f = OMEGA_H_LAMBDA(LO block) {
+    /* operands may alias the destination register, so ops reading a
+       scalar operand write component 0 last and the products that mix
+       components go through a temporary */
+    Reg r[expr_max_regs];
+    auto const first = block * expr_block;
+    auto const nj = min2(expr_block, size - first);
+    for (LO pc = 0; pc < ninstrs; ++pc) {
+      auto const i = pc * expr_instr_width;
+      auto const op = code[i];
+      auto const a = code[i + 2];
+      auto const b = code[i + 3];
+      auto const n = code[i + 5];
+      auto& d = r[code[i + 1]];
+      auto const& ra = r[a];
+      auto const& rb = r[b];
+      switch (op) {
+        case EXPR_LOAD_LITERAL:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = literals[a])
+          break;
+        case EXPR_LOAD_UNIFORM:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = uniforms[a + k])
+          break;
+        case EXPR_LOAD_INPUT:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = inputs[a][(first + j) * n + k])
+          break;
+        case EXPR_COPY:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = ra[k][j])
+          break;
+        case EXPR_ZERO:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = 0.0)
+          break;
+        case EXPR_NEG:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = -ra[k][j])
+          break;
+        case EXPR_ADD:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = ra[k][j] + rb[k][j])
+          break;
+        case EXPR_SUB:
+          OMEGA_H_EXPR_LANES(n, d[k][j] = ra[k][j] - rb[k][j])
+          break;
+        case EXPR_SCALE:
+          for (Int k = n - 1; k >= 0; --k) {
+            for (Int j = 0; j < nj; ++j) d[k][j] = ra[0][j] * rb[k][j];
+          }
+          break;
+        case EXPR_DIV:
+          /* same as divide_each_maybe_zero() */
+          OMEGA_H_EXPR_LANES(n,
+              d[k][j] = (rb[0][j] != 0.0) ? (ra[k][j] / rb[0][j]) : 0.0)
+          break;
+        case EXPR_POW:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::pow(ra[0][j], rb[0][j]))
+          break;
+        case EXPR_DOT:
+          for (Int j = 0; j < nj; ++j) {
+            Real s = 0.0;
+            for (Int k = 0; k < dim; ++k) s += ra[k][j] * rb[k][j];
+            d[0][j] = s;
+          }
+          break;
+        case EXPR_MATVEC:
+          /* matrices are stored row by row, see matrix2vector() */
+          for (Int j = 0; j < nj; ++j) {
+            Real t[dim];
+            for (Int k = 0; k < dim; ++k) {
+              t[k] = 0.0;
+              for (Int l = 0; l < dim; ++l) {
+                t[k] += ra[k * dim + l][j] * rb[l][j];
+              }
+            }
+            for (Int k = 0; k < dim; ++k) d[k][j] = t[k];
+          }
+          break;
+        case EXPR_MATMAT:
+          for (Int j = 0; j < nj; ++j) {
+            Real t[w];
+            for (Int k = 0; k < dim; ++k) {
+              for (Int l = 0; l < dim; ++l) {
+                t[k * dim + l] = 0.0;
+                for (Int m = 0; m < dim; ++m) {
+                  t[k * dim + l] += ra[k * dim + m][j] * rb[m * dim + l][j];
+                }
+              }
+            }
+            for (Int k = 0; k < w; ++k) d[k][j] = t[k];
+          }
+          break;
+        case EXPR_GT:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = Real(ra[0][j] > rb[0][j]))
+          break;
+        case EXPR_LT:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = Real(ra[0][j] < rb[0][j]))
+          break;
+        case EXPR_EQ:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = Real(ra[0][j] == rb[0][j]))
+          break;
+        case EXPR_OR:
+          OMEGA_H_EXPR_LANES(
+              1, d[k][j] = Real(ra[0][j] != 0.0 || rb[0][j] != 0.0))
+          break;
+        case EXPR_AND:
+          OMEGA_H_EXPR_LANES(
+              1, d[k][j] = Real(ra[0][j] != 0.0 && rb[0][j] != 0.0))
+          break;
+        case EXPR_SELECT: {
+          auto const& rc = r[code[i + 4]];
+          for (Int k = n - 1; k >= 0; --k) {
+            for (Int j = 0; j < nj; ++j) {
+              d[k][j] = (ra[0][j] != 0.0) ? rb[k][j] : rc[k][j];
+            }
+          }
+          break;
+        }
+        case EXPR_EXP:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::exp(ra[0][j]))
+          break;
+        case EXPR_SQRT:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::sqrt(ra[0][j]))
+          break;
+        case EXPR_SIN:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::sin(ra[0][j]))
+          break;
+        case EXPR_COS:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::cos(ra[0][j]))
+          break;
+        case EXPR_ERF:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = std::erf(ra[0][j]))
+          break;
+        case EXPR_NORM:
+          for (Int j = 0; j < nj; ++j) {
+            Real s = 0.0;
+            for (Int k = 0; k < dim; ++k) s += square(ra[k][j]);
+            d[0][j] = std::sqrt(s);
+          }
+          break;
+        case EXPR_GET_COMP:
+          OMEGA_H_EXPR_LANES(1, d[k][j] = ra[b][j])
+          break;
+        case EXPR_SET_COMP:
+          for (Int j = 0; j < nj; ++j) d[b][j] = ra[0][j];
+          break;
+      }
+    }
+    for (Int j = 0; j < nj; ++j) {
+      for (Int k = 0; k < ncomps; ++k) {
+        out[(first + j) * ncomps + k] = r[0][k][j];
+      }
+    }
+  };
+  parallel_for(nblocks, std::move(f), "CompiledExpr::eval");
+}
+
+#undef OMEGA_H_EXPR_LANES
+
+void run_compiled_expr(Int dim, LO size, LOs code, Reals literals,
+    Reals uniforms, Few<Reals, expr_max_inputs> inputs, Int ncomps,
+    Write<Real> out) {
+  if (dim == 3) {
+    run_compiled_expr<3>(size, code, literals, uniforms, inputs, ncomps, out);
+  } else if (dim == 2) {
+    run_compiled_expr<2>(size, code, literals, uniforms, inputs, ncomps, out);
+  } else {
+    run_compiled_expr<1>(size, code, literals, uniforms, inputs, ncomps, out);
+  }
+}
+
+template <typename T>
+Read<T> to_device(std::vector<T> const& values) {
+  auto out = HostWrite<T>(LO(values.size()));
+  for (std::size_t i = 0; i < values.size(); ++i) out[LO(i)] = values[i];
+  return out.write();
+}
+
+template <Int dim>
+void get_uniform_values(any const& value, Real* values) {
+  if (value.type() == typeid(Vector<dim>)) {
+    auto v = any_cast<Vector<dim>>(value);
+    for (Int k = 0; k < dim; ++k) values[k] = v[k];
+  } else {
+    auto v = matrix2vector(any_cast<Tensor<dim>>(value));
+    for (Int k = 0; k < dim * dim; ++k) values[k] = v[k];
+  }
+}
+
+}  // end anonymous namespace
+
+CompiledExpr::CompiledExpr(OpPtr const& op, ExprEnv const& env)
+    : dim(env.dim) {
+  OMEGA_H_TIME_FUNCTION;
+  ExprCompiler compiler(env);
+  auto type = compiler.compile(op.get(), 0);
+  if (!is_real(type)) fail_compile("the program has no real value");
+  code = to_device(compiler.code);
+  literals = to_device(compiler.literals);
+  uniforms = compiler.uniforms;
+  inputs = compiler.inputs;
+  result_ncomps = type.ncomps;
+}
+
+Int CompiledExpr::ncomps() const { return result_ncomps; }
+
+Reals CompiledExpr::eval(ExprEnv const& env) const {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(env.dim == dim);
+  auto changed = [](std::string const& name) {
+    fail_compile("variable \"" + name + "\" changed type since compilation");
+  };
+  Int nuniform_values = 0;
+  for (auto& u : uniforms) nuniform_values += u.ncomps;
+  auto uniform_values = HostWrite<Real>(nuniform_values);
+  Int offset = 0;
+  for (auto& u : uniforms) {
+    auto it = env.variables.find(u.name);
+    if (it == env.variables.end()) changed(u.name);
+    auto& value = it->second;
+    auto values = uniform_values.data() + offset;
+    if (u.is_bool) {
+      if (value.type() != typeid(bool)) changed(u.name);
+      values[0] = Real(any_cast<bool>(value));
+    } else if (u.ncomps == 1 && value.type() == typeid(Real)) {
+      values[0] = any_cast<Real>(value);
+    } else if (dim == 3 && (value.type() == typeid(Vector<3>) ||
+                               value.type() == typeid(Tensor<3>))) {
+      get_uniform_values<3>(value, values);
+    } else if (dim == 2 && (value.type() == typeid(Vector<2>) ||
+                               value.type() == typeid(Tensor<2>))) {
+      get_uniform_values<2>(value, values);
+    } else if (dim == 1 && (value.type() == typeid(Vector<1>) ||
+                               value.type() == typeid(Tensor<1>))) {
+      get_uniform_values<1>(value, values);
+    } else {
+      changed(u.name);
+    }
+    offset += u.ncomps;
+  }
+  Few<Reals, expr_max_inputs> input_arrays;
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    auto it = env.variables.find(inputs[i].name);
+    if (it == env.variables.end() || it->second.type() != typeid(Reals) ||
+        any_cast<Reals>(it->second).size() != env.size * inputs[i].ncomps) {
+      changed(inputs[i].name);
+    }
+    input_arrays[Int(i)] = any_cast<Reals>(it->second);
+  }
+  auto uniform_array = Reals(uniform_values.write());
+  auto out = Write<Real>(env.size * result_ncomps);
+  run_compiled_expr(dim, env.size, code, literals, uniform_array, input_arrays,
+      result_ncomps, out);
+  return Reals(out);
+}
+
+FieldExpr::FieldExpr(std::string const& expr)
+    : FieldExpr(ExprOpsReader().read_ops(expr)) {}
+
+FieldExpr::FieldExpr(OpPtr const& op_in) : op(op_in), can_compile(true) {}
+
+Reals FieldExpr::eval(ExprEnv& env) {
+  if (compiled) {
+    try {
+      return compiled->eval(env);
+    } catch (ParserFail const&) {
+      compiled.reset();
+    }
+  }
+  if (can_compile) {
+    try {
+      compiled = std::make_shared<CompiledExpr>(op, env);
+      return compiled->eval(env);
+    } catch (ParserFail const&) {
+      compiled.reset();
+      can_compile = false;
+    }
+  }
+  auto result = op->eval(env);
+  env.repeat(result);
+  return any_cast<Reals>(result);
+}
+
+bool FieldExpr::is_compiled() const { return bool(compiled); }
+
 }  // end namespace Omega_h
@@ -44,6 +44,55 @@ class ExprOpsReader : public Reader {
   any at_reduce(int token, std::vector<any>& rhs) override final;
 };
 
+/* An ExprOp tree type-checked once against the variables of an ExprEnv
+   and lowered to bytecode. eval() interprets the bytecode for every
+   entity inside a single parallel_for with temporaries held in registers,
+   so no intermediate arrays are allocated and scalars are never
+   promoted to arrays. Variables may change value between evaluations but
+   must keep their type, and array variables their width.
+   Throws ParserFail for expressions it can't lower, such as calls to
+   functions other than the built-in ones. */
+class CompiledExpr {
+ public:
+  CompiledExpr(OpPtr const& op, ExprEnv const& env);
+  /* returns ncomps() values per entity */
+  Reals eval(ExprEnv const& env) const;
+  Int ncomps() const;
+
+  struct Variable {
+    std::string name;
+    Int ncomps;
+    bool is_bool;
+  };
+
+ private:
+  Int dim;
+  LOs code;
+  Reals literals;
+  std::vector<Variable> uniforms;
+  std::vector<Variable> inputs;
+  Int result_ncomps;
+};
+
+/* What field initializers and boundary expressions should evaluate:
+   an expression compiled to a CompiledExpr on its first eval(), and
+   recompiled if a variable changes type. Expressions that can't be
+   compiled, such as those calling user functions, fall back to
+   interpreting the ExprOp tree. Either way the result has a real value
+   per entity, with scalars and constants repeated for every entity. */
+class FieldExpr {
+ public:
+  FieldExpr(std::string const& expr);
+  FieldExpr(OpPtr const& op_in);
+  Reals eval(ExprEnv& env);
+  bool is_compiled() const;
+
+ private:
+  OpPtr op;
+  std::shared_ptr<CompiledExpr> compiled;
+  bool can_compile;
+};
+
 class ExprReader : public Reader {
  public:
   using Args = ExprEnv::Args;
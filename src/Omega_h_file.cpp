@@ -3,19 +3,31 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <cerrno>
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
 
 #ifdef OMEGA_H_USE_ZLIB
 #include <zlib.h>
 #endif
 
+#include "Omega_h_adj.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_build.hpp"
+#include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_inertia.hpp"
+#include "Omega_h_int_iterator.hpp"
+#include "Omega_h_linpart.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_reduce.hpp"
 
 namespace Omega_h {
 
@@ -87,6 +99,37 @@ struct SwapBytes<T, 8> {
 
 unsigned char const magic[2] = {0xa1, 0x1a};
 
+/* Where the bytes of an array record live for incremental checkpoints.
+   The directory is relative to the checkpoint holding the index
+   unless it is absolute, "." being that checkpoint itself. */
+struct ArrayLocation {
+  filesystem::path dir;
+  I64 offset;
+  I8 is_compressed;
+  I64 nbytes;
+  I64 check;
+};
+
+struct ArrayHash {
+  I64 key;
+  I64 check;
+  I64 nbytes;
+};
+
+using ArrayIndex = std::map<I64, ArrayLocation>;
+
+struct IncrementalWrite {
+  ArrayIndex previous;
+  ArrayIndex current;
+};
+
+struct IncrementalRead {
+  filesystem::path dir;
+  I32 rank;
+  ArrayIndex index;
+  std::map<std::string, std::shared_ptr<std::ifstream>> files;
+};
+
 }  // end anonymous namespace
 
 template <typename T>
@@ -183,6 +226,169 @@ void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
   array = swap_bytes(Read<T>(uncompressed.write()), needs_swapping);
 }
 
+OMEGA_H_INLINE std::uint64_t mix_word_a(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+OMEGA_H_INLINE std::uint64_t mix_word_b(std::uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  return x ^ (x >> 33);
+}
+
+/* two independent 64-bit hashes of the array contents, each a sum over
+   the entries of a mixed (entry, position) word so they reduce in
+   parallel on the device. the first keys the index, the second and the
+   byte count are compared before an array is referenced instead of
+   being written */
+template <typename T>
+static ArrayHash hash_array(Read<T> array) {
+  static_assert(sizeof(T) <= sizeof(std::uint64_t), "entry wider than a word");
+  auto const bytes = reinterpret_cast<unsigned char const*>(array.data());
+  auto const word = OMEGA_H_LAMBDA(LO i)->std::uint64_t {
+    std::uint64_t w = 0;
+    for (std::size_t b = 0; b < sizeof(T); ++b) {
+      w |= std::uint64_t(bytes[std::size_t(i) * sizeof(T) + b]) << (8 * b);
+    }
+    return w;
+  };
+  auto const first = IntIterator(0);
+  auto const last = IntIterator(array.size());
+  auto const op = plus<std::uint64_t>();
+  auto const sum_a = transform_reduce(first, last, std::uint64_t(0), op,
+      OMEGA_H_LAMBDA(LO i)->std::uint64_t {
+        auto const position = std::uint64_t(i + 1) * 0x9e3779b97f4a7c15ULL;
+        return mix_word_a(word(i) + position);
+      });
+  auto const sum_b = transform_reduce(first, last, std::uint64_t(0), op,
+      OMEGA_H_LAMBDA(LO i)->std::uint64_t {
+        auto const position = std::uint64_t(i + 1) * 0xd6e8feb86659fd93ULL;
+        return mix_word_b(word(i) ^ position);
+      });
+  ArrayHash hash;
+  hash.nbytes = I64(array.size()) * I64(sizeof(T));
+  auto const shape = mix_word_a(std::uint64_t(hash.nbytes) ^ sizeof(T));
+  hash.key = static_cast<I64>(mix_word_a(sum_a ^ shape));
+  hash.check = static_cast<I64>(mix_word_b(sum_b ^ shape));
+  return hash;
+}
+
+static bool is_same_array(
+    ArrayLocation const& location, ArrayHash const& hash) {
+  return location.nbytes == hash.nbytes && location.check == hash.check;
+}
+
+/* since version 10 every array record is preceded by a flag saying whether
+   it is stored inline or is a hash referencing a record found through the
+   checkpoint's index file */
+template <typename T>
+static void write_entry(std::ostream& stream, Read<T> array,
+    bool is_compressed, bool needs_swapping, IncrementalWrite* incremental) {
+  if (incremental) {
+    auto const hash = hash_array(array);
+    auto const in_current = incremental->current.find(hash.key);
+    if (in_current != incremental->current.end()) {
+      if (is_same_array(in_current->second, hash)) {
+        write_value(stream, I8(1), needs_swapping);
+        write_value(stream, hash.key, needs_swapping);
+        return;
+      }
+      /* different contents under the same key: store this one inline
+         and leave the index entry to the first */
+      write_value(stream, I8(0), needs_swapping);
+      write_array(stream, array, is_compressed, needs_swapping);
+      return;
+    }
+    auto const in_previous = incremental->previous.find(hash.key);
+    if (in_previous != incremental->previous.end() &&
+        is_same_array(in_previous->second, hash)) {
+      incremental->current[hash.key] = in_previous->second;
+      write_value(stream, I8(1), needs_swapping);
+      write_value(stream, hash.key, needs_swapping);
+      return;
+    }
+    write_value(stream, I8(0), needs_swapping);
+    auto const offset = static_cast<I64>(stream.tellp());
+    incremental->current[hash.key] = {
+        ".", offset, I8(is_compressed), hash.nbytes, hash.check};
+    write_array(stream, array, is_compressed, needs_swapping);
+    return;
+  }
+  write_value(stream, I8(0), needs_swapping);
+  write_array(stream, array, is_compressed, needs_swapping);
+}
+
+static bool is_absolute(filesystem::path const& path) {
+  return !path.string().empty() &&
+         path.string()[0] == filesystem::path::preferred_separator;
+}
+
+static filesystem::path resolve_location(
+    filesystem::path const& base, filesystem::path const& dir) {
+  if (dir.string() == ".") return base;
+  if (is_absolute(dir)) return dir;
+  return base / dir;
+}
+
+/* opens the file holding an array that an incremental checkpoint refers
+   to, positioned at its record */
+static std::istream& open_reference(
+    IncrementalRead* incremental, I64 hash, ArrayLocation* p_location) {
+  if (!incremental) {
+    Omega_h_fail(
+        "binary::read: incremental checkpoint arrays can only be"
+        " resolved when reading from a directory\n");
+  }
+  auto const it = incremental->index.find(hash);
+  if (it == incremental->index.end()) {
+    Omega_h_fail("binary::read: array %lld missing from index of \"%s\"\n",
+        static_cast<long long>(hash), incremental->dir.c_str());
+  }
+  auto const& location = it->second;
+  auto filepath = resolve_location(incremental->dir, location.dir);
+  filepath /= std::to_string(incremental->rank);
+  filepath += ".osh";
+  auto& file = incremental->files[filepath.string()];
+  if (!file) {
+    file = std::make_shared<std::ifstream>(filepath.c_str(), std::ios::binary);
+    if (!file->is_open()) {
+      Omega_h_fail("binary::read: could not open referenced file \"%s\"\n",
+          filepath.c_str());
+    }
+  }
+  file->clear();
+  file->seekg(location.offset);
+  *p_location = location;
+  return *file;
+}
+
+template <typename T>
+static void read_entry(std::istream& stream, Read<T>& array,
+    bool is_compressed, I32 version, bool needs_swapping,
+    IncrementalRead* incremental) {
+  if (version < 10) {
+    read_array(stream, array, is_compressed, needs_swapping);
+    return;
+  }
+  I8 is_reference;
+  read_value(stream, is_reference, needs_swapping);
+  if (!is_reference) {
+    read_array(stream, array, is_compressed, needs_swapping);
+    return;
+  }
+  I64 hash;
+  read_value(stream, hash, needs_swapping);
+  ArrayLocation location;
+  auto& file = open_reference(incremental, hash, &location);
+  read_array(file, array, bool(location.is_compressed), needs_swapping);
+}
+
 void write(std::ostream& stream, std::string const& val, bool needs_swapping) {
   I32 len = static_cast<I32>(val.length());
   write_value(stream, len, needs_swapping);
@@ -223,8 +429,11 @@ static void write_meta(
   }
 }
 
-static void read_meta(
-    std::istream& stream, Mesh* mesh, Int version, bool needs_swapping) {
+/* part is -1 when the mesh communicator matches the one that wrote the
+   file, otherwise the part being read into a mesh on some other
+   communicator; the writer's communicator size is returned */
+static I32 read_meta(std::istream& stream, Mesh* mesh, Int version,
+    bool needs_swapping, I32 part) {
   if (version >= 7) {
     I8 family;
     read_value(stream, family, needs_swapping);
@@ -235,10 +444,14 @@ static void read_meta(
   mesh->set_dim(Int(dim));
   I32 comm_size;
   read_value(stream, comm_size, needs_swapping);
-  OMEGA_H_CHECK(mesh->comm()->size() == comm_size);
   I32 comm_rank;
   read_value(stream, comm_rank, needs_swapping);
-  OMEGA_H_CHECK(mesh->comm()->rank() == comm_rank);
+  if (part == -1) {
+    OMEGA_H_CHECK(mesh->comm()->size() == comm_size);
+    OMEGA_H_CHECK(mesh->comm()->rank() == comm_rank);
+  } else {
+    OMEGA_H_CHECK(part == comm_rank);
+  }
   I8 parting_i8;
   read_value(stream, parting_i8, needs_swapping);
   OMEGA_H_CHECK(parting_i8 == I8(OMEGA_H_ELEM_BASED) ||
@@ -268,10 +481,12 @@ static void read_meta(
     I8 keeps_canon;
     read_value(stream, keeps_canon, needs_swapping);
   }
+  return comm_size;
 }
 
 static void write_tag(std::ostream& stream, TagBase const* tag,
-    Int ent_dim, Mesh *mesh, bool is_compressed, bool needs_swapping) {
+    Int ent_dim, Mesh *mesh, bool is_compressed, bool needs_swapping,
+    IncrementalWrite* incremental) {
   std::string name = tag->name();
   write(stream, name, needs_swapping);
   auto ncomps = I8(tag->ncomps());
@@ -288,7 +503,8 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
       mesh->change_tagToMesh<I8> (ent_dim, ncomps, name, class_ids);
     }
 
-    write_array(stream, as<I8>(tag)->array(), is_compressed, needs_swapping);
+    write_entry(stream, as<I8>(tag)->array(), is_compressed, needs_swapping,
+        incremental);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I8> (ent_dim, ncomps, name, class_ids);
@@ -301,7 +517,8 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
       mesh->change_tagToMesh<I32> (ent_dim, ncomps, name, class_ids);
     }
 
-    write_array(stream, as<I32>(tag)->array(), is_compressed, needs_swapping);
+    write_entry(stream, as<I32>(tag)->array(), is_compressed, needs_swapping,
+        incremental);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I32> (ent_dim, ncomps, name, class_ids);
@@ -314,7 +531,8 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
       mesh->change_tagToMesh<I64> (ent_dim, ncomps, name, class_ids);
     }
 
-    write_array(stream, as<I64>(tag)->array(), is_compressed, needs_swapping);
+    write_entry(stream, as<I64>(tag)->array(), is_compressed, needs_swapping,
+        incremental);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I64> (ent_dim, ncomps, name, class_ids);
@@ -327,7 +545,8 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
       mesh->change_tagToMesh<Real> (ent_dim, ncomps, name, class_ids);
     }
 
-    write_array(stream, as<Real>(tag)->array(), is_compressed, needs_swapping);
+    write_entry(stream, as<Real>(tag)->array(), is_compressed, needs_swapping,
+        incremental);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<Real> (ent_dim, ncomps, name, class_ids);
@@ -339,7 +558,8 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
 }
 
 static void read_tag(std::istream& stream, Mesh* mesh, Int d,
-    bool is_compressed, I32 version, bool needs_swapping) {
+    bool is_compressed, I32 version, bool needs_swapping,
+    IncrementalRead* incremental) {
   std::string name;
   read(stream, name, needs_swapping);
   I8 ncomps;
@@ -359,7 +579,8 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
 
   if (type == OMEGA_H_I8) {
     Read<I8> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_entry(
+        stream, array, is_compressed, version, needs_swapping, incremental);
     mesh->add_tag(d, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -369,7 +590,8 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
 
   } else if (type == OMEGA_H_I32) {
     Read<I32> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_entry(
+        stream, array, is_compressed, version, needs_swapping, incremental);
     mesh->add_tag(d, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -379,7 +601,8 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
 
   } else if (type == OMEGA_H_I64) {
     Read<I64> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_entry(
+        stream, array, is_compressed, version, needs_swapping, incremental);
     mesh->add_tag(d, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -389,7 +612,8 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
 
   } else if (type == OMEGA_H_F64) {
     Read<Real> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_entry(
+        stream, array, is_compressed, version, needs_swapping, incremental);
     mesh->add_tag(d, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -434,8 +658,8 @@ static void read_sets(std::istream& stream, Mesh* mesh, bool needs_swapping) {
   }
 }
 
-void write(std::ostream& stream, Mesh* mesh) {
-  begin_code("binary::write(stream,Mesh)");
+static void write_mesh(
+    std::ostream& stream, Mesh* mesh, IncrementalWrite* incremental) {
   stream.write(reinterpret_cast<const char*>(magic), sizeof(magic));
 // write_value(stream, latest_version); moved to /version at version 4
 #ifdef OMEGA_H_USE_ZLIB
@@ -450,21 +674,26 @@ void write(std::ostream& stream, Mesh* mesh) {
   write_value(stream, nverts, needs_swapping);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     auto down = mesh->ask_down(d, d - 1);
-    write_array(stream, down.ab2b, is_compressed, needs_swapping);
+    write_entry(
+        stream, down.ab2b, is_compressed, needs_swapping, incremental);
     if (d > 1) {
-      write_array(stream, down.codes, is_compressed, needs_swapping);
+      write_entry(
+          stream, down.codes, is_compressed, needs_swapping, incremental);
     }
   }
   for (Int d = 0; d <= mesh->dim(); ++d) {
     auto nsaved_tags = mesh->ntags(d);
     write_value(stream, nsaved_tags, needs_swapping);
     for (Int i = 0; i < mesh->ntags(d); ++i) {
-      write_tag(stream, mesh->get_tag(d, i), d, mesh, is_compressed, needs_swapping);
+      write_tag(stream, mesh->get_tag(d, i), d, mesh, is_compressed,
+          needs_swapping, incremental);
     }
     if (mesh->comm()->size() > 1) {
       auto owners = mesh->ask_owners(d);
-      write_array(stream, owners.ranks, is_compressed, needs_swapping);
-      write_array(stream, owners.idxs, is_compressed, needs_swapping);
+      write_entry(
+          stream, owners.ranks, is_compressed, needs_swapping, incremental);
+      write_entry(
+          stream, owners.idxs, is_compressed, needs_swapping, incremental);
     }
   }
   write_sets(stream, mesh, needs_swapping);
@@ -473,15 +702,22 @@ void write(std::ostream& stream, Mesh* mesh) {
   if (has_parents) {
     for (Int d = 0; d <= mesh->dim(); ++d) {
       auto parents = mesh->ask_parents(d);
-      write_array(stream, parents.parent_idx, is_compressed, needs_swapping);
-      write_array(stream, parents.codes, is_compressed, needs_swapping);
+      write_entry(stream, parents.parent_idx, is_compressed, needs_swapping,
+          incremental);
+      write_entry(
+          stream, parents.codes, is_compressed, needs_swapping, incremental);
     }
   }
+}
+
+void write(std::ostream& stream, Mesh* mesh) {
+  begin_code("binary::write(stream,Mesh)");
+  write_mesh(stream, mesh, nullptr);
   end_code();
 }
 
-void read(std::istream& stream, Mesh* mesh, I32 version) {
-  ScopedTimer timer("binary::read(istream, mesh, version)");
+static void read_mesh(std::istream& stream, Mesh* mesh, I32 version,
+    IncrementalRead* incremental, I32 part) {
   unsigned char magic_in[2];
   stream.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
   OMEGA_H_CHECK(magic_in[0] == magic[0]);
@@ -495,15 +731,17 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
 #ifndef OMEGA_H_USE_ZLIB
   OMEGA_H_CHECK(!is_compressed);
 #endif
-  read_meta(stream, mesh, version, needs_swapping);
+  auto const comm_size = read_meta(stream, mesh, version, needs_swapping, part);
   LO nverts;
   read_value(stream, nverts, needs_swapping);
   mesh->set_verts(nverts);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     Adj down;
-    read_array(stream, down.ab2b, is_compressed, needs_swapping);
+    read_entry(stream, down.ab2b, is_compressed, version, needs_swapping,
+        incremental);
     if (d > 1) {
-      read_array(stream, down.codes, is_compressed, needs_swapping);
+      read_entry(stream, down.codes, is_compressed, version, needs_swapping,
+          incremental);
     }
     mesh->set_ents(d, down);
   }
@@ -511,12 +749,15 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     Int ntags;
     read_value(stream, ntags, needs_swapping);
     for (Int i = 0; i < ntags; ++i) {
-      read_tag(stream, mesh, d, is_compressed, version, needs_swapping);
+      read_tag(stream, mesh, d, is_compressed, version, needs_swapping,
+          incremental);
     }
-    if (mesh->comm()->size() > 1) {
+    if (comm_size > 1) {
       Remotes owners;
-      read_array(stream, owners.ranks, is_compressed, needs_swapping);
-      read_array(stream, owners.idxs, is_compressed, needs_swapping);
+      read_entry(stream, owners.ranks, is_compressed, version, needs_swapping,
+          incremental);
+      read_entry(stream, owners.idxs, is_compressed, version, needs_swapping,
+          incremental);
       mesh->set_owners(d, owners);
     }
   }
@@ -529,14 +770,21 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     if (has_parents) {
       for (Int d = 0; d <= mesh->dim(); ++d) {
         Parents parents;
-        read_array(stream, parents.parent_idx, is_compressed, needs_swapping);
-        read_array(stream, parents.codes, is_compressed, needs_swapping);
+        read_entry(stream, parents.parent_idx, is_compressed, version,
+            needs_swapping, incremental);
+        read_entry(stream, parents.codes, is_compressed, version,
+            needs_swapping, incremental);
         mesh->set_parents(d, parents);
       }
     }
   }
 }
 
+void read(std::istream& stream, Mesh* mesh, I32 version) {
+  ScopedTimer timer("binary::read(istream, mesh, version)");
+  read_mesh(stream, mesh, version, nullptr, -1);
+}
+
 static void write_int_file(
     filesystem::path const& filepath, Mesh* mesh, I32 value) {
   if (mesh->comm()->rank() == 0) {
@@ -610,16 +858,829 @@ void write(filesystem::path const& path, Mesh* mesh) {
   end_code();
 }
 
+static filesystem::path index_filepath(
+    filesystem::path const& path, I32 rank) {
+  auto filepath = path;
+  filepath /= std::to_string(rank);
+  filepath += ".index";
+  return filepath;
+}
+
+static void write_index(
+    filesystem::path const& filepath, ArrayIndex const& index) {
+  std::ofstream file(filepath.c_str(), std::ios::binary);
+  OMEGA_H_CHECK(file.is_open());
+  bool needs_swapping = !is_little_endian_cpu();
+  auto n = I32(index.size());
+  write_value(file, n, needs_swapping);
+  for (auto& entry : index) {
+    write_value(file, entry.first, needs_swapping);
+    write(file, entry.second.dir.string(), needs_swapping);
+    write_value(file, entry.second.offset, needs_swapping);
+    write_value(file, entry.second.is_compressed, needs_swapping);
+    write_value(file, entry.second.nbytes, needs_swapping);
+    write_value(file, entry.second.check, needs_swapping);
+  }
+}
+
+static ArrayIndex read_index(filesystem::path const& filepath) {
+  ArrayIndex index;
+  std::ifstream file(filepath.c_str(), std::ios::binary);
+  if (!file.is_open()) return index;
+  bool needs_swapping = !is_little_endian_cpu();
+  I32 n;
+  read_value(file, n, needs_swapping);
+  for (I32 i = 0; i < n; ++i) {
+    I64 hash;
+    read_value(file, hash, needs_swapping);
+    std::string dir;
+    read(file, dir, needs_swapping);
+    ArrayLocation location;
+    location.dir = dir;
+    read_value(file, location.offset, needs_swapping);
+    read_value(file, location.is_compressed, needs_swapping);
+    read_value(file, location.nbytes, needs_swapping);
+    read_value(file, location.check, needs_swapping);
+    index[hash] = location;
+  }
+  return index;
+}
+
+static bool is_sibling_relative(filesystem::path const& path) {
+  return path.string().compare(0, 3, "../") == 0;
+}
+
+static filesystem::path directory_of(filesystem::path const& path) {
+  if (path.string().find(filesystem::path::preferred_separator) ==
+      std::string::npos) {
+    return filesystem::path();
+  }
+  return path.parent_path();
+}
+
+/* re-expresses the locations of an earlier checkpoint's index relative to
+   the checkpoint being written, keeping chains of sibling directories
+   (the usual "run/step_N.osh" layout) flat and relocatable */
+static ArrayIndex rebase_index(ArrayIndex const& previous,
+    filesystem::path const& previous_path, filesystem::path const& path) {
+  filesystem::path to_previous;
+  if (directory_of(previous_path).string() == directory_of(path).string()) {
+    to_previous = filesystem::path("..") / previous_path.filename();
+  } else if (is_absolute(previous_path)) {
+    to_previous = previous_path;
+  } else {
+    to_previous = filesystem::current_path() / previous_path;
+  }
+  ArrayIndex rebased;
+  for (auto& entry : previous) {
+    auto location = entry.second;
+    if (location.dir.string() == ".") {
+      location.dir = to_previous;
+    } else if (!is_absolute(location.dir) &&
+               !(is_sibling_relative(location.dir) &&
+                   is_sibling_relative(to_previous))) {
+      location.dir = to_previous / location.dir;
+    }
+    rebased[entry.first] = location;
+  }
+  return rebased;
+}
+
+bool write_incremental(filesystem::path const& path, Mesh* mesh,
+    filesystem::path const& previous_path) {
+  begin_code("binary::write_incremental");
+  filesystem::create_directory(path);
+  mesh->comm()->barrier();
+  auto const rank = mesh->comm()->rank();
+  IncrementalWrite incremental;
+  bool is_incremental = previous_path.string().empty();
+  if (!previous_path.string().empty()) {
+    auto const nparts = read_nparts(previous_path, mesh->comm());
+    if (nparts == mesh->comm()->size()) {
+      incremental.previous =
+          rebase_index(read_index(index_filepath(previous_path, rank)),
+              previous_path, path);
+      is_incremental = true;
+    } else if (can_print(mesh)) {
+      std::cout << "binary::write_incremental: " << previous_path << " has "
+                << nparts << " parts instead of " << mesh->comm()->size()
+                << ", writing " << path << " in full\n";
+    }
+  }
+  auto filepath = path;
+  filepath /= std::to_string(rank);
+  filepath += ".osh";
+  {
+    std::ofstream file(filepath.c_str(), std::ios::binary);
+    OMEGA_H_CHECK(file.is_open());
+    write_mesh(file, mesh, &incremental);
+  }
+  write_index(index_filepath(path, rank), incremental.current);
+  write_nparts(path, mesh);
+  write_version(path, mesh);
+  mesh->comm()->barrier();
+  end_code();
+  return is_incremental;
+}
+
+/* ranks are grouped into contiguous blocks, one block per file.
+   Within an .agg file each part is prefixed by its size in bytes. */
+I32 aggregate_file_of(I32 part, I32 nparts, I32 nfiles) {
+  return I32((I64(part) * I64(nfiles)) / I64(nparts));
+}
+
+static filesystem::path aggregate_filepath(filesystem::path const& path,
+    I32 file_index, std::string const& extension) {
+  auto filepath = path;
+  filepath /= std::to_string(file_index);
+  filepath += extension;
+  return filepath;
+}
+
+I64 write_aggregated_bytes(CommPtr comm, filesystem::path const& path,
+    std::string const& extension, I32 nfiles, std::string const& bytes,
+    bool size_prefix) {
+  auto const nbytes = I64(bytes.size());
+  auto const prefix_bytes = size_prefix ? I64(sizeof(I64)) : I64(0);
+  auto const file_index = aggregate_file_of(comm->rank(), comm->size(), nfiles);
+  auto const group = comm->split(file_index, comm->rank());
+  auto const offset = group->exscan(prefix_bytes + nbytes, OMEGA_H_SUM);
+  auto const filepath = aggregate_filepath(path, file_index, extension);
+  if (group->rank() == 0) {
+    std::ofstream file(filepath.c_str(), std::ios::binary | std::ios::trunc);
+    OMEGA_H_CHECK(file.is_open());
+  }
+  group->barrier();
+  std::fstream file(
+      filepath.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+  OMEGA_H_CHECK(file.is_open());
+  file.seekp(offset);
+  if (size_prefix) write_value(file, nbytes, !is_little_endian_cpu());
+  file.write(bytes.data(), std::streamsize(nbytes));
+  OMEGA_H_CHECK(bool(file));
+  return offset + prefix_bytes;
+}
+
+void write_aggregated(filesystem::path const& path, Mesh* mesh, I32 nfiles) {
+  begin_code("binary::write_aggregated(path,Mesh,nfiles)");
+  auto const comm = mesh->comm();
+  OMEGA_H_CHECK(nfiles >= 1);
+  nfiles = min2(nfiles, comm->size());
+  filesystem::create_directory(path);
+  comm->barrier();
+  std::stringstream stream;
+  write(stream, mesh);
+  write_aggregated_bytes(comm, path, ".agg", nfiles, stream.str(), true);
+  write_int_file(path / "nfiles", mesh, nfiles);
+  write_nparts(path, mesh);
+  write_version(path, mesh);
+  comm->barrier();
+  end_code();
+}
+
+/* positions the stream at the start of a part, which is either its own
+   file or a block of an aggregated file */
+static void open_part(filesystem::path const& path, I32 version, I32 part,
+    std::ifstream& file) {
+  auto const nfiles_path = path / "nfiles";
+  std::ifstream nfiles_file(nfiles_path.c_str());
+  if (nfiles_file.is_open()) {
+    I32 nfiles;
+    nfiles_file >> nfiles;
+    std::ifstream nparts_file((path / "nparts").c_str());
+    I32 nparts;
+    nparts_file >> nparts;
+    OMEGA_H_CHECK(nfiles_file && nparts_file);
+    auto const file_index = aggregate_file_of(part, nparts, nfiles);
+    auto first_part = part;
+    while (first_part > 0 &&
+           aggregate_file_of(first_part - 1, nparts, nfiles) == file_index) {
+      --first_part;
+    }
+    auto const filepath = aggregate_filepath(path, file_index, ".agg");
+    file.open(filepath.c_str(), std::ios::binary);
+    OMEGA_H_CHECK(file.is_open());
+    auto const needs_swapping = !is_little_endian_cpu();
+    for (I32 p = first_part; p < part; ++p) {
+      I64 nbytes;
+      read_value(file, nbytes, needs_swapping);
+      file.seekg(nbytes, std::ios::cur);
+    }
+    I64 nbytes;
+    read_value(file, nbytes, needs_swapping);
+    OMEGA_H_CHECK(bool(file));
+    return;
+  }
+  auto filepath = path;
+  filepath /= std::to_string(part);
+  if (version != -1) filepath += ".osh";
+  file.open(filepath.c_str(), std::ios::binary);
+  OMEGA_H_CHECK(file.is_open());
+}
+
+static void read_part(filesystem::path const& path, Mesh* mesh, I32 version,
+    I32 part, bool is_comm_part) {
+  std::ifstream file;
+  open_part(path, version, part, file);
+  if (version >= 10) {
+    IncrementalRead incremental;
+    incremental.dir = path;
+    incremental.rank = part;
+    incremental.index = read_index(index_filepath(path, part));
+    read_mesh(file, mesh, version, &incremental, is_comm_part ? -1 : part);
+  } else {
+    read_mesh(file, mesh, version, nullptr, is_comm_part ? -1 : part);
+  }
+}
+
 void read_in_comm(
     filesystem::path const& path, CommPtr comm, Mesh* mesh, I32 version) {
   ScopedTimer timer("binary::read_in_comm(path, comm, mesh, version)");
   mesh->set_comm(comm);
-  auto filepath = path;
-  filepath /= std::to_string(mesh->comm()->rank());
-  if (version != -1) filepath += ".osh";
-  std::ifstream file(filepath.c_str(), std::ios::binary);
-  OMEGA_H_CHECK(file.is_open());
-  read(file, mesh, version);
+  read_part(path, mesh, version, comm->rank(), true);
+}
+
+template <typename T>
+static void gather_part_tag(Mesh* mesh, Int ent_dim, std::string const& name,
+    Int ncomps, std::vector<Mesh>& parts, Read<I32> src_parts,
+    LOs src_idxs) {
+  auto const nents = mesh->nents(ent_dim);
+  Write<T> out(nents * ncomps);
+  for (std::size_t p = 0; p < parts.size(); ++p) {
+    auto const part = I32(p);
+    auto const part_data = parts[p].get_array<T>(ent_dim, name);
+    auto f = OMEGA_H_LAMBDA(LO e) {
+      if (src_parts[e] != part) return;
+      for (Int c = 0; c < ncomps; ++c) {
+        out[e * ncomps + c] = part_data[src_idxs[e] * ncomps + c];
+      }
+    };
+    parallel_for(nents, f, "gather_part_tag");
+  }
+  if (mesh->has_tag(ent_dim, name)) {
+    mesh->set_tag(ent_dim, name, Read<T>(out), true);
+  } else {
+    mesh->add_tag(ent_dim, name, ncomps, Read<T>(out), true);
+  }
+}
+
+/* read_tag() stores "_rc" tags at the size of the reverse classification.
+   they are widened to all entities to be gathered, and narrowed again */
+static void change_rc_tags(Mesh* mesh, bool to_mesh) {
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    if (!mesh->nents(d)) continue;
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      auto const tag = mesh->get_tag(d, i);
+      auto const name = tag->name();
+      if (name.find("_rc") == std::string::npos) continue;
+      auto const ncomps = tag->ncomps();
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          if (to_mesh) mesh->change_tagToMesh<I8>(d, ncomps, name, LOs{});
+          else mesh->change_tagTorc<I8>(d, ncomps, name, LOs{});
+          break;
+        case OMEGA_H_I32:
+          if (to_mesh) mesh->change_tagToMesh<I32>(d, ncomps, name, LOs{});
+          else mesh->change_tagTorc<I32>(d, ncomps, name, LOs{});
+          break;
+        case OMEGA_H_I64:
+          if (to_mesh) mesh->change_tagToMesh<I64>(d, ncomps, name, LOs{});
+          else mesh->change_tagTorc<I64>(d, ncomps, name, LOs{});
+          break;
+        case OMEGA_H_F64:
+          if (to_mesh) mesh->change_tagToMesh<Real>(d, ncomps, name, LOs{});
+          else mesh->change_tagTorc<Real>(d, ncomps, name, LOs{});
+          break;
+      }
+    }
+  }
+}
+
+static ClassSets merge_class_sets(std::vector<Mesh> const& parts) {
+  ClassSets merged;
+  for (auto& part : parts) {
+    for (auto& set : part.class_sets) {
+      auto& pairs = merged[set.first];
+      pairs.insert(pairs.end(), set.second.begin(), set.second.end());
+    }
+  }
+  for (auto& set : merged) {
+    auto& pairs = set.second;
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end(),
+                    [](ClassPair const& a, ClassPair const& b) {
+                      return !(a < b) && !(b < a);
+                    }),
+        pairs.end());
+  }
+  return merged;
+}
+
+/* Each rank reads a contiguous block of the parts and keeps the elements
+   those parts own. The elements keep their vertex order, so every
+   lower-dimensional entity is matched to its source through the
+   element's downward adjacency and all tags carry over unchanged. */
+static void read_parts_merged(filesystem::path const& path, CommPtr comm,
+    Mesh* mesh, I32 nparts, I32 version) {
+  ScopedTimer timer("binary::read_parts_merged");
+  GO begin, end;
+  suggest_slices(nparts, comm->size(), comm->rank(), &begin, &end);
+  std::vector<Mesh> parts;
+  for (GO p = begin; p < end; ++p) {
+    parts.emplace_back(comm->library());
+    parts.back().set_comm(comm->library()->self());
+    read_part(path, &parts.back(), version, I32(p), false);
+    change_rc_tags(&parts.back(), true);
+    if (parts.back().has_any_parents()) {
+      Omega_h_fail(
+          "binary::read: \"%s\" has AMR parents and can't be read"
+          " on fewer ranks than parts\n",
+          path.c_str());
+    }
+  }
+  OMEGA_H_CHECK(!parts.empty());
+  auto const family = parts[0].family();
+  auto const dim = parts[0].dim();
+  auto const verts_per_elem = element_degree(family, dim, VERT);
+  std::vector<LOs> part_elems;
+  LO nelems = 0;
+  for (std::size_t p = 0; p < parts.size(); ++p) {
+    auto const owners = parts[p].ask_owners(dim);
+    part_elems.push_back(
+        collect_marked(each_eq_to(owners.ranks, I32(begin + GO(p)))));
+    nelems += part_elems.back().size();
+  }
+  HostWrite<GO> h_ev2vg(nelems * verts_per_elem);
+  HostWrite<GO> h_elem_globals(nelems);
+  {
+    LO elem = 0;
+    for (std::size_t p = 0; p < parts.size(); ++p) {
+      auto const ev2vg = HostRead<GO>(unmap(
+          unmap(part_elems[p], parts[p].ask_elem_verts(), verts_per_elem),
+          parts[p].globals(VERT), 1));
+      auto const globals =
+          HostRead<GO>(unmap(part_elems[p], parts[p].globals(dim), 1));
+      for (LO i = 0; i < part_elems[p].size(); ++i, ++elem) {
+        h_elem_globals[elem] = globals[i];
+        for (Int j = 0; j < verts_per_elem; ++j) {
+          h_ev2vg[elem * verts_per_elem + j] = ev2vg[i * verts_per_elem + j];
+        }
+      }
+    }
+  }
+  std::vector<GO> unique_globals(
+      h_ev2vg.data(), h_ev2vg.data() + h_ev2vg.size());
+  std::sort(unique_globals.begin(), unique_globals.end());
+  unique_globals.erase(std::unique(unique_globals.begin(), unique_globals.end()),
+      unique_globals.end());
+  HostWrite<LO> h_ev2v(h_ev2vg.size());
+  for (LO i = 0; i < h_ev2vg.size(); ++i) {
+    h_ev2v[i] = LO(std::lower_bound(unique_globals.begin(),
+                       unique_globals.end(), h_ev2vg[i]) -
+                   unique_globals.begin());
+  }
+  HostWrite<GO> h_vert_globals(LO(unique_globals.size()));
+  for (LO i = 0; i < h_vert_globals.size(); ++i) {
+    h_vert_globals[i] = unique_globals[std::size_t(i)];
+  }
+  auto const vert_globals = GOs(h_vert_globals.write());
+  mesh->set_comm(comm);
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  mesh->set_family(family);
+  mesh->set_dim(dim);
+  build_verts_from_globals(mesh, vert_globals);
+  build_ents_from_elems2verts(
+      mesh, LOs(h_ev2v.write()), vert_globals, GOs(h_elem_globals.write()));
+  for (Int d = 0; d <= dim; ++d) {
+    Write<I32> src_parts(mesh->nents(d), -1);
+    Write<LO> src_idxs(mesh->nents(d), -1);
+    auto const deg = element_degree(family, dim, d);
+    auto const new_down = (d == dim) ? LOs() : mesh->ask_down(dim, d).ab2b;
+    LO elem_offset = 0;
+    for (std::size_t p = 0; p < parts.size(); ++p) {
+      auto const part = I32(p);
+      auto const elems = part_elems[p];
+      auto const part_down =
+          (d == dim) ? LOs() : parts[p].ask_down(dim, d).ab2b;
+      auto f = OMEGA_H_LAMBDA(LO i) {
+        auto const elem = elem_offset + i;
+        if (d == dim) {
+          src_parts[elem] = part;
+          src_idxs[elem] = elems[i];
+          return;
+        }
+        for (Int j = 0; j < deg; ++j) {
+          auto const ent = new_down[elem * deg + j];
+          src_parts[ent] = part;
+          src_idxs[ent] = part_down[elems[i] * deg + j];
+        }
+      };
+      parallel_for(elems.size(), f, "match_part_ents");
+      elem_offset += elems.size();
+    }
+    for (Int i = 0; i < parts[0].ntags(d); ++i) {
+      auto const tag = parts[0].get_tag(d, i);
+      auto const& name = tag->name();
+      auto const ncomps = tag->ncomps();
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          gather_part_tag<I8>(mesh, d, name, ncomps, parts, src_parts, src_idxs);
+          break;
+        case OMEGA_H_I32:
+          gather_part_tag<I32>(
+              mesh, d, name, ncomps, parts, src_parts, src_idxs);
+          break;
+        case OMEGA_H_I64:
+          gather_part_tag<I64>(
+              mesh, d, name, ncomps, parts, src_parts, src_idxs);
+          break;
+        case OMEGA_H_F64:
+          gather_part_tag<Real>(
+              mesh, d, name, ncomps, parts, src_parts, src_idxs);
+          break;
+      }
+    }
+  }
+  change_rc_tags(mesh, false);
+  mesh->class_sets = merge_class_sets(parts);
+  mesh->set_rib_hints(parts[0].rib_hints());
+  if (parts[0].parting() != OMEGA_H_ELEM_BASED) {
+    mesh->set_parting(parts[0].parting(), parts[0].nghost_layers(), false);
+  }
+}
+
+/* where one array record of a checkpoint part starts, so that slices of
+   it can be read later without ever holding the whole array */
+struct ArraySource {
+  std::istream* stream;
+  I64 offset;
+  bool is_compressed;
+  LO size;
+};
+
+static ArraySource locate_entry(std::istream& stream, std::size_t elem_size,
+    bool is_compressed, I32 version, bool needs_swapping,
+    IncrementalRead* incremental) {
+  ArraySource source;
+  source.stream = &stream;
+  source.is_compressed = is_compressed;
+  I8 is_reference = 0;
+  if (version >= 10) read_value(stream, is_reference, needs_swapping);
+  if (is_reference) {
+    I64 hash;
+    read_value(stream, hash, needs_swapping);
+    ArrayLocation location;
+    auto& file = open_reference(incremental, hash, &location);
+    source.stream = &file;
+    source.offset = location.offset;
+    source.is_compressed = bool(location.is_compressed);
+    read_value(file, source.size, needs_swapping);
+    return source;
+  }
+  source.offset = I64(stream.tellg());
+  read_value(stream, source.size, needs_swapping);
+  OMEGA_H_CHECK(source.size >= 0);
+  I64 nbytes = I64(source.size) * I64(elem_size);
+#ifdef OMEGA_H_USE_ZLIB
+  if (is_compressed) read_value(stream, nbytes, needs_swapping);
+#endif
+  stream.seekg(nbytes, std::ios::cur);
+  OMEGA_H_CHECK(bool(stream));
+  return source;
+}
+
+#ifdef OMEGA_H_USE_ZLIB
+/* inflates a compressed record a chunk at a time, keeping only the nbytes
+   of output that follow its first skip bytes */
+static void inflate_range(std::istream& stream, I64 compressed_bytes,
+    std::size_t skip, std::size_t nbytes, void* data) {
+  if (nbytes == 0) return;
+  constexpr std::size_t chunk = std::size_t(1) << 16;
+  std::vector< ::Bytef> in(chunk);
+  std::vector< ::Bytef> discard(chunk);
+  auto const out = static_cast< ::Bytef*>(data);
+  ::z_stream z;
+  std::memset(&z, 0, sizeof(z));
+  OMEGA_H_CHECK(::inflateInit(&z) == Z_OK);
+  std::size_t produced = 0;
+  while (produced < skip + nbytes) {
+    if (z.avail_in == 0) {
+      OMEGA_H_CHECK(compressed_bytes > 0);
+      auto const n = std::min(std::size_t(compressed_bytes), chunk);
+      stream.read(reinterpret_cast<char*>(in.data()), std::streamsize(n));
+      OMEGA_H_CHECK(bool(stream));
+      compressed_bytes -= I64(n);
+      z.next_in = in.data();
+      z.avail_in = ::uInt(n);
+    }
+    if (produced < skip) {
+      z.next_out = discard.data();
+      z.avail_out = ::uInt(std::min(skip - produced, chunk));
+    } else {
+      z.next_out = out + (produced - skip);
+      z.avail_out = ::uInt(std::min(skip + nbytes - produced, chunk * chunk));
+    }
+    auto const avail = z.avail_out;
+    auto const ret = ::inflate(&z, Z_NO_FLUSH);
+    OMEGA_H_CHECK(ret == Z_OK || ret == Z_STREAM_END);
+    produced += avail - z.avail_out;
+    if (ret == Z_STREAM_END) break;
+  }
+  ::inflateEnd(&z);
+  OMEGA_H_CHECK(produced >= skip + nbytes);
+}
+#endif
+
+template <typename T>
+static Read<T> read_array_slice(
+    ArraySource const& source, LO begin, LO end, bool needs_swapping) {
+  auto& stream = *source.stream;
+  stream.clear();
+  stream.seekg(source.offset);
+  LO size;
+  read_value(stream, size, needs_swapping);
+  OMEGA_H_CHECK(0 <= begin && begin <= end && end <= size);
+  HostWrite<T> slice(end - begin);
+  auto const skip = std::size_t(begin) * sizeof(T);
+  auto const nbytes = std::size_t(end - begin) * sizeof(T);
+#ifdef OMEGA_H_USE_ZLIB
+  if (source.is_compressed) {
+    I64 compressed_bytes;
+    read_value(stream, compressed_bytes, needs_swapping);
+    inflate_range(stream, compressed_bytes, skip, nbytes, slice.data());
+  } else
+#endif
+  {
+    stream.seekg(std::streamoff(skip), std::ios::cur);
+    stream.read(reinterpret_cast<char*>(slice.data()), std::streamsize(nbytes));
+  }
+  OMEGA_H_CHECK(bool(stream));
+  return swap_bytes(Read<T>(slice.write()), needs_swapping);
+}
+
+static std::size_t type_size(Omega_h_Type type) {
+  switch (type) {
+    case OMEGA_H_I8:
+      return sizeof(I8);
+    case OMEGA_H_I32:
+      return sizeof(I32);
+    case OMEGA_H_I64:
+      return sizeof(I64);
+    case OMEGA_H_F64:
+      return sizeof(Real);
+  }
+  Omega_h_fail("unexpected tag type in binary read\n");
+  OMEGA_H_NORETURN(0);
+}
+
+static GOs to_globals(LOs a) {
+  Write<GO> out(a.size());
+  auto f = OMEGA_H_LAMBDA(LO i) { out[i] = a[i]; };
+  parallel_for(a.size(), f, "to_globals");
+  return out;
+}
+
+/* the rows of the entities in ids, from the ranks holding the linear
+   slices of a table of total rows */
+template <typename T>
+static Read<T> fetch_rows(
+    CommPtr comm, LOs ids, GO total, Read<T> slice_rows, Int width) {
+  auto const uses2rows = Dist(comm,
+      globals_to_linear_owners(comm, to_globals(ids), total),
+      linear_partition_size(comm, total));
+  return uses2rows.invert().exch(slice_rows, width);
+}
+
+struct TagSource {
+  std::string name;
+  Int ncomps;
+  Omega_h_Type type;
+  ArraySource source;
+};
+
+struct SlicedPart {
+  Mesh* mesh;
+  CommPtr comm;
+  bool needs_swapping;
+  std::vector<GO> nents;
+  std::vector<LOs> elem_uses;  // per element, the file ids of its entities
+  Dist slice_verts2verts;
+  Dist slice_elems2elems;
+};
+
+template <typename T>
+static void add_sliced_tag(
+    SlicedPart& part, Int ent_dim, TagSource const& tag) {
+  auto const mesh = part.mesh;
+  auto const dim = mesh->dim();
+  auto const ncomps = tag.ncomps;
+  GO begin, end;
+  suggest_slices(part.nents[std::size_t(ent_dim)], part.comm->size(),
+      part.comm->rank(), &begin, &end);
+  auto const slice = read_array_slice<T>(tag.source, LO(begin) * ncomps,
+      LO(end) * ncomps, part.needs_swapping);
+  Read<T> array;
+  if (ent_dim == VERT) {
+    array = part.slice_verts2verts.exch(slice, ncomps);
+  } else if (ent_dim == dim) {
+    array = part.slice_elems2elems.exch(slice, ncomps);
+  } else {
+    /* every entity is adjacent to one of the elements, and each of them
+       carries the values of its entities in its template order */
+    auto const deg = element_degree(mesh->family(), dim, ent_dim);
+    auto const uses = part.elem_uses[std::size_t(ent_dim)];
+    auto const use_values = fetch_rows(part.comm, uses,
+        part.nents[std::size_t(ent_dim)], slice, ncomps);
+    auto const elem_values =
+        part.slice_elems2elems.exch(use_values, deg * ncomps);
+    auto const down = mesh->ask_down(dim, ent_dim).ab2b;
+    Write<T> out(mesh->nents(ent_dim) * ncomps);
+    auto f = OMEGA_H_LAMBDA(LO elem) {
+      for (Int j = 0; j < deg; ++j) {
+        auto const ent = down[elem * deg + j];
+        for (Int c = 0; c < ncomps; ++c) {
+          out[ent * ncomps + c] = elem_values[(elem * deg + j) * ncomps + c];
+        }
+      }
+    };
+    parallel_for(mesh->nelems(), f, "scatter_sliced_tag");
+    array = out;
+  }
+  mesh->add_tag(ent_dim, tag.name, ncomps, array, true);
+  if (tag.name.find("_rc") != std::string::npos) {
+    mesh->change_tagTorc<T>(ent_dim, ncomps, tag.name, LOs{});
+  }
+}
+
+/* Each rank inflates only its linear slices of the single part's arrays.
+   Element vertices are composed from the stored downward adjacencies by
+   fetching the rows each slice uses, the elements are partitioned by
+   assemble_slices, and every tag follows its entities.  No rank holds
+   more than its share of any array. */
+Mesh read_sliced(filesystem::path const& path, CommPtr comm) {
+  ScopedTimer timer("binary::read_sliced");
+  auto const nparts = read_nparts(path, comm);
+  if (nparts != 1) {
+    Omega_h_fail("binary::read_sliced: \"%s\" has %d parts instead of one\n",
+        path.c_str(), nparts);
+  }
+  auto version = read_version(path, comm);
+  std::ifstream file;
+  open_part(path, version, 0, file);
+  IncrementalRead incremental;
+  incremental.dir = path;
+  incremental.rank = 0;
+  unsigned char magic_in[2];
+  file.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
+  OMEGA_H_CHECK(magic_in[0] == magic[0]);
+  OMEGA_H_CHECK(magic_in[1] == magic[1]);
+  bool const needs_swapping = !is_little_endian_cpu();
+  if (version == -1) read_value(file, version, needs_swapping);
+  OMEGA_H_CHECK(version >= 1);
+  OMEGA_H_CHECK(version <= latest_version);
+  if (version >= 10) incremental.index = read_index(index_filepath(path, 0));
+  I8 is_compressed;
+  read_value(file, is_compressed, needs_swapping);
+#ifndef OMEGA_H_USE_ZLIB
+  OMEGA_H_CHECK(!is_compressed);
+#endif
+  Mesh meta(comm->library());
+  auto const comm_size = read_meta(file, &meta, version, needs_swapping, 0);
+  OMEGA_H_CHECK(comm_size == 1);
+  auto const family = meta.family();
+  auto const dim = meta.dim();
+  LO nverts;
+  read_value(file, nverts, needs_swapping);
+  std::vector<ArraySource> downs(std::size_t(dim + 1));
+  std::vector<ArraySource> codes(std::size_t(dim + 1));
+  for (Int d = 1; d <= dim; ++d) {
+    downs[std::size_t(d)] = locate_entry(file, sizeof(LO), bool(is_compressed),
+        version, needs_swapping, &incremental);
+    if (d > 1) {
+      codes[std::size_t(d)] = locate_entry(file, sizeof(I8),
+          bool(is_compressed), version, needs_swapping, &incremental);
+    }
+  }
+  std::vector<std::vector<TagSource>> tags(std::size_t(dim + 1));
+  for (Int d = 0; d <= dim; ++d) {
+    Int ntags;
+    read_value(file, ntags, needs_swapping);
+    for (Int i = 0; i < ntags; ++i) {
+      TagSource tag;
+      read(file, tag.name, needs_swapping);
+      I8 ncomps;
+      read_value(file, ncomps, needs_swapping);
+      I8 type;
+      read_value(file, type, needs_swapping);
+      if (version < 5) {
+        I8 ignored;
+        read_value(file, ignored, needs_swapping);
+        if (2 <= version) read_value(file, ignored, needs_swapping);
+      }
+      tag.ncomps = ncomps;
+      tag.type = Omega_h_Type(type);
+      tag.source = locate_entry(file, type_size(tag.type),
+          bool(is_compressed), version, needs_swapping, &incremental);
+      tags[std::size_t(d)].push_back(tag);
+    }
+  }
+  if (version >= 8) read_sets(file, &meta, needs_swapping);
+  if (version >= 9) {
+    I8 has_parents;
+    read_value(file, has_parents, needs_swapping);
+    if (has_parents) {
+      Omega_h_fail(
+          "binary::read_sliced: \"%s\" has AMR parents\n", path.c_str());
+    }
+  }
+  SlicedPart part;
+  part.comm = comm;
+  part.needs_swapping = needs_swapping;
+  part.nents.push_back(nverts);
+  for (Int d = 1; d <= dim; ++d) {
+    part.nents.push_back(divide_no_remainder(
+        GO(downs[std::size_t(d)].size), GO(element_degree(family, d, d - 1))));
+  }
+  auto read_rows = [&](std::vector<ArraySource> const& sources, Int d,
+                       Int width, auto zero) {
+    using T = decltype(zero);
+    GO begin, end;
+    suggest_slices(part.nents[std::size_t(d)], comm->size(), comm->rank(),
+        &begin, &end);
+    return read_array_slice<T>(sources[std::size_t(d)], LO(begin) * width,
+        LO(end) * width, needs_swapping);
+  };
+  /* elements to the file ids of their entities of each lower dimension,
+     in the same template order the mesh derives them in */
+  part.elem_uses.resize(std::size_t(dim));
+  auto const sides_per_elem = element_degree(family, dim, dim - 1);
+  auto h2l = Adj(read_rows(downs, dim, sides_per_elem, LO()));
+  if (dim > 1) h2l.codes = read_rows(codes, dim, sides_per_elem, I8());
+  part.elem_uses[std::size_t(dim - 1)] = h2l.ab2b;
+  for (Int low = dim - 2; low >= 0; --low) {
+    auto const mid = low + 1;
+    auto const width = element_degree(family, mid, low);
+    auto const nmid = part.nents[std::size_t(mid)];
+    Adj m2l(fetch_rows(
+        comm, h2l.ab2b, nmid, read_rows(downs, mid, width, LO()), width));
+    if (mid > 1) {
+      m2l.codes = fetch_rows(
+          comm, h2l.ab2b, nmid, read_rows(codes, mid, width, I8()), width);
+    }
+    auto const uses = Adj(LOs(h2l.ab2b.size(), 0, 1), h2l.codes);
+    h2l = transit(uses, m2l, family, dim, low);
+    part.elem_uses[std::size_t(low)] = h2l.ab2b;
+  }
+  auto const slice_conn = to_globals(part.elem_uses[std::size_t(VERT)]);
+  GO elems_begin, elems_end;
+  suggest_slices(part.nents[std::size_t(dim)], comm->size(), comm->rank(),
+      &elems_begin, &elems_end);
+  GO verts_begin, verts_end;
+  suggest_slices(nverts, comm->size(), comm->rank(), &verts_begin, &verts_end);
+  auto const& vert_tags = tags[std::size_t(VERT)];
+  auto const coords_tag = std::find_if(vert_tags.begin(), vert_tags.end(),
+      [](TagSource const& tag) { return tag.name == "coordinates"; });
+  OMEGA_H_CHECK(coords_tag != vert_tags.end());
+  auto const slice_coords = read_array_slice<Real>(coords_tag->source,
+      LO(verts_begin) * dim, LO(verts_end) * dim, needs_swapping);
+  LOs conn;
+  assemble_slices(comm, family, dim, part.nents[std::size_t(dim)], elems_begin,
+      slice_conn, nverts, verts_begin, slice_coords, &part.slice_elems2elems,
+      &conn, &part.slice_verts2verts);
+  auto const vert_globals = part.slice_verts2verts.exch(
+      GOs(LO(verts_end - verts_begin), verts_begin, 1), 1);
+  auto const elem_globals = part.slice_elems2elems.exch(
+      GOs(LO(elems_end - elems_begin), elems_begin, 1), 1);
+  Mesh mesh(comm->library());
+  part.mesh = &mesh;
+  mesh.set_comm(comm);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.set_family(family);
+  mesh.set_dim(dim);
+  build_verts_from_globals(&mesh, vert_globals);
+  build_ents_from_elems2verts(&mesh, conn, vert_globals, elem_globals);
+  for (Int d = 0; d <= dim; ++d) {
+    for (auto const& tag : tags[std::size_t(d)]) {
+      // global numbers are set by the construction
+      if (tag.name == "global") continue;
+      switch (tag.type) {
+        case OMEGA_H_I8:
+          add_sliced_tag<I8>(part, d, tag);
+          break;
+        case OMEGA_H_I32:
+          add_sliced_tag<I32>(part, d, tag);
+          break;
+        case OMEGA_H_I64:
+          add_sliced_tag<I64>(part, d, tag);
+          break;
+        case OMEGA_H_F64:
+          add_sliced_tag<Real>(part, d, tag);
+          break;
+      }
+    }
+  }
+  mesh.class_sets = meta.class_sets;
+  return mesh;
 }
 
 I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh, bool strict) {
@@ -635,12 +1696,9 @@ I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh, bool strict) {
           path.c_str(), nparts, comm->size());
     }
     read_in_comm(path, comm, mesh, version);
+  } else if (nparts > comm->size()) {
+    read_parts_merged(path, comm, mesh, nparts, version);
   } else {
-    if (nparts > comm->size()) {
-      Omega_h_fail(
-          "path \"%s\" contains %d parts, but only %d ranks are reading it\n",
-          path.c_str(), nparts, comm->size());
-    }
     auto const in_subcomm = (comm->rank() < nparts);
     auto const subcomm = comm->split(I32(!in_subcomm), 0);
     if (in_subcomm) {
@@ -61,6 +61,9 @@ Mesh read_sliced(filesystem::path const& path, CommPtr comm,
 
 namespace gmsh {
 Mesh read(std::istream& stream, CommPtr comm);
+/* on more than one rank, binary MSH 4.x files are read in slices: each
+   rank reads only its byte ranges of the $Nodes and $Elements sections.
+   Other files are read on rank 0 and then balanced. */
 Mesh read(filesystem::path const& filename, CommPtr comm);
 void write(std::ostream& stream, Mesh* mesh);
 void write(filesystem::path const& filepath, Mesh* mesh);
@@ -98,10 +101,17 @@ static constexpr bool dont_compress = false;
 #endif
 TagSet get_all_vtk_tags(Mesh* mesh, Int cell_dim);
 TagSet get_all_vtk_tags_mix(Mesh* mesh, Int cell_dim);
+/* when appended is true, array payloads are written as raw bytes in a single
+   <AppendedData> block at the end of the file instead of inline base64,
+   which is smaller and much faster to write and read for large meshes.
+   the stream must then be seekable, since the offsets of the arrays are
+   filled in as their data is written */
 void write_vtu(std::ostream& stream, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS);
+    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS,
+    bool appended = false);
 void write_vtu(filesystem::path const& filename, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS);
+    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS,
+    bool appended = false);
 void write_vtu(std::string const& filename, Mesh* mesh, Int cell_dim,
     bool compress = OMEGA_H_DEFAULT_COMPRESS);
 void write_vtu(std::string const& filename, Mesh* mesh,
@@ -111,7 +121,8 @@ void write_vtu(filesystem::path const& filename, Mesh* mesh, Topo_type max_type,
     bool compress = OMEGA_H_DEFAULT_COMPRESS);
 
 void write_parallel(filesystem::path const& path, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS);
+    TagSet const& tags, bool compress = OMEGA_H_DEFAULT_COMPRESS,
+    bool appended = false);
 void write_parallel(std::string const& path, Mesh* mesh, Int cell_dim,
     bool compress = OMEGA_H_DEFAULT_COMPRESS);
 void write_parallel(std::string const& path, Mesh* mesh,
@@ -120,13 +131,71 @@ void write_parallel(std::string const& path, Mesh* mesh,
 void read_parallel(filesystem::path const& pvtupath, CommPtr comm, Mesh* mesh);
 void read_vtu(std::istream& stream, CommPtr comm, Mesh* mesh);
 
+}  // end namespace vtk
+
+namespace xdmf {
+
+/* Writes <path>/mesh.xmf, light XML metadata for one piece per rank, and
+   the heavy data as raw little-endian binary in <path>/<k>.bin.  With
+   nfiles = -1 every rank writes its own file; otherwise ranks are grouped
+   into nfiles files and each piece is located by a byte offset. */
+void write(filesystem::path const& path, Mesh* mesh, Int cell_dim,
+    TagSet const& tags, I32 nfiles = -1);
+void write(filesystem::path const& path, Mesh* mesh, Int cell_dim = -1,
+    I32 nfiles = -1);
+
+/* Writes a time series as an XDMF temporal collection, <root>/steps.xmf,
+   whose heavy data are raw binary files with one file per rank.
+   Coordinates and connectivity live in <root>/geometry_<n>/ and are only
+   written again when the mesh arrays change, so steps on a fixed mesh
+   only cost their field data in <root>/steps/step_<i>/. */
+class Writer {
+  Mesh* mesh_;
+  filesystem::path root_path_;
+  Int cell_dim_;
+  I64 step_;
+  I64 geometry_;
+  Reals coords_;
+  LOs verts_;
+  Read<LO> piece_nverts_;
+  Read<LO> piece_nelems_;
+  std::streampos xmf_pos_;
+  bool geometry_changed() const;
+  void write_geometry();
+
+ public:
+  Writer();
+  Writer(Writer const&) = default;
+  Writer& operator=(Writer const&) = default;
+  ~Writer() = default;
+  /* steps already in root_path at or after restart_time are dropped */
+  Writer(filesystem::path const& root_path, Mesh* mesh, Int cell_dim = -1,
+      Real restart_time = 0.0);
+  void write();
+  void write(Real time);
+  void write(Real time, TagSet const& tags);
+  void write(I64 step, Real time, TagSet const& tags);
+};
+
+}  // end namespace xdmf
+
+namespace vtk {
+
+/* With share_geometry, steps are written through an xdmf::Writer rooted at
+   root_path instead of as a pvd collection of full .pvtu steps, so the
+   geometry is written once per mesh change instead of once per step.
+   Otherwise, appended selects raw appended data in the .vtu pieces
+   (see write_vtu()). */
 class Writer {
   Mesh* mesh_;
   filesystem::path root_path_;
   Int cell_dim_;
   bool compress_;
+  bool share_geometry_;
+  bool appended_;
   I64 step_;
   std::streampos pvd_pos_;
+  xdmf::Writer xdmf_;
 
  public:
   Writer();
@@ -134,7 +203,8 @@ class Writer {
   Writer& operator=(Writer const&) = default;
   ~Writer() = default;
   Writer(filesystem::path const& root_path, Mesh* mesh, Int cell_dim = -1,
-      Real restart_time = 0.0, bool compress = OMEGA_H_DEFAULT_COMPRESS);
+      Real restart_time = 0.0, bool compress = OMEGA_H_DEFAULT_COMPRESS,
+      bool share_geometry = false, bool appended = false);
   void write();
   void write(Real time);
   void write(Real time, TagSet const& tags);
@@ -155,16 +225,45 @@ class FullWriter {
 namespace binary {
 
 void write(filesystem::path const& path, Mesh* mesh);
+/**
+ * Write a checkpoint that only stores arrays whose contents are not already
+ * in \p previous_path (an earlier write_incremental output, or empty to
+ * start a chain). Unchanged arrays are recorded as references into the
+ * earlier checkpoint directories, which must be kept alongside this one.
+ * binary::read resolves the references transparently.
+ * Returns false if \p previous_path has a different number of parts,
+ * in which case every array is written in full.
+ */
+bool write_incremental(filesystem::path const& path, Mesh* mesh,
+    filesystem::path const& previous_path);
+/**
+ * Write a checkpoint whose parts are packed into \p nfiles files
+ * (each holding a contiguous block of ranks) instead of one file per rank.
+ */
+void write_aggregated(filesystem::path const& path, Mesh* mesh, I32 nfiles);
+/**
+ * Read a checkpoint written on any number of ranks. When it has more
+ * parts than \p comm has ranks (and \p strict is false), each rank reads
+ * a contiguous block of parts and they are merged using global numbers;
+ * callers will usually follow with Mesh::balance().
+ */
 Mesh read(filesystem::path const& path, Library* lib, bool strict = false);
 Mesh read(filesystem::path const& path, CommPtr comm, bool strict = false);
 I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh,
     bool strict = false);
+/**
+ * Read a single-part checkpoint (such as one written in serial) onto all
+ * ranks of \p comm without any rank holding the whole mesh: each rank
+ * inflates only its slices of the arrays and the elements are partitioned
+ * with recursive inertial bisection, as in assemble_slices().
+ */
+Mesh read_sliced(filesystem::path const& path, CommPtr comm);
 I32 read_nparts(filesystem::path const& path, CommPtr comm);
 I32 read_version(filesystem::path const& path, CommPtr comm);
 void read_in_comm(
     filesystem::path const& path, CommPtr comm, Mesh* mesh, I32 version);
 
-constexpr I32 latest_version = 9;
+constexpr I32 latest_version = 10;
 
 template <typename T>
 void swap_bytes(T&);
@@ -189,6 +288,17 @@ void read(std::istream& stream, std::string& val, bool needs_swapping);
 void write(std::ostream& stream, Mesh* mesh);
 void read(std::istream& stream, Mesh* mesh, I32 version);
 
+/* the file that holds (part) when (nparts) parts are packed into
+   (nfiles) files, each holding a contiguous block of parts */
+I32 aggregate_file_of(I32 part, I32 nparts, I32 nfiles);
+/* writes this rank's (bytes) into path/<file><extension>, the file its
+   block of ranks shares, after the bytes of the lower ranks of that block.
+   with size_prefix they are preceded by their size as an I64.
+   returns the offset of the bytes in that file */
+I64 write_aggregated_bytes(CommPtr comm, filesystem::path const& path,
+    std::string const& extension, I32 nfiles, std::string const& bytes,
+    bool size_prefix);
+
 #define INST_DECL(T)                                                           \
   extern template void swap_bytes(T&);                                         \
   extern template Read<T> swap_bytes(Read<T> array, bool needs_swapping);      \
@@ -2,8 +2,11 @@
 
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_migrate.hpp"
+#include "Omega_h_owners.hpp"
+#include "Omega_h_unmap_mesh.hpp"
 
 namespace Omega_h {
 
@@ -140,4 +143,75 @@ void partition_by_elems(Mesh* mesh, bool verbose) {
   migrate_mesh(mesh, dist, OMEGA_H_ELEM_BASED, verbose);
 }
 
+/* the owner rank of each entity kept by unghost_mesh(): its current
+ * owner if that rank keeps it too, otherwise the lowest rank that does */
+static Read<I32> get_kept_own_ranks(Mesh* mesh, Int ent_dim, Read<I8> kept) {
+  auto rank = mesh->comm()->rank();
+  auto copies2owners = mesh->ask_dist(ent_dim);
+  auto owners2copies = copies2owners.invert();
+  auto serv_copies2kept = copies2owners.exch(kept, 1);
+  auto serv_copies2clients = owners2copies.items2msgs();
+  auto owners2serv_copies = owners2copies.roots2items();
+  auto clients2ranks = owners2copies.msgs2ranks();
+  auto nowners = owners2copies.nroots();
+  Write<I32> owners2own_ranks(nowners);
+  auto f = OMEGA_H_LAMBDA(LO owner) {
+    I32 own_rank = -1;
+    for (auto serv_copy = owners2serv_copies[owner];
+         serv_copy < owners2serv_copies[owner + 1]; ++serv_copy) {
+      if (!serv_copies2kept[serv_copy]) continue;
+      auto client_rank = clients2ranks[serv_copies2clients[serv_copy]];
+      if (client_rank == rank) {
+        own_rank = rank;
+        break;
+      }
+      if (own_rank == -1 || client_rank < own_rank) own_rank = client_rank;
+    }
+    owners2own_ranks[owner] = own_rank;
+  };
+  parallel_for(nowners, f, "get_kept_own_ranks");
+  return owners2copies.exch(Read<I32>(owners2own_ranks), 1);
+}
+
+void unghost_mesh(Mesh* mesh) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(!mesh->has_any_parents());
+  auto comm = mesh->comm();
+  auto dim = mesh->dim();
+  auto elems_are_kept = mesh->owned(dim);
+  Mesh new_mesh(mesh->library());
+  new_mesh.set_comm(comm);
+  new_mesh.set_family(mesh->family());
+  new_mesh.set_dim(dim);
+  new_mesh.set_parting(OMEGA_H_ELEM_BASED);
+  new_mesh.set_rib_hints(mesh->rib_hints());
+  new_mesh.class_sets = mesh->class_sets;
+  LOs old_lows2new_lows;
+  for (Int ent_dim = VERT; ent_dim <= dim; ++ent_dim) {
+    auto kept =
+        (ent_dim == dim)
+            ? elems_are_kept
+            : mark_down(mesh->ask_up(ent_dim, dim), elems_are_kept);
+    auto new_ents2old_ents = collect_marked(kept);
+    if (ent_dim == VERT) {
+      new_mesh.set_verts(new_ents2old_ents.size());
+    } else {
+      unmap_down(
+          mesh, &new_mesh, ent_dim, new_ents2old_ents, old_lows2new_lows);
+    }
+    unmap_tags(mesh, &new_mesh, ent_dim, new_ents2old_ents);
+    auto own_ranks = get_kept_own_ranks(mesh, ent_dim, kept);
+    auto new_ents2old_owners =
+        Dist(comm, unmap(new_ents2old_ents, mesh->ask_owners(ent_dim)),
+            mesh->nents(ent_dim));
+    new_mesh.set_owners(ent_dim,
+        update_ownership(
+            new_ents2old_owners, unmap(new_ents2old_ents, own_ranks, 1)));
+    old_lows2new_lows =
+        invert_injective_map(new_ents2old_ents, mesh->nents(ent_dim));
+  }
+  *mesh = new_mesh;
+}
+
 }  // end namespace Omega_h
@@ -28,6 +28,13 @@ void ghost_mesh(Mesh* mesh, Int nlayers, bool verbose);
 void partition_by_verts(Mesh* mesh, bool verbose);
 void partition_by_elems(Mesh* mesh, bool verbose);
 
+/* goes from ghosted to element-based partitioning without migration:
+ * each rank keeps its owned elements and their closure, which are all
+ * local already, and only entity ownership is communicated. entities
+ * stay owned by their current owner if it keeps them, unlike
+ * partition_by_elems(), which chooses owners anew */
+void unghost_mesh(Mesh* mesh);
+
 }  // end namespace Omega_h
 
 #endif
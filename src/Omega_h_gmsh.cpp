@@ -1,18 +1,28 @@
 #include "Omega_h_file.hpp"
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
-#include <cctype>
 #include <sstream>
 #include <unordered_map>
 
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_class.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_vector.hpp"
 
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #ifdef OMEGA_H_USE_GMSH
 #include <gmsh.h>
 #endif  // OMEGA_H_USE_GMSH
@@ -96,24 +106,139 @@ Int gmsh_type(Omega_h_Family family, Int dim) {
   return -1;
 }
 
-void seek_line(std::istream& stream, std::string const& want) {
-  OMEGA_H_CHECK(stream);
-  std::string line;
-  while (std::getline(stream, line)) {
-    if (line == want) {
-      break;
+/* The whole file is read into memory once and parsed in place: extracting
+   every value through std::istream is what dominates import time for large
+   meshes.  Values are parsed as text or as raw binary depending on the
+   mode declared in $MeshFormat, with the same semantics as the stream
+   extraction operators they replace. */
+class Cursor {
+ public:
+  explicit Cursor(std::string&& buffer)
+      : buffer_(std::move(buffer)),
+        pos_(0),
+        is_binary_(false),
+        needs_swapping_(false) {}
+  void set_binary(bool is_binary, bool needs_swapping) {
+    is_binary_ = is_binary;
+    needs_swapping_ = needs_swapping;
+  }
+  bool is_binary() const { return is_binary_; }
+  bool needs_swapping() const { return needs_swapping_; }
+  std::size_t pos() const { return pos_; }
+  void seek(std::size_t pos) { pos_ = pos; }
+  char const* data() const { return buffer_.data(); }
+  std::size_t size() const { return buffer_.size(); }
+  /* same contract as std::getline: false only if nothing is left */
+  bool getline(std::string& line) {
+    if (pos_ >= buffer_.size()) return false;
+    auto end = buffer_.find('\n', pos_);
+    if (end == std::string::npos) end = buffer_.size();
+    line.assign(buffer_, pos_, end - pos_);
+    pos_ = std::min(end + 1, buffer_.size());
+    return true;
+  }
+  void eat_newlines() {
+    while (pos_ < buffer_.size() && buffer_[pos_] == '\n') ++pos_;
+  }
+  std::string word() {
+    skip_space();
+    auto const start = pos_;
+    while (pos_ < buffer_.size() && !is_space(buffer_[pos_])) ++pos_;
+    return buffer_.substr(start, pos_ - start);
+  }
+  template <class T>
+  void read(T& value) {
+    if (is_binary_) {
+      read_binary(value);
+    } else {
+      read_text(value);
+    }
+  }
+  template <class T>
+  void read_binary(T& value) {
+    if (pos_ + sizeof(T) > buffer_.size()) {
+      Omega_h_fail("gmsh: unexpected end of binary data\n");
+    }
+    value = load<T>(buffer_.data() + pos_, needs_swapping_);
+    pos_ += sizeof(T);
+  }
+  void read_text(int& value) {
+    skip_space();
+    auto p = buffer_.data() + pos_;
+    auto const end = buffer_.data() + buffer_.size();
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+    if (p == end || !is_digit(*p)) {
+      Omega_h_fail("gmsh: expected an integer at byte %zu\n", pos_);
+    }
+    long long result = 0;
+    for (; p != end && is_digit(*p); ++p) result = result * 10 + (*p - '0');
+    value = int(negative ? -result : result);
+    pos_ = std::size_t(p - buffer_.data());
+  }
+  void read_text(double& value) {
+    auto const start = buffer_.c_str() + pos_;
+    char* end;
+    value = std::strtod(start, &end);
+    if (end == start) {
+      Omega_h_fail("gmsh: expected a number at byte %zu\n", pos_);
     }
+    pos_ += std::size_t(end - start);
   }
-  OMEGA_H_CHECK(stream);
+  template <class T>
+  static T load(char const* p, bool needs_swapping) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    if (needs_swapping) binary::swap_bytes(value);
+    return value;
+  }
+
+ private:
+  static bool is_space(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+  }
+  static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+  void skip_space() {
+    while (pos_ < buffer_.size() && is_space(buffer_[pos_])) ++pos_;
+  }
+  std::string buffer_;
+  std::size_t pos_;
+  bool is_binary_;
+  bool needs_swapping_;
+};
+
+std::string read_whole_stream(std::istream& stream) {
+  std::string buffer;
+  auto const start = stream.tellg();
+  if (start != std::streampos(-1)) {
+    stream.seekg(0, std::ios::end);
+    auto const end = stream.tellg();
+    stream.seekg(start);
+    if (end != std::streampos(-1)) {
+      buffer.resize(std::size_t(end - start));
+      stream.read(&buffer[0], std::streamsize(buffer.size()));
+      buffer.resize(std::size_t(stream.gcount()));
+      return buffer;
+    }
+  }
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
 }
 
-static bool seek_optional_section(
-    std::istream& stream, std::string const& want) {
-  OMEGA_H_CHECK(stream);
+void seek_line(Cursor& cursor, std::string const& want) {
   std::string line;
-  auto const pos = stream.tellg();
+  while (cursor.getline(line)) {
+    if (line == want) return;
+  }
+  Omega_h_fail("gmsh: couldn't find \"%s\"\n", want.c_str());
+}
+
+static bool seek_optional_section(Cursor& cursor, std::string const& want) {
+  std::string line;
+  auto const pos = cursor.pos();
   bool found = false;
-  while (std::getline(stream, line)) {
+  while (cursor.getline(line)) {
     if (line == want) {
       found = true;
       break;
@@ -123,54 +248,79 @@ static bool seek_optional_section(
       break;
     }
   }
-  if (!found) {
-    stream.clear();
-    stream.seekg(pos);
-  }
-  OMEGA_H_CHECK(stream);
+  if (!found) cursor.seek(pos);
   return found;
 }
 
-static void eat_newlines(std::istream& stream) {
-  while (stream.peek() == int('\n')) stream.get();
-}
-
-template <class T>
-static void read(
-    std::istream& stream, T& value, bool is_binary, bool needs_swapping) {
-  if (is_binary) {
-    binary::read_value(stream, value, needs_swapping);
-  } else {
-    stream >> value;
+/* Node numbers are usually a dense range, so a vector indexed by
+   (number - min) replaces the ordered map; sparse numberings fall back
+   to a hash table.  As with the map, a repeated number keeps its last
+   position. */
+class NodeNumbering {
+ public:
+  explicit NodeNumbering(std::vector<int> const& numbers) : min_(0) {
+    if (numbers.empty()) return;
+    auto const range = std::minmax_element(numbers.begin(), numbers.end());
+    min_ = *range.first;
+    auto const span = std::size_t(I64(*range.second) - I64(min_)) + 1;
+    if (span <= 2 * numbers.size() + 1024) {
+      dense_.assign(span, -1);
+      for (std::size_t i = 0; i < numbers.size(); ++i) {
+        dense_[std::size_t(numbers[i] - min_)] = int(i);
+      }
+    } else {
+      sparse_.reserve(numbers.size());
+      for (std::size_t i = 0; i < numbers.size(); ++i) {
+        sparse_[numbers[i]] = int(i);
+      }
+    }
+  }
+  int operator()(int number) const {
+    int position = -1;
+    if (!dense_.empty()) {
+      auto const offset = I64(number) - I64(min_);
+      if (0 <= offset && offset < I64(dense_.size())) {
+        position = dense_[std::size_t(offset)];
+      }
+    } else {
+      auto const it = sparse_.find(number);
+      if (it != sparse_.end()) position = it->second;
+    }
+    OMEGA_H_CHECK(position != -1);
+    return position;
   }
-}
+
+ private:
+  int min_;
+  std::vector<int> dense_;
+  std::unordered_map<int, int> sparse_;
+};
 
 static void read_internal_entities_section(Mesh& mesh, Real format,
-    std::vector<std::string>& physical_names, std::istream& stream,
-    bool is_binary, bool needs_swapping) {
+    std::vector<std::string>& physical_names, Cursor& cursor) {
   Int num_points, num_curves, num_surfaces, num_volumes;
-  read(stream, num_points, is_binary, needs_swapping);
-  read(stream, num_curves, is_binary, needs_swapping);
-  read(stream, num_surfaces, is_binary, needs_swapping);
-  read(stream, num_volumes, is_binary, needs_swapping);
+  cursor.read(num_points);
+  cursor.read(num_curves);
+  cursor.read(num_surfaces);
+  cursor.read(num_volumes);
   while (num_points-- > 0) {
     Int tag;
     Vector<3> point;
     Int num_physicals;
-    read(stream, tag, is_binary, needs_swapping);
-    read(stream, point[0], is_binary, needs_swapping);
-    read(stream, point[1], is_binary, needs_swapping);
-    read(stream, point[2], is_binary, needs_swapping);
+    cursor.read(tag);
+    cursor.read(point[0]);
+    cursor.read(point[1]);
+    cursor.read(point[2]);
     if (format == 4.0) {
       // strangely, the point is specified twice in 4.0, not 4.1
-      read(stream, point[0], is_binary, needs_swapping);
-      read(stream, point[1], is_binary, needs_swapping);
-      read(stream, point[2], is_binary, needs_swapping);
+      cursor.read(point[0]);
+      cursor.read(point[1]);
+      cursor.read(point[2]);
     }
-    read(stream, num_physicals, is_binary, needs_swapping);
+    cursor.read(num_physicals);
     while (num_physicals-- > 0) {
       Int physical;
-      read(stream, physical, is_binary, needs_swapping);
+      cursor.read(physical);
       OMEGA_H_CHECK(physical != 0);
       if (physical > 0) {
         const auto& physicalname = physical_names[physical - 1];
@@ -187,17 +337,17 @@ static void read_internal_entities_section(Mesh& mesh, Real format,
       Int tag;
       Vector<3> min_point, max_point;
       Int num_physicals;
-      read(stream, tag, is_binary, needs_swapping);
-      read(stream, min_point[0], is_binary, needs_swapping);
-      read(stream, min_point[1], is_binary, needs_swapping);
-      read(stream, min_point[2], is_binary, needs_swapping);
-      read(stream, max_point[0], is_binary, needs_swapping);
-      read(stream, max_point[1], is_binary, needs_swapping);
-      read(stream, max_point[2], is_binary, needs_swapping);
-      read(stream, num_physicals, is_binary, needs_swapping);
+      cursor.read(tag);
+      cursor.read(min_point[0]);
+      cursor.read(min_point[1]);
+      cursor.read(min_point[2]);
+      cursor.read(max_point[0]);
+      cursor.read(max_point[1]);
+      cursor.read(max_point[2]);
+      cursor.read(num_physicals);
       while (num_physicals-- > 0) {
         Int physical;
-        read(stream, physical, is_binary, needs_swapping);
+        cursor.read(physical);
         OMEGA_H_CHECK(physical != 0);
         if (physical > 0) {
           const auto& physical_name = physical_names[physical - 1];
@@ -205,206 +355,286 @@ static void read_internal_entities_section(Mesh& mesh, Real format,
         }
       }
       Int num_bounding_points;
-      read(stream, num_bounding_points, is_binary, needs_swapping);
+      cursor.read(num_bounding_points);
       while (num_bounding_points-- > 0) {
         Int points_tag;
-        read(stream, points_tag, is_binary, needs_swapping);
+        cursor.read(points_tag);
       }
     }
   }
 }
 
-void read_internal(std::istream& stream, Mesh* mesh) {
-  seek_line(stream, "$MeshFormat");
+/* binary node and element blocks have a fixed size once their header is
+   known, so their records are decoded independently in parallel */
+static void read_binary_nodes(Cursor& cursor, int num_block_nodes,
+    bool tags_first, std::vector<int>& node_numbers,
+    std::vector<Real>& node_coords) {
+  auto const first = node_numbers.size();
+  auto const n = std::size_t(num_block_nodes);
+  auto const record = tags_first ? 3 * sizeof(Real)
+                                 : sizeof(int) + 3 * sizeof(Real);
+  auto const nbytes = tags_first ? n * (sizeof(int) + record) : n * record;
+  if (cursor.pos() + nbytes > cursor.size()) {
+    Omega_h_fail("gmsh: unexpected end of binary data\n");
+  }
+  node_numbers.resize(first + n);
+  node_coords.resize((first + n) * 3);
+  auto const tags = cursor.data() + cursor.pos();
+  auto const coords = tags_first ? tags + n * sizeof(int) : tags;
+  auto const swap = cursor.needs_swapping();
+  auto const ni = static_cast<std::ptrdiff_t>(n);
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (std::ptrdiff_t i = 0; i < ni; ++i) {
+    auto const k = std::size_t(i);
+    char const* p = tags_first ? coords + k * record : tags + k * record;
+    if (tags_first) {
+      node_numbers[first + k] =
+          Cursor::load<int>(tags + k * sizeof(int), swap);
+    } else {
+      node_numbers[first + k] = Cursor::load<int>(p, swap);
+      p += sizeof(int);
+    }
+    for (std::size_t j = 0; j < 3; ++j) {
+      node_coords[(first + k) * 3 + j] =
+          Cursor::load<Real>(p + j * sizeof(Real), swap);
+    }
+  }
+  cursor.seek(cursor.pos() + nbytes);
+}
+
+static void read_binary_elements(Cursor& cursor, int num_block_ents,
+    int nodes_per_ent, NodeNumbering const& numbering, std::vector<int>& nodes) {
+  auto const first = nodes.size();
+  auto const n = std::size_t(num_block_ents);
+  auto const nodes_per = std::size_t(nodes_per_ent);
+  auto const record = (1 + nodes_per) * sizeof(int);
+  if (cursor.pos() + n * record > cursor.size()) {
+    Omega_h_fail("gmsh: unexpected end of binary data\n");
+  }
+  nodes.resize(first + n * nodes_per);
+  auto const base = cursor.data() + cursor.pos();
+  auto const swap = cursor.needs_swapping();
+  auto const ni = static_cast<std::ptrdiff_t>(n);
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (std::ptrdiff_t i = 0; i < ni; ++i) {
+    auto const k = std::size_t(i);
+    auto const p = base + k * record + sizeof(int);
+    for (std::size_t j = 0; j < nodes_per; ++j) {
+      auto const number = Cursor::load<int>(p + j * sizeof(int), swap);
+      nodes[first + k * nodes_per + j] = numbering(number);
+    }
+  }
+  cursor.seek(cursor.pos() + n * record);
+}
+
+/* everything before $Nodes: the format, and the physical groups of the
+   geometric entities, which go into mesh->class_sets */
+Real read_header(Cursor& cursor, Mesh* mesh,
+    std::vector<std::string>& physical_names) {
+  seek_line(cursor, "$MeshFormat");
   Real format;
   Int file_type;
   Int data_size;
-  stream >> format >> file_type >> data_size;
+  cursor.read_text(format);
+  cursor.read_text(file_type);
+  cursor.read_text(data_size);
   OMEGA_H_CHECK(file_type == 0 || file_type == 1);
   bool is_binary = (file_type == 1);
   bool needs_swapping = false;
   if (is_binary) {
-    eat_newlines(stream);
+    cursor.eat_newlines();
     int one;
-    binary::read_value(stream, one, false);
+    cursor.read_binary(one);
     if (one != 1) {
       needs_swapping = true;
       binary::swap_bytes(one);
       OMEGA_H_CHECK(one == 1);
     }
   }
+  cursor.set_binary(is_binary, needs_swapping);
   OMEGA_H_CHECK(data_size == sizeof(Real));
-  std::vector<std::string> physical_names;
-  if (seek_optional_section(stream, "$PhysicalNames")) {
+  /* $PhysicalNames is text even in binary files */
+  if (seek_optional_section(cursor, "$PhysicalNames")) {
     Int num_physicals;
-    read(stream, num_physicals, is_binary, needs_swapping);
+    cursor.read_text(num_physicals);
     physical_names.reserve(static_cast<std::size_t>(num_physicals));
-    eat_newlines(stream);
+    cursor.eat_newlines();
     for (auto i = 0; i < num_physicals; ++i) {
       Int dim, number;
-      read(stream, dim, is_binary, needs_swapping);
-      read(stream, number, is_binary, needs_swapping);
+      cursor.read_text(dim);
+      cursor.read_text(number);
       OMEGA_H_CHECK(number == i + 1);
-      std::string name;
-      stream >> name;
+      auto const name = cursor.word();
       physical_names.push_back(name.substr(1, name.size() - 2));
     }
   }
-  if (seek_optional_section(stream, "$Entities")) {
-    read_internal_entities_section(
-        *mesh, format, physical_names, stream, is_binary, needs_swapping);
+  if (seek_optional_section(cursor, "$Entities")) {
+    read_internal_entities_section(*mesh, format, physical_names, cursor);
     std::string line;
-    std::getline(stream, line);
+    cursor.getline(line);
     // line matches "[ ]*"
     if (!line.empty()) {
       line.erase(std::remove_if(line.begin(), line.end(),
           [](unsigned char c) { return std::isspace(c); }));
     }
     OMEGA_H_CHECK(line.empty());
-    std::getline(stream, line);
+    cursor.getline(line);
     OMEGA_H_CHECK(line == "$EndEntities");
   }
-  seek_line(stream, "$Nodes");
-  std::vector<Vector<3>> node_coords;
-  std::map<int, int> node_number_map;
+  return format;
+}
+
+void read_internal(Cursor& cursor, Mesh* mesh) {
+  std::vector<std::string> physical_names;
+  auto const format = read_header(cursor, mesh, physical_names);
+  bool const is_binary = cursor.is_binary();
+  seek_line(cursor, "$Nodes");
+  std::vector<Real> node_coords;
+  std::vector<int> node_numbers;
   int nnodes;
   if (format >= 4.0) {
-    eat_newlines(stream);
+    cursor.eat_newlines();
     int num_entity_blocks;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, nnodes, is_binary, needs_swapping);
-    node_coords.reserve(std::size_t(nnodes));
+    cursor.read(num_entity_blocks);
+    cursor.read(nnodes);
+    node_coords.reserve(std::size_t(nnodes) * 3);
+    node_numbers.reserve(std::size_t(nnodes));
     if (format >= 4.1) {
       int node_tag;
-      read(stream, node_tag, is_binary, needs_swapping);  // min
-      read(stream, node_tag, is_binary, needs_swapping);  // max
-      for (int entity_block = 0; entity_block < num_entity_blocks;
-           ++entity_block) {
-        int class_id, class_dim;
-        read(stream, class_dim, is_binary, needs_swapping);
-        read(stream, class_id, is_binary, needs_swapping);
-        int node_type, num_block_nodes;
-        read(stream, node_type, is_binary, needs_swapping);
-        read(stream, num_block_nodes, is_binary, needs_swapping);
+      cursor.read(node_tag);  // min
+      cursor.read(node_tag);  // max
+    }
+    for (int entity_block = 0; entity_block < num_entity_blocks;
+         ++entity_block) {
+      int class_id, class_dim;
+      if (format >= 4.1) {
+        cursor.read(class_dim);
+        cursor.read(class_id);
+      } else {
+        cursor.read(class_id);
+        cursor.read(class_dim);
+      }
+      int node_type, num_block_nodes;
+      cursor.read(node_type);
+      cursor.read(num_block_nodes);
+      if (is_binary) {
+        read_binary_nodes(cursor, num_block_nodes, format >= 4.1,
+            node_numbers, node_coords);
+      } else if (format >= 4.1) {
         for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
           int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          const auto position = int(node_coords.size() + block_node);
-          node_number_map[node_number] = position;
+          cursor.read(node_number);
+          node_numbers.push_back(node_number);
         }
         for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
-          Vector<3> coords;
-          read(stream, coords[0], is_binary, needs_swapping);
-          read(stream, coords[1], is_binary, needs_swapping);
-          read(stream, coords[2], is_binary, needs_swapping);
-          node_coords.push_back(coords);
+          for (Int j = 0; j < 3; ++j) {
+            Real x;
+            cursor.read(x);
+            node_coords.push_back(x);
+          }
         }
-      }
-
-    } else {
-      for (int entity_block = 0; entity_block < num_entity_blocks;
-           ++entity_block) {
-        int class_id, class_dim;
-        read(stream, class_id, is_binary, needs_swapping);
-        read(stream, class_dim, is_binary, needs_swapping);
-        int node_type, num_block_nodes;
-        read(stream, node_type, is_binary, needs_swapping);
-        read(stream, num_block_nodes, is_binary, needs_swapping);
+      } else {
         for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
           int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          node_number_map[node_number] = int(node_coords.size());
-          Vector<3> coords;
-          read(stream, coords[0], is_binary, needs_swapping);
-          read(stream, coords[1], is_binary, needs_swapping);
-          read(stream, coords[2], is_binary, needs_swapping);
-          node_coords.push_back(coords);
+          cursor.read(node_number);
+          node_numbers.push_back(node_number);
+          for (Int j = 0; j < 3; ++j) {
+            Real x;
+            cursor.read(x);
+            node_coords.push_back(x);
+          }
         }
       }
     }
   } else {
-    stream >> nnodes;
+    cursor.read_text(nnodes);
     OMEGA_H_CHECK(nnodes >= 0);
-    node_coords.reserve(std::size_t(nnodes));
-    eat_newlines(stream);
+    node_coords.reserve(std::size_t(nnodes) * 3);
+    cursor.eat_newlines();
     for (LO i = 0; i < nnodes; ++i) {
       LO number;
-      read(stream, number, is_binary, needs_swapping);
+      cursor.read(number);
       // the documentation says numbers don't have to be linear,
       // but so far they have been and assuming they are saves
       // me a big lookup structure (e.g. std::map)
       OMEGA_H_CHECK(number == i + 1);
-      Vector<3> coords;
-      read(stream, coords[0], is_binary, needs_swapping);
-      read(stream, coords[1], is_binary, needs_swapping);
-      read(stream, coords[2], is_binary, needs_swapping);
-      node_coords.push_back(coords);
+      for (Int j = 0; j < 3; ++j) {
+        Real x;
+        cursor.read(x);
+        node_coords.push_back(x);
+      }
     }
   }
-  seek_line(stream, "$Elements");
+  seek_line(cursor, "$Elements");
   std::array<std::vector<int>, 4> ent_class_ids;
   std::array<std::vector<int>, 4> ent_nodes;
   Omega_h_Family family = OMEGA_H_SIMPLEX;
   if (format >= 4.0) {
-    eat_newlines(stream);
+    NodeNumbering const numbering(node_numbers);
+    cursor.eat_newlines();
     int num_entity_blocks, total_num_ents;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, total_num_ents, is_binary, needs_swapping);
+    cursor.read(num_entity_blocks);
+    cursor.read(total_num_ents);
     if (format >= 4.1) {
       int element_tag;
-      read(stream, element_tag, is_binary, needs_swapping);  // min
-      read(stream, element_tag, is_binary, needs_swapping);  // max
+      cursor.read(element_tag);  // min
+      cursor.read(element_tag);  // max
     }
     for (int entity_block = 0; entity_block < num_entity_blocks;
          ++entity_block) {
       int class_id, class_dim;
       if (format == 4.) {
-        read(stream, class_id, is_binary, needs_swapping);
-        read(stream, class_dim, is_binary, needs_swapping);
+        cursor.read(class_id);
+        cursor.read(class_dim);
       } else {
-        read(stream, class_dim, is_binary, needs_swapping);
-        read(stream, class_id, is_binary, needs_swapping);
+        cursor.read(class_dim);
+        cursor.read(class_id);
       }
       int ent_type, num_block_ents;
-      read(stream, ent_type, is_binary, needs_swapping);
-      read(stream, num_block_ents, is_binary, needs_swapping);
+      cursor.read(ent_type);
+      cursor.read(num_block_ents);
       Int dim = type_dim(ent_type);
       OMEGA_H_CHECK(dim == class_dim);
       if (type_family(ent_type) == OMEGA_H_HYPERCUBE) {
         family = OMEGA_H_HYPERCUBE;
       }
       int nodes_per_ent = element_degree(family, dim, 0);
-      ent_class_ids[dim].reserve(
-          ent_class_ids[dim].size() + std::size_t(num_block_ents));
+      ent_class_ids[dim].resize(
+          ent_class_ids[dim].size() + std::size_t(num_block_ents), class_id);
+      if (is_binary) {
+        read_binary_elements(
+            cursor, num_block_ents, nodes_per_ent, numbering, ent_nodes[dim]);
+        continue;
+      }
       ent_nodes[dim].reserve(
           ent_nodes[dim].size() + std::size_t(num_block_ents * nodes_per_ent));
       for (int block_ent = 0; block_ent < num_block_ents; ++block_ent) {
-        ent_class_ids[dim].push_back(class_id);
         int ent_number;
-        read(stream, ent_number, is_binary, needs_swapping);
+        cursor.read(ent_number);
         for (int ent_node = 0; ent_node < nodes_per_ent; ++ent_node) {
           int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          auto it = node_number_map.find(node_number);
-          OMEGA_H_CHECK(it != node_number_map.end());
-          ent_nodes[dim].push_back(it->second);
+          cursor.read(node_number);
+          ent_nodes[dim].push_back(numbering(node_number));
         }
       }
     }
-
   } else {
     LO nents;
-    stream >> nents;
+    cursor.read_text(nents);
     OMEGA_H_CHECK(nents >= 0);
     std::array<std::unordered_map<Int, Int>, 4> ent2physical;
     if (is_binary) {
-      eat_newlines(stream);
+      cursor.eat_newlines();
       LO i = 0;
       while (i < nents) {
         I32 type, nfollow, ntags;
-        binary::read_value(stream, type, needs_swapping);
-        binary::read_value(stream, nfollow, needs_swapping);
-        binary::read_value(stream, ntags, needs_swapping);
+        cursor.read_binary(type);
+        cursor.read_binary(nfollow);
+        cursor.read_binary(ntags);
         Int dim = type_dim(type);
         if (type_family(type) == OMEGA_H_HYPERCUBE) {
           family = OMEGA_H_HYPERCUBE;
@@ -413,20 +643,17 @@ void read_internal(std::istream& stream, Mesh* mesh) {
         OMEGA_H_CHECK(ntags >= 2);
         for (Int j = 0; j < nfollow; ++j, ++i) {
           I32 number, physical, elementary;
-          binary::read_value(stream, number, needs_swapping);
-          binary::read_value(stream, physical, needs_swapping);
-          binary::read_value(stream, elementary, needs_swapping);
+          cursor.read_binary(number);
+          cursor.read_binary(physical);
+          cursor.read_binary(elementary);
           ent_class_ids[dim].push_back(elementary);
           if (physical != 0) {
             ent2physical[dim].emplace(elementary, physical);
           }
-          for (Int k = 2; k < ntags; ++k) {
-            I32 ignored;
-            binary::read_value(stream, ignored, false);
-          }
+          cursor.seek(cursor.pos() + std::size_t(ntags - 2) * sizeof(I32));
           for (Int k = 0; k < neev; ++k) {
             I32 node_number;
-            binary::read_value(stream, node_number, needs_swapping);
+            cursor.read_binary(node_number);
             ent_nodes[dim].push_back(node_number - 1);
           }
         }
@@ -434,29 +661,30 @@ void read_internal(std::istream& stream, Mesh* mesh) {
     } else {
       for (LO i = 0; i < nents; ++i) {
         LO number;
-        stream >> number;
+        cursor.read(number);
         OMEGA_H_CHECK(number > 0);
         Int type;
-        stream >> type;
+        cursor.read(type);
         Int dim = type_dim(type);
         if (type_family(type) == OMEGA_H_HYPERCUBE) family = OMEGA_H_HYPERCUBE;
         Int ntags;
-        stream >> ntags;
+        cursor.read(ntags);
         OMEGA_H_CHECK(ntags >= 2);
         Int physical, elementary;
-        stream >> physical >> elementary;
+        cursor.read(physical);
+        cursor.read(elementary);
         ent_class_ids[dim].push_back(elementary);
         if (physical != 0) {
           ent2physical[dim].emplace(elementary, physical);
         }
         Int tag;
         for (Int j = 2; j < ntags; ++j) {
-          stream >> tag;
+          cursor.read(tag);
         }
         Int neev = dim + 1;
         LO node_number;
         for (Int j = 0; j < neev; ++j) {
-          stream >> node_number;
+          cursor.read(node_number);
           ent_nodes[dim].push_back(node_number - 1);
         }
       }
@@ -488,7 +716,7 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   for (LO i = 0; i < nnodes; ++i) {
     for (Int j = 0; j < max_dim; ++j) {
       host_coords[i * max_dim + j] =
-          node_coords[static_cast<std::size_t>(i)][j];
+          node_coords[static_cast<std::size_t>(i * 3 + j)];
     }
   }
   for (Int ent_dim = max_dim; ent_dim >= 0; --ent_dim) {
@@ -496,13 +724,10 @@ void read_internal(std::istream& stream, Mesh* mesh) {
     LO ndim_ents = static_cast<LO>(ent_nodes[ent_dim].size()) / neev;
     HostWrite<LO> host_ev2v(ndim_ents * neev);
     HostWrite<LO> host_class_id(ndim_ents);
-    for (LO i = 0; i < ndim_ents; ++i) {
-      for (Int j = 0; j < neev; ++j) {
-        host_ev2v[i * neev + j] =
-            ent_nodes[ent_dim][static_cast<std::size_t>(i * neev + j)];
-      }
-      host_class_id[i] = ent_class_ids[ent_dim][static_cast<std::size_t>(i)];
-    }
+    std::copy_n(ent_nodes[ent_dim].data(), ndim_ents * neev,
+        host_ev2v.data());
+    std::copy_n(ent_class_ids[ent_dim].data(), ndim_ents,
+        host_class_id.data());
     auto eqv2v = Read<LO>(host_ev2v.write());
     if (ent_dim == max_dim) {
       build_from_elems_and_coords(
@@ -513,12 +738,337 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   finalize_classification(mesh);
 }
 
+#ifndef _MSC_VER
+
+/* positioned reads of a file that every rank can open, so that a rank
+   only touches the byte ranges of its own slices */
+class SharedFile {
+ public:
+  explicit SharedFile(filesystem::path const& path)
+      : fd_(::open(path.c_str(), O_RDONLY)) {
+    if (fd_ < 0) Omega_h_fail("couldn't open \"%s\"\n", path.c_str());
+  }
+  ~SharedFile() { ::close(fd_); }
+  SharedFile(SharedFile const&) = delete;
+  SharedFile& operator=(SharedFile const&) = delete;
+  /* may return fewer than n bytes at the end of the file */
+  std::string read_some(std::size_t offset, std::size_t n) const {
+    std::string buffer(n, '\0');
+    std::size_t done = 0;
+    while (done < n) {
+      auto const got =
+          ::pread(fd_, &buffer[done], n - done, off_t(offset + done));
+      if (got < 0 && errno == EINTR) continue;
+      if (got < 0) {
+        Omega_h_fail("gmsh: pread failed: %s\n", std::strerror(errno));
+      }
+      if (got == 0) break;
+      done += std::size_t(got);
+    }
+    buffer.resize(done);
+    return buffer;
+  }
+  std::string read(std::size_t offset, std::size_t n) const {
+    auto buffer = read_some(offset, n);
+    if (buffer.size() != n) {
+      Omega_h_fail("gmsh: unexpected end of binary data\n");
+    }
+    return buffer;
+  }
+  template <class T>
+  T load(std::size_t offset, bool needs_swapping) const {
+    return Cursor::load<T>(read(offset, sizeof(T)).data(), needs_swapping);
+  }
+  /* the offset just past the first line equal to want at or after offset */
+  std::size_t find_line(std::size_t offset, std::string const& want) const {
+    auto const key = want + '\n';
+    std::size_t const chunk = std::size_t(1) << 16;
+    auto start = offset;
+    while (true) {
+      auto const buffer = read_some(start, chunk);
+      for (auto pos = buffer.find(key); pos != std::string::npos;
+           pos = buffer.find(key, pos + 1)) {
+        bool const line_start =
+            (pos == 0) ? (start == 0) : (buffer[pos - 1] == '\n');
+        if (line_start) return start + pos + key.size();
+      }
+      if (buffer.size() < chunk) {
+        Omega_h_fail("gmsh: couldn't find \"%s\"\n", want.c_str());
+      }
+      start += chunk - key.size();
+    }
+  }
+  std::size_t skip_newlines(std::size_t offset) const {
+    while (read_some(offset, 1) == "\n") ++offset;
+    return offset;
+  }
+
+ private:
+  int fd_;
+};
+
+/* a run of records in a binary 4.x $Nodes or $Elements section, whose
+   position in the file is known without reading its contents */
+struct Block {
+  Int dim;
+  int class_id;
+  int nodes_per_ent;
+  std::size_t offset;  // of the first record
+  GO first;            // index of the first record among those of its kind
+  GO count;
+};
+
+/* The sliced counterpart of read_internal for binary MSH 4.x files:
+   each rank walks the block headers, then reads only its slice of the
+   node records and of the top-dimensional element records, and the
+   slices are assembled into a partitioned mesh.  Nodes are globally
+   numbered by their position in the file.  Returns false if the file
+   is not binary 4.x or cannot be sliced, leaving the caller to read it
+   on one rank instead. */
+bool read_sliced(filesystem::path const& filename, CommPtr comm, Mesh* mesh) {
+  SharedFile const file(filename);
+  auto const nodes_start = file.find_line(0, "$Nodes");
+  Cursor cursor(file.read(0, nodes_start));
+  std::vector<std::string> physical_names;
+  auto const format = read_header(cursor, mesh, physical_names);
+  if (!cursor.is_binary() || format < 4.0) return false;
+  auto const swap = cursor.needs_swapping();
+  auto const int_size = sizeof(int);
+  auto const coords_size = 3 * sizeof(Real);
+  bool const tags_first = (format >= 4.1);
+  auto pos = file.skip_newlines(nodes_start);
+  auto const num_node_blocks = file.load<int>(pos, swap);
+  auto const nnodes = GO(file.load<int>(pos + int_size, swap));
+  pos += (tags_first ? 4 : 2) * int_size;
+  std::vector<Block> node_blocks;
+  for (int i = 0; i < num_node_blocks; ++i) {
+    Block block;
+    block.dim = file.load<int>(pos + (tags_first ? 0 : int_size), swap);
+    block.class_id = file.load<int>(pos + (tags_first ? int_size : 0), swap);
+    block.nodes_per_ent = 1;
+    block.count = file.load<int>(pos + 3 * int_size, swap);
+    block.offset = pos + 4 * int_size;
+    block.first = node_blocks.empty()
+                      ? 0
+                      : node_blocks.back().first + node_blocks.back().count;
+    pos = block.offset + std::size_t(block.count) * (int_size + coords_size);
+    node_blocks.push_back(block);
+  }
+  pos = file.skip_newlines(file.find_line(pos, "$Elements"));
+  auto const num_elem_blocks = file.load<int>(pos, swap);
+  pos += (tags_first ? 4 : 2) * int_size;
+  std::vector<Block> elem_blocks;
+  std::array<GO, 4> dim_counts = {{0, 0, 0, 0}};
+  Omega_h_Family family = OMEGA_H_SIMPLEX;
+  for (int i = 0; i < num_elem_blocks; ++i) {
+    Block block;
+    int class_dim = file.load<int>(pos + (format == 4. ? int_size : 0), swap);
+    block.class_id = file.load<int>(pos + (format == 4. ? 0 : int_size), swap);
+    auto const ent_type = file.load<int>(pos + 2 * int_size, swap);
+    block.count = file.load<int>(pos + 3 * int_size, swap);
+    block.dim = type_dim(ent_type);
+    OMEGA_H_CHECK(block.dim == class_dim);
+    if (type_family(ent_type) == OMEGA_H_HYPERCUBE) {
+      family = OMEGA_H_HYPERCUBE;
+    }
+    block.nodes_per_ent = element_degree(family, block.dim, 0);
+    block.offset = pos + 4 * int_size;
+    block.first = dim_counts[std::size_t(block.dim)];
+    dim_counts[std::size_t(block.dim)] += block.count;
+    pos = block.offset + std::size_t(block.count) *
+                             std::size_t(1 + block.nodes_per_ent) * int_size;
+    elem_blocks.push_back(block);
+  }
+  Int max_dim;
+  if (dim_counts[3]) {
+    max_dim = 3;
+  } else if (dim_counts[2]) {
+    max_dim = 2;
+  } else if (dim_counts[1]) {
+    max_dim = 1;
+  } else {
+    Omega_h_fail("There were no Elements of dimension higher than zero!\n");
+  }
+  GO nodes_begin, nodes_end;
+  suggest_slices(nnodes, comm->size(), comm->rank(), &nodes_begin, &nodes_end);
+  auto const nslice_nodes = LO(nodes_end - nodes_begin);
+  HostWrite<GO> h_slice_tags(nslice_nodes);
+  HostWrite<Real> h_slice_coords(nslice_nodes * max_dim);
+  for (auto const& block : node_blocks) {
+    auto const begin = std::max(block.first, nodes_begin);
+    auto const end = std::min(block.first + block.count, nodes_end);
+    if (end <= begin) continue;
+    auto const k = std::size_t(begin - block.first);
+    auto const m = std::size_t(end - begin);
+    auto const out = LO(begin - nodes_begin);
+    std::string tags, coords;
+    if (tags_first) {
+      tags = file.read(block.offset + k * int_size, m * int_size);
+      coords = file.read(block.offset + std::size_t(block.count) * int_size +
+                             k * coords_size,
+          m * coords_size);
+    } else {
+      auto const record = int_size + coords_size;
+      tags = file.read(block.offset + k * record, m * record);
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+      char const* p = tags_first ? tags.data() + i * int_size
+                                 : tags.data() + i * (int_size + coords_size);
+      h_slice_tags[out + LO(i)] = Cursor::load<int>(p, swap);
+      p = tags_first ? coords.data() + i * coords_size : p + int_size;
+      for (Int j = 0; j < max_dim; ++j) {
+        h_slice_coords[(out + LO(i)) * max_dim + j] =
+            Cursor::load<Real>(p + std::size_t(j) * sizeof(Real), swap);
+      }
+    }
+  }
+  auto const slice_tags = GOs(h_slice_tags.write());
+  auto const slice_coords = Reals(h_slice_coords.write());
+  GO elems_begin, elems_end;
+  suggest_slices(dim_counts[std::size_t(max_dim)], comm->size(), comm->rank(),
+      &elems_begin, &elems_end);
+  auto const nslice_elems = LO(elems_end - elems_begin);
+  auto const deg = element_degree(family, max_dim, VERT);
+  HostWrite<GO> h_slice_conn_tags(nslice_elems * deg);
+  HostWrite<ClassId> h_slice_class_ids(nslice_elems);
+  for (auto const& block : elem_blocks) {
+    if (block.dim != max_dim) continue;
+    auto const begin = std::max(block.first, elems_begin);
+    auto const end = std::min(block.first + block.count, elems_end);
+    if (end <= begin) continue;
+    auto const record = std::size_t(1 + deg) * int_size;
+    auto const records = file.read(
+        block.offset + std::size_t(begin - block.first) * record,
+        std::size_t(end - begin) * record);
+    auto const out = LO(begin - elems_begin);
+    for (LO i = 0; i < LO(end - begin); ++i) {
+      auto const p = records.data() + std::size_t(i) * record + int_size;
+      for (Int j = 0; j < deg; ++j) {
+        h_slice_conn_tags[(out + i) * deg + j] =
+            Cursor::load<int>(p + std::size_t(j) * int_size, swap);
+      }
+      h_slice_class_ids[out + i] = block.class_id;
+    }
+  }
+  auto const slice_conn_tags = GOs(h_slice_conn_tags.write());
+  /* node tags are usually the positions plus a constant; otherwise the
+     positions are looked up in a directory partitioned by tag */
+  auto const tag_range = get_minmax(comm, slice_tags);
+  bool is_offset = true;
+  for (LO i = 0; i < nslice_nodes; ++i) {
+    is_offset = is_offset &&
+                (h_slice_tags[i] == tag_range.min + nodes_begin + GO(i));
+  }
+  GOs slice_conn;
+  if (comm->reduce_and(is_offset)) {
+    slice_conn = add_to_each(slice_conn_tags, -tag_range.min);
+  } else {
+    auto const span = tag_range.max - tag_range.min + 1;
+    auto const ndirectory = linear_partition_size(comm, span);
+    auto const nodes2directory = Dist(comm,
+        globals_to_linear_owners(
+            comm, add_to_each(slice_tags, -tag_range.min), span),
+        ndirectory);
+    /* as in the serial reader, a repeated tag keeps its last position */
+    auto const directory = nodes2directory.exch_reduce(
+        GOs(nslice_nodes, nodes_begin, 1), 1, OMEGA_H_MAX);
+    auto const queries2directory = Dist(comm,
+        globals_to_linear_owners(
+            comm, add_to_each(slice_conn_tags, -tag_range.min), span),
+        ndirectory);
+    slice_conn = queries2directory.invert().exch(directory, 1);
+  }
+  /* the linear partition of the connectivity has to agree with the
+     slicing of the nodes, which fails if the last nodes are unused */
+  if (get_max(comm, slice_conn) + 1 != nnodes) return false;
+  Dist slice_elems2elems;
+  Dist slice_verts2verts;
+  LOs conn;
+  assemble_slices(comm, family, max_dim, dim_counts[std::size_t(max_dim)],
+      elems_begin, slice_conn, nnodes, nodes_begin, slice_coords,
+      &slice_elems2elems, &conn, &slice_verts2verts);
+  auto const node_globals =
+      slice_verts2verts.exch(GOs(nslice_nodes, nodes_begin, 1), 1);
+  build_from_elems2verts(mesh, comm, family, max_dim, conn, node_globals);
+  auto const coords = slice_verts2verts.exch(slice_coords, max_dim);
+  mesh->add_tag(VERT, "coordinates", max_dim, coords);
+  classify_equal_order(mesh, max_dim, conn,
+      slice_elems2elems.exch(Read<ClassId>(h_slice_class_ids.write()), 1));
+  /* lower-dimensional entities only cover the model boundary, so each
+     rank reads all of them and keeps those it has */
+  auto const vert_tags = HostRead<GO>(slice_verts2verts.exch(slice_tags, 1));
+  std::unordered_map<GO, LO> tags2verts;
+  for (LO v = 0; v < vert_tags.size(); ++v) tags2verts[vert_tags[v]] = v;
+  for (Int ent_dim = max_dim - 1; ent_dim >= 0; --ent_dim) {
+    auto const neev = element_degree(family, ent_dim, VERT);
+    std::vector<LO> eqv2v;
+    std::vector<ClassId> eq_class_ids;
+    HostRead<LO> ev2v;
+    Adj v2e;
+    HostRead<LO> v2ve, ve2e;
+    if (ent_dim > VERT) {
+      ev2v = HostRead<LO>(mesh->ask_verts_of(ent_dim));
+      v2e = mesh->ask_up(VERT, ent_dim);
+      v2ve = HostRead<LO>(v2e.a2ab);
+      ve2e = HostRead<LO>(v2e.ab2b);
+    }
+    for (auto const& block : elem_blocks) {
+      if (block.dim != ent_dim) continue;
+      auto const record = std::size_t(1 + neev) * int_size;
+      auto const records =
+          file.read(block.offset, std::size_t(block.count) * record);
+      for (GO i = 0; i < block.count; ++i) {
+        auto const p = records.data() + std::size_t(i) * record + int_size;
+        Few<LO, 8> verts;
+        bool is_local = true;
+        for (Int j = 0; j < neev && is_local; ++j) {
+          auto const it = tags2verts.find(
+              Cursor::load<int>(p + std::size_t(j) * int_size, swap));
+          is_local = (it != tags2verts.end());
+          if (is_local) verts[j] = it->second;
+        }
+        if (!is_local) continue;
+        /* having all the vertices does not mean having the entity */
+        bool exists = (ent_dim == VERT);
+        for (auto ve = (exists ? 0 : v2ve[verts[0]]);
+             !exists && ve < v2ve[verts[0] + 1]; ++ve) {
+          auto const e = ve2e[ve];
+          exists = true;
+          for (Int j = 0; j < neev && exists; ++j) {
+            exists = false;
+            for (Int k = 0; k < neev; ++k) {
+              exists = exists || (ev2v[e * neev + k] == verts[j]);
+            }
+          }
+        }
+        if (!exists) continue;
+        for (Int j = 0; j < neev; ++j) eqv2v.push_back(verts[j]);
+        eq_class_ids.push_back(block.class_id);
+      }
+    }
+    HostWrite<LO> h_eqv2v(LO(eqv2v.size()));
+    HostWrite<ClassId> h_eq_class_ids(LO(eq_class_ids.size()));
+    std::copy(eqv2v.begin(), eqv2v.end(), h_eqv2v.data());
+    std::copy(eq_class_ids.begin(), eq_class_ids.end(), h_eq_class_ids.data());
+    classify_equal_order(
+        mesh, ent_dim, h_eqv2v.write(), h_eq_class_ids.write());
+  }
+  /* projecting the classification needs every upward adjacency */
+  mesh->set_parting(OMEGA_H_GHOSTED);
+  finalize_classification(mesh);
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  return true;
+}
+
+#endif
+
 }  // end anonymous namespace
 
 Mesh read(std::istream& stream, CommPtr comm) {
   auto mesh = Mesh(comm->library());
   if (comm->rank() == 0) {
-    read_internal(stream, &mesh);
+    Cursor cursor(read_whole_stream(stream));
+    read_internal(cursor, &mesh);
   }
   mesh.set_comm(comm);
   mesh.balance();
@@ -526,7 +1076,13 @@ Mesh read(std::istream& stream, CommPtr comm) {
 }
 
 Mesh read(filesystem::path const& filename, CommPtr comm) {
-  std::ifstream file(filename.c_str());
+#ifndef _MSC_VER
+  if (comm->size() > 1) {
+    auto mesh = Mesh(comm->library());
+    if (read_sliced(filename, comm, &mesh)) return mesh;
+  }
+#endif
+  std::ifstream file(filename.c_str(), std::ios::binary);
   if (!file.is_open()) {
     Omega_h_fail("couldn't open \"%s\"\n", filename.c_str());
   }
@@ -7,6 +7,7 @@
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_for.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 
@@ -15,26 +16,173 @@ namespace Omega_h {
 Histogram get_histogram(Mesh* mesh, Int dim, Int nbins, Real min_value,
     Real max_value, Reals values) {
   OMEGA_H_CHECK(values.size() == mesh->nents(dim));
-  auto owned_values = mesh->owned_array(dim, values, 1);
-  auto interval = (max_value - min_value) / Real(nbins);
-  Histogram histogram;
-  histogram.min = min_value;
-  histogram.max = max_value;
-  histogram.bins.resize(std::size_t(nbins));
+  FieldStatsInput input = {dim, values, nbins, min_value, max_value,
+      {ArithTraits<Real>::min(), ArithTraits<Real>::max()}};
+  return get_field_stats(mesh, {input})[0].histogram;
+}
+
+Real FieldStats::quantile(Real p) const {
+  auto const nbins = Int(histogram.bins.size());
+  auto const target = p * Real(count);
+  /* values outside the histogram range are spread over the gaps
+     between it and the extreme values */
+  auto const interval = (histogram.max - histogram.min) / Real(nbins);
+  Real seen = 0.0;
+  auto interpolate = [&](Real lo, Real hi, GO n) {
+    return lo + (hi - lo) * ((target - seen) / Real(n));
+  };
+  if (nunder && target <= seen + Real(nunder)) {
+    return interpolate(minmax.min, histogram.min, nunder);
+  }
+  seen += Real(nunder);
   for (Int i = 0; i < nbins; ++i) {
-    auto floor = interval * i + min_value;
-    auto ceil = interval * (i + 1) + min_value;
-    if (i == nbins - 1) ceil = max_value;
-    auto floor_marks = each_geq_to(owned_values, floor);
-    Read<I8> ceil_marks;
-    if (i == nbins - 1)
-      ceil_marks = each_leq_to(owned_values, ceil);
-    else
-      ceil_marks = each_lt(owned_values, ceil);
-    auto marked = land_each(floor_marks, ceil_marks);
-    histogram.bins[std::size_t(i)] = get_sum(mesh->comm(), marked);
+    auto const n = histogram.bins[std::size_t(i)];
+    if (n && target <= seen + Real(n)) {
+      auto const lo = max2(minmax.min, histogram.min + interval * i);
+      auto const hi = min2(minmax.max, histogram.min + interval * (i + 1));
+      return interpolate(lo, hi, n);
+    }
+    seen += Real(n);
   }
-  return histogram;
+  if (nover) return interpolate(histogram.max, minmax.max, nover);
+  return minmax.max;
+}
+
+/* partial statistics of one chunk of entities */
+enum {
+  STATS_COUNT,
+  STATS_SUM,
+  STATS_MIN,
+  STATS_MAX,
+  STATS_NLOW,
+  STATS_NHIGH,
+  STATS_NUNDER,
+  STATS_NOVER,
+  STATS_NFIXED
+};
+
+/* the chunks are large enough that the host can combine their partial
+   results cheaply, and numerous enough to keep all threads busy */
+static HostRead<Real> get_chunk_stats(
+    FieldStatsInput const& input, Read<I8> owned, LO nchunks) {
+  auto const values = input.values;
+  auto const n = values.size();
+  auto const nbins = input.nbins;
+  auto const width = STATS_NFIXED + nbins;
+  auto const hist_min = input.hist_min;
+  auto const hist_max = input.hist_max;
+  auto const interval = (hist_max - hist_min) / Real(max2(nbins, 1));
+  auto const desired = input.desired;
+  Write<Real> out(nchunks * width);
+  auto f = OMEGA_H_LAMBDA(LO chunk) {
+    auto const row = chunk * width;
+    Real count = 0.0;
+    Real sum = 0.0;
+    Real minval = ArithTraits<Real>::max();
+    Real maxval = ArithTraits<Real>::min();
+    Real nlow = 0.0;
+    Real nhigh = 0.0;
+    Real nunder = 0.0;
+    Real nover = 0.0;
+    for (Int b = 0; b < nbins; ++b) out[row + STATS_NFIXED + b] = 0.0;
+    auto const begin = LO((GO(n) * chunk) / nchunks);
+    auto const end = LO((GO(n) * (chunk + 1)) / nchunks);
+    for (LO i = begin; i < end; ++i) {
+      if (!owned[i]) continue;
+      auto const v = values[i];
+      count += 1.0;
+      sum += v;
+      minval = min2(minval, v);
+      maxval = max2(maxval, v);
+      if (v < desired.min) nlow += 1.0;
+      if (v > desired.max) nhigh += 1.0;
+      if (!nbins) continue;
+      if (v < hist_min) {
+        nunder += 1.0;
+      } else if (v > hist_max) {
+        nover += 1.0;
+      } else {
+        /* the last bin includes its upper bound */
+        auto b = (interval > 0.0) ? Int((v - hist_min) / interval) : 0;
+        out[row + STATS_NFIXED + min2(b, nbins - 1)] += 1.0;
+      }
+    }
+    out[row + STATS_COUNT] = count;
+    out[row + STATS_SUM] = sum;
+    out[row + STATS_MIN] = minval;
+    out[row + STATS_MAX] = maxval;
+    out[row + STATS_NLOW] = nlow;
+    out[row + STATS_NHIGH] = nhigh;
+    out[row + STATS_NUNDER] = nunder;
+    out[row + STATS_NOVER] = nover;
+  };
+  parallel_for(nchunks, f, "get_field_stats");
+  return HostRead<Real>(out);
+}
+
+std::vector<FieldStats> get_field_stats(
+    Mesh* mesh, std::vector<FieldStatsInput> const& inputs) {
+  OMEGA_H_TIME_FUNCTION;
+  /* minima are negated so that extrema share one MAX reduction, and the
+     remaining counts and sums share one SUM reduction */
+  std::vector<Real> local_maxes;
+  std::vector<Real> local_sums;
+  for (auto const& input : inputs) {
+    OMEGA_H_CHECK(input.values.size() == mesh->nents(input.ent_dim));
+    auto const width = STATS_NFIXED + input.nbins;
+    auto const nchunks = max2(LO(1), min2(input.values.size(), LO(1024)));
+    auto const chunks =
+        get_chunk_stats(input, mesh->owned(input.ent_dim), nchunks);
+    std::vector<Real> fixed(std::size_t(width), 0.0);
+    Real minval = ArithTraits<Real>::max();
+    Real maxval = ArithTraits<Real>::min();
+    for (LO c = 0; c < nchunks; ++c) {
+      for (Int j = 0; j < width; ++j) {
+        fixed[std::size_t(j)] += chunks[c * width + j];
+      }
+      minval = min2(minval, chunks[c * width + STATS_MIN]);
+      maxval = max2(maxval, chunks[c * width + STATS_MAX]);
+    }
+    local_maxes.push_back(maxval);
+    local_maxes.push_back(-minval);
+    for (Int j = 0; j < width; ++j) {
+      if (j == STATS_MIN || j == STATS_MAX) continue;
+      local_sums.push_back(fixed[std::size_t(j)]);
+    }
+  }
+  auto to_device = [](std::vector<Real> const& v) {
+    HostWrite<Real> out(LO(v.size()));
+    for (LO i = 0; i < out.size(); ++i) out[i] = v[std::size_t(i)];
+    return Read<Real>(out.write());
+  };
+  auto comm = mesh->comm();
+  auto const maxes =
+      HostRead<Real>(comm->allreduce(to_device(local_maxes), OMEGA_H_MAX));
+  auto const sums =
+      HostRead<Real>(comm->allreduce(to_device(local_sums), OMEGA_H_SUM));
+  std::vector<FieldStats> out;
+  LO next_sum = 0;
+  for (std::size_t f = 0; f < inputs.size(); ++f) {
+    auto const& input = inputs[f];
+    FieldStats stats;
+    auto next = [&]() { return sums[next_sum++]; };
+    stats.count = GO(next());
+    auto const sum = next();
+    stats.nlow = GO(next());
+    stats.nhigh = GO(next());
+    stats.nunder = GO(next());
+    stats.nover = GO(next());
+    stats.minmax.max = maxes[LO(2 * f)];
+    stats.minmax.min = -maxes[LO(2 * f + 1)];
+    stats.mean = stats.count ? (sum / Real(stats.count)) : 0.0;
+    stats.histogram.min = input.hist_min;
+    stats.histogram.max = input.hist_max;
+    for (Int b = 0; b < input.nbins; ++b) {
+      stats.histogram.bins.push_back(GO(next()));
+    }
+    out.push_back(stats);
+  }
+  return out;
 }
 
 void print_histogram(Histogram const& histogram, std::string const& name) {
@@ -55,12 +203,19 @@ void print_histogram(Histogram const& histogram, std::string const& name) {
 
 void print_goal_stats(Mesh* mesh, char const* name, Int ent_dim, Reals values,
     MinMax<Real> desired, MinMax<Real> actual) {
-  auto low_marks = each_lt(values, desired.min);
-  auto high_marks = each_gt(values, desired.max);
-  auto nlow = count_owned_marks(mesh, ent_dim, low_marks);
-  auto nhigh = count_owned_marks(mesh, ent_dim, high_marks);
-  auto ntotal = mesh->nglobal_ents(ent_dim);
+  FieldStatsInput input = {ent_dim, values, 0, 0.0, 0.0, desired};
+  auto stats = get_field_stats(mesh, {input})[0];
+  stats.minmax = actual;
+  print_goal_stats(mesh, name, ent_dim, stats, desired);
+}
+
+void print_goal_stats(Mesh* mesh, char const* name, Int ent_dim,
+    FieldStats const& stats, MinMax<Real> desired) {
+  auto nlow = stats.nlow;
+  auto nhigh = stats.nhigh;
+  auto ntotal = stats.count;
   auto nmid = ntotal - nlow - nhigh;
+  auto actual = stats.minmax;
   if (mesh->comm()->rank() == 0) {
     auto precision_before = std::cout.precision();
     std::ios::fmtflags stream_state(std::cout.flags());
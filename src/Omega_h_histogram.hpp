@@ -19,10 +19,43 @@ struct Histogram {
 Histogram get_histogram(Mesh* mesh, Int dim, Int nbins, Real min_value,
     Real max_value, Reals values);
 
+/* one field for get_field_stats(): values on entities of dimension
+   ent_dim, an optional histogram of nbins bins over [hist_min, hist_max]
+   and the desired range used to count outliers */
+struct FieldStatsInput {
+  Int ent_dim;
+  Reals values;
+  Int nbins;
+  Real hist_min;
+  Real hist_max;
+  MinMax<Real> desired;
+};
+
+/* statistics over the owned entities of all ranks */
+struct FieldStats {
+  GO count;
+  MinMax<Real> minmax;
+  Real mean;
+  GO nlow;   // below desired.min
+  GO nhigh;  // above desired.max
+  GO nunder;  // below the histogram range
+  GO nover;   // above the histogram range
+  Histogram histogram;
+  /* approximate, interpolated within the histogram bins */
+  Real quantile(Real p) const;
+};
+
+/* computes the statistics of all fields in one pass over each array and
+   two reductions across ranks, instead of one of each per quantity */
+std::vector<FieldStats> get_field_stats(
+    Mesh* mesh, std::vector<FieldStatsInput> const& inputs);
+
 void print_histogram(Histogram const& histogram, std::string const& name);
 
 void print_goal_stats(Mesh* mesh, char const* name, Int ent_dim, Reals values,
     MinMax<Real> desired, MinMax<Real> actual);
+void print_goal_stats(Mesh* mesh, char const* name, Int ent_dim,
+    FieldStats const& stats, MinMax<Real> desired);
 
 void render_histogram_matplotlib(
     Histogram const& histogram, std::string const& filepath);
@@ -1,5 +1,10 @@
 #include "Omega_h_indset_inline.hpp"
 
+#include "Omega_h_element.hpp"
+#include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_random.hpp"
+
 namespace Omega_h {
 
 struct QualityCompare {
@@ -14,23 +19,123 @@ struct QualityCompare {
   }
 };
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Graph graph, Reals quality, Read<I8> candidates) {
+/* orders by quality rounded down to one of (nbuckets) buckets, then
+   by a random priority. when qualities vary smoothly, ordering them
+   exactly lets decisions ripple one neighbor per round, while random
+   priorities decide most entities within O(log n) rounds (Luby).
+   the priorities are hashed from global numbers, so the result is
+   still deterministic and independent of the partitioning */
+struct BucketCompare {
+  Reals quality;
+  Reals random;
+  GOs global;
+  Real nbuckets;
+  OMEGA_H_DEVICE bool operator()(LO u, LO v) const {
+    auto const v_bucket = std::floor(quality[v] * nbuckets);
+    auto const u_bucket = std::floor(quality[u] * nbuckets);
+    if (u_bucket != v_bucket) return u_bucket < v_bucket;
+    if (random[u] != random[v]) return random[u] < random[v];
+    return global[u] < global[v];
+  }
+};
+
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Graph graph, Reals quality,
+    Read<I8> candidates, Int nquality_buckets) {
   auto xadj = graph.a2ab;
   auto adj = graph.ab2b;
+  if (nquality_buckets > 0) {
+    BucketCompare compare;
+    compare.quality = quality;
+    compare.global = mesh->globals(ent_dim);
+    compare.random =
+        unit_uniform_random_reals_from_globals(compare.global, 0, ent_dim);
+    compare.nbuckets = Real(nquality_buckets);
+    return indset::find(mesh, ent_dim, xadj, adj, candidates, compare);
+  }
   QualityCompare compare;
   compare.quality = quality;
   compare.global = mesh->globals(ent_dim);
   return indset::find(mesh, ent_dim, xadj, adj, candidates, compare);
 }
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Reals quality, Read<I8> candidates) {
+/* the rows of the star graph that the independent set iterations
+   actually visit: candidates and their neighboring candidates.
+   non-candidates never leave the NOT_IN state, so the rest of the
+   graph is irrelevant, and building it costs time proportional to the
+   mesh size even when only a few candidates remain.
+   on simplices two entities share an element exactly when they are
+   adjacent in Mesh::ask_star(), so the rows are gathered through the
+   elements */
+static Graph get_candidate_star(
+    Mesh* mesh, Int ent_dim, Read<I8> candidates) {
+  auto nents = mesh->nents(ent_dim);
+  auto cands2ents = collect_marked(candidates);
+  auto ncands = cands2ents.size();
+  auto ents2elems = mesh->ask_up(ent_dim, mesh->dim());
+  auto ents2ent_elems = ents2elems.a2ab;
+  auto ent_elems2elems = ents2elems.ab2b;
+  auto elems2ents = mesh->ask_down(mesh->dim(), ent_dim).ab2b;
+  auto nents_per_elem = element_degree(mesh->family(), mesh->dim(), ent_dim);
+  Write<LO> cands2max_adj(ncands);
+  auto count = OMEGA_H_LAMBDA(LO cand) {
+    auto ent = cands2ents[cand];
+    auto nelems = ents2ent_elems[ent + 1] - ents2ent_elems[ent];
+    cands2max_adj[cand] = nelems * (nents_per_elem - 1);
+  };
+  parallel_for(ncands, count, "get_candidate_star(count)");
+  auto cands2max_adj_offsets = offset_scan(read(cands2max_adj));
+  Write<LO> max_adj(cands2max_adj_offsets.last());
+  Write<LO> degrees(nents, 0);
+  auto fill = OMEGA_H_LAMBDA(LO cand) {
+    auto ent = cands2ents[cand];
+    auto begin = cands2max_adj_offsets[cand];
+    LO degree = 0;
+    for (auto ent_elem = ents2ent_elems[ent];
+         ent_elem < ents2ent_elems[ent + 1]; ++ent_elem) {
+      auto elem = ent_elems2elems[ent_elem];
+      for (Int elem_ent = 0; elem_ent < nents_per_elem; ++elem_ent) {
+        auto other = elems2ents[elem * nents_per_elem + elem_ent];
+        if (other == ent || !candidates[other]) continue;
+        bool is_new = true;
+        for (LO j = 0; j < degree; ++j) {
+          if (max_adj[begin + j] == other) {
+            is_new = false;
+            break;
+          }
+        }
+        if (is_new) max_adj[begin + degree++] = other;
+      }
+    }
+    degrees[ent] = degree;
+  };
+  parallel_for(ncands, fill, "get_candidate_star(fill)");
+  auto offsets = offset_scan(read(degrees));
+  Write<LO> adj(offsets.last());
+  auto compact = OMEGA_H_LAMBDA(LO cand) {
+    auto ent = cands2ents[cand];
+    auto from = cands2max_adj_offsets[cand];
+    auto to = offsets[ent];
+    for (LO j = 0; j < offsets[ent + 1] - to; ++j) {
+      adj[to + j] = max_adj[from + j];
+    }
+  };
+  parallel_for(ncands, compact, "get_candidate_star(compact)");
+  return Graph(offsets, adj);
+}
+
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, Int nquality_buckets) {
   if (ent_dim == mesh->dim()) return candidates;
   mesh->owners_have_all_upward(ent_dim);
   OMEGA_H_CHECK(mesh->owners_have_all_upward(ent_dim));
-  auto graph = mesh->ask_star(ent_dim);
-  return find_indset(mesh, ent_dim, graph, quality, candidates);
+  Graph graph;
+  if (mesh->family() == OMEGA_H_SIMPLEX && !mesh->has_adj(ent_dim, ent_dim)) {
+    graph = get_candidate_star(mesh, ent_dim, candidates);
+  } else {
+    graph = mesh->ask_star(ent_dim);
+  }
+  return find_indset(
+      mesh, ent_dim, graph, quality, candidates, nquality_buckets);
 }
 
 }  // end namespace Omega_h
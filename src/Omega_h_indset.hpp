@@ -8,10 +8,14 @@ namespace Omega_h {
 
 class Mesh;
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Graph graph, Reals quality, Read<I8> candidates);
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Reals quality, Read<I8> candidates);
+/* candidates of higher quality take precedence over their neighbors.
+   if (nquality_buckets) is positive, qualities (in [0, 1]) are only
+   compared up to that many buckets and ties are broken randomly,
+   which bounds the number of rounds */
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Graph graph, Reals quality,
+    Read<I8> candidates, Int nquality_buckets = 0);
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, Int nquality_buckets = 0);
 
 }  // end namespace Omega_h
 
@@ -2,8 +2,10 @@
 #define OMEGA_H_INDSET_INLINE_HPP
 
 #include <Omega_h_array_ops.hpp>
+#include <Omega_h_dist.hpp>
 #include <Omega_h_for.hpp>
 #include <Omega_h_indset.hpp>
+#include <Omega_h_map.hpp>
 #include <Omega_h_mesh.hpp>
 
 namespace Omega_h {
@@ -11,12 +13,14 @@ namespace indset {
 
 enum { NOT_IN, IN, UNKNOWN };
 
+/* (new_state) is written in full, so the caller can
+   alternate between two buffers instead of copying every round */
 template <class Compare>
-inline Read<I8> local_iteration(
-    LOs xadj, LOs adj, Read<I8> old_state, Compare compare) {
+inline void local_iteration(LOs xadj, LOs adj, Read<I8> old_state,
+    Write<I8> new_state, Compare compare) {
   auto n = xadj.size() - 1;
-  Write<I8> new_state = deep_copy(old_state);
   auto f = OMEGA_H_LAMBDA(LO v) {
+    new_state[v] = old_state[v];
     if (old_state[v] != UNKNOWN) return;
     auto begin = xadj[v];
     auto end = xadj[v + 1];
@@ -39,15 +43,29 @@ inline Read<I8> local_iteration(
     new_state[v] = IN;
   };
   parallel_for(n, std::move(f));
-  return new_state;
 }
 
-template <class Compare>
-Read<I8> iteration(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> old_state,
-    Compare compare) {
-  auto local_state = local_iteration(xadj, adj, old_state, compare);
-  auto synced_state = mesh->sync_array(dim, local_state, 1);
-  return synced_state;
+/* the states of entities that only exist on this MPI rank need no
+   communication, so the iterations only synchronize the entities on
+   partition boundaries, with a Dist from their owners built once.
+   returns an invalid Dist if nothing is shared */
+inline Dist get_boundary_dist(Mesh* mesh, Int dim, LOs* p_shared2ents) {
+  if (!mesh->could_be_shared(dim)) return Dist();
+  auto rank = mesh->comm()->rank();
+  auto owners = mesh->ask_owners(dim);
+  auto owners2copies = mesh->ask_dist(dim).invert().roots2items();
+  auto nents = mesh->nents(dim);
+  Write<I8> ents_are_shared(nents);
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    ents_are_shared[e] = (owners.ranks[e] != rank) ||
+                         (owners2copies[e + 1] - owners2copies[e] > 1);
+  };
+  parallel_for(nents, f, "get_boundary_dist");
+  auto shared2ents = collect_marked(read(ents_are_shared));
+  auto shared_owners = Remotes(read(unmap(shared2ents, owners.ranks, 1)),
+      unmap(shared2ents, owners.idxs, 1));
+  *p_shared2ents = shared2ents;
+  return Dist(mesh->comm(), shared_owners, nents).invert();
 }
 
 template <class Compare>
@@ -55,18 +73,25 @@ Read<I8> find(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> candidates,
     Compare compare) {
   auto n = xadj.size() - 1;
   OMEGA_H_CHECK(candidates.size() == n);
-  auto initial_state = Write<I8>(n);
+  Write<I8> state(n);
   auto f = OMEGA_H_LAMBDA(LO i) {
     if (candidates[i])
-      initial_state[i] = UNKNOWN;
+      state[i] = UNKNOWN;
     else
-      initial_state[i] = NOT_IN;
+      state[i] = NOT_IN;
   };
   parallel_for(n, f);
   auto comm = mesh->comm();
-  auto state = Read<I8>(initial_state);
-  while (get_max(comm, state) == UNKNOWN) {
-    state = iteration(mesh, dim, xadj, adj, state, compare);
+  LOs shared2ents;
+  auto owners2shared = get_boundary_dist(mesh, dim, &shared2ents);
+  Write<I8> next_state(n);
+  while (get_max(comm, read(state)) == UNKNOWN) {
+    local_iteration(xadj, adj, read(state), next_state, compare);
+    if (shared2ents.exists()) {
+      auto shared_states = owners2shared.exch(read(next_state), 1);
+      map_into(shared_states, shared2ents, next_state, 1);
+    }
+    std::swap(state, next_state);
   }
   return state;
 }
@@ -158,4 +158,115 @@ ReaderTablesPtr build_reader_tables(Language const& language) {
   return ReaderTablesPtr(new ReaderTables({parser, lexer, indent_info}));
 }
 
+/* 64-bit FNV-1a over every token and production, each string followed by
+   a separator byte so that adjacent strings can't run together */
+std::uint64_t get_fingerprint(Language const& language) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](std::string const& s) {
+    for (char c : s) {
+      hash ^= std::uint64_t(static_cast<unsigned char>(c));
+      hash *= 1099511628211ULL;
+    }
+    hash ^= 0xFF;
+    hash *= 1099511628211ULL;
+  };
+  for (auto& token : language.tokens) {
+    mix(token.name);
+    mix(token.regex);
+  }
+  for (auto& prod : language.productions) {
+    mix(prod.lhs);
+    for (auto& symb : prod.rhs) mix(symb);
+    mix("");
+  }
+  return hash;
+}
+
+static int encode_action(Action const& action) {
+  if (action.kind == ACTION_SHIFT) return action.next_state + 1;
+  if (action.kind == ACTION_REDUCE) return -(action.production + 1);
+  return 0;
+}
+
+static Action decode_action(int code) {
+  Action action;
+  if (code > 0) {
+    action.kind = ACTION_SHIFT;
+    action.next_state = code - 1;
+  } else if (code < 0) {
+    action.kind = ACTION_REDUCE;
+    action.production = -code - 1;
+  } else {
+    action.kind = ACTION_NONE;
+    action.next_state = -1;
+  }
+  return action;
+}
+
+ReaderTablesPtr get_compiled_reader_tables(
+    std::string const& name, Language const& language) {
+  auto compiled = find_compiled_reader_tables(name);
+  if (!compiled || compiled->fingerprint != get_fingerprint(language)) {
+    return ReaderTablesPtr();
+  }
+  auto grammar = build_grammar(language);
+  auto parser = Parser(grammar, compiled->nparser_states);
+  auto nactions = compiled->nparser_states * grammar->nterminals;
+  parser.terminal_table.data.reserve(std::size_t(nactions));
+  for (int i = 0; i < nactions; ++i) {
+    parser.terminal_table.data.push_back(
+        decode_action(compiled->parser_actions[i]));
+  }
+  auto ngotos = compiled->nparser_states * get_nnonterminals(*grammar);
+  parser.nonterminal_table.data.assign(
+      compiled->parser_gotos, compiled->parser_gotos + ngotos);
+  auto lexer =
+      FiniteAutomaton(compiled->nlexer_symbols, true, compiled->nlexer_states);
+  auto ntransitions = compiled->nlexer_states * compiled->nlexer_symbols;
+  lexer.table.data.assign(compiled->lexer_transitions,
+      compiled->lexer_transitions + ntransitions);
+  lexer.accepted_tokens.assign(compiled->lexer_accepts,
+      compiled->lexer_accepts + compiled->nlexer_states);
+  return ReaderTablesPtr(
+      new ReaderTables({parser, lexer, compiled->indent_info}));
+}
+
+template <typename T, typename Encode>
+static void write_compiled_array(std::ostream& os, std::string const& name,
+    std::vector<T> const& data, Encode encode) {
+  os << "static int const " << name << "[] = {";
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    if (i % 16 == 0) os << "\n   ";
+    os << ' ' << encode(data[i]) << ',';
+  }
+  os << "\n};\n";
+}
+
+void write_compiled_reader_tables(std::ostream& os, std::string const& name,
+    Language const& language, ReaderTables const& tables) {
+  OMEGA_H_CHECK(get_determinism(tables.lexer));
+  auto as_int = [](int x) { return x; };
+  write_compiled_array(os, name + "_parser_actions",
+      tables.parser.terminal_table.data, encode_action);
+  write_compiled_array(
+      os, name + "_parser_gotos", tables.parser.nonterminal_table.data, as_int);
+  write_compiled_array(
+      os, name + "_lexer_transitions", tables.lexer.table.data, as_int);
+  write_compiled_array(
+      os, name + "_lexer_accepts", tables.lexer.accepted_tokens, as_int);
+  auto& indent = tables.indent_info;
+  os << "static CompiledReaderTables const " << name << "_tables = {\n";
+  os << "    \"" << name << "\",\n";
+  os << "    0x" << std::hex << get_fingerprint(language) << std::dec
+     << "ULL,\n";
+  os << "    " << get_nstates(tables.parser) << ", " << name
+     << "_parser_actions, " << name << "_parser_gotos,\n";
+  os << "    " << get_nstates(tables.lexer) << ", "
+     << get_nsymbols(tables.lexer) << ", " << name << "_lexer_transitions, "
+     << name << "_lexer_accepts,\n";
+  os << "    {" << (indent.is_sensitive ? "true" : "false") << ", "
+     << indent.indent_token << ", " << indent.dedent_token << ", "
+     << indent.newline_token << "}};\n\n";
+}
+
 }  // namespace Omega_h
@@ -1,6 +1,7 @@
 #ifndef OMEGA_H_LANGUAGE_HPP
 #define OMEGA_H_LANGUAGE_HPP
 
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -33,6 +34,35 @@ FiniteAutomaton build_lexer(Language const& language);
 
 ReaderTablesPtr build_reader_tables(Language const& language);
 
+/* Reader tables of the built-in languages are generated at build time
+   by osh_reader_tables and compiled into the library as constant data.
+   Parser actions are encoded as 0 for none, next_state + 1 for a shift
+   and -(production + 1) for a reduction. */
+struct CompiledReaderTables {
+  char const* name;
+  std::uint64_t fingerprint;
+  int nparser_states;
+  int const* parser_actions;
+  int const* parser_gotos;
+  int nlexer_states;
+  int nlexer_symbols;
+  int const* lexer_transitions;
+  int const* lexer_accepts;
+  IndentInfo indent_info;
+};
+
+std::uint64_t get_fingerprint(Language const& language);
+/* defined by the generated source, returns null if there is no entry */
+CompiledReaderTables const* find_compiled_reader_tables(
+    std::string const& name);
+/* returns null if the named tables were not compiled in or were
+   generated from a different version of the language, in which case
+   the caller should fall back to build_reader_tables() */
+ReaderTablesPtr get_compiled_reader_tables(
+    std::string const& name, Language const& language);
+void write_compiled_reader_tables(std::ostream& os, std::string const& name,
+    Language const& language, ReaderTables const& tables);
+
 std::ostream& operator<<(std::ostream& os, Language const& lang);
 
 }  // namespace Omega_h
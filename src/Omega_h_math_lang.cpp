@@ -102,8 +102,9 @@ ReaderTablesPtr ask_reader_tables() {
 #pragma clang diagnostic pop
 #endif
   if (ptr.use_count() == 0) {
-    LanguagePtr lang = ask_language();
-    ptr = build_reader_tables(*lang);
+    auto lang = ask_language();
+    ptr = get_compiled_reader_tables("math_lang", *lang);
+    if (!ptr) ptr = build_reader_tables(*lang);
   }
   return ptr;
 }
@@ -1,6 +1,7 @@
 #include "Omega_h_migrate.hpp"
 
 #include <iostream>
+#include <vector>
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_element.hpp"
@@ -122,82 +123,128 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
   }
 }
 
+/* the arrays of all tags of one type are interleaved into a single
+ * array so that a migration costs one exchange per type rather than
+ * one exchange per tag */
+template <typename T>
+static std::vector<Read<T>> exch_tags(Mesh* old_mesh, Int ent_dim,
+    std::vector<Int> const& tag_idxs, Dist old_owners2new_ents) {
+  std::vector<Read<T>> out;
+  if (tag_idxs.empty()) return out;
+  if (tag_idxs.size() == 1) {
+    auto tag = as<T>(old_mesh->get_tag(ent_dim, tag_idxs[0]));
+    out.push_back(old_owners2new_ents.exch(tag->array(), tag->ncomps()));
+    return out;
+  }
+  auto nold_ents = old_mesh->nents(ent_dim);
+  Int width = 0;
+  for (auto i : tag_idxs) width += old_mesh->get_tag(ent_dim, i)->ncomps();
+  Write<T> old_packed(nold_ents * width);
+  Int offset = 0;
+  for (auto i : tag_idxs) {
+    auto tag = as<T>(old_mesh->get_tag(ent_dim, i));
+    auto ncomps = tag->ncomps();
+    auto array = tag->array();
+    OMEGA_H_CHECK(array.size() == nold_ents * ncomps);
+    auto f = OMEGA_H_LAMBDA(LO ent) {
+      for (Int c = 0; c < ncomps; ++c) {
+        old_packed[ent * width + offset + c] = array[ent * ncomps + c];
+      }
+    };
+    parallel_for(nold_ents, f, "pack_tags");
+    offset += ncomps;
+  }
+  auto new_packed = old_owners2new_ents.exch(Read<T>(old_packed), width);
+  auto nnew_ents = divide_no_remainder(new_packed.size(), width);
+  offset = 0;
+  for (auto i : tag_idxs) {
+    auto ncomps = old_mesh->get_tag(ent_dim, i)->ncomps();
+    Write<T> array(nnew_ents * ncomps);
+    auto f = OMEGA_H_LAMBDA(LO ent) {
+      for (Int c = 0; c < ncomps; ++c) {
+        array[ent * ncomps + c] = new_packed[ent * width + offset + c];
+      }
+    };
+    parallel_for(nnew_ents, f, "unpack_tags");
+    out.push_back(array);
+    offset += ncomps;
+  }
+  return out;
+}
+
+template <typename T>
+static void convert_rc_tags_to_mesh(Mesh* mesh, Int ent_dim) {
+  if (!mesh->nents(ent_dim)) return;
+  for (Int i = 0; i < mesh->ntags(ent_dim); ++i) {
+    auto tag = mesh->get_tag(ent_dim, i);
+    if (!is<T>(tag)) continue;
+    //TODO call this after creating a new flag to check if conversion is
+    // needed
+    if (tag->name().find("_rc") == std::string::npos) continue;
+    mesh->change_tagToMesh<T>(
+        ent_dim, tag->ncomps(), tag->name(), tag->class_ids());
+  }
+}
+
+template <typename T>
+static void add_pushed_tag(Mesh* new_mesh, Int ent_dim, TagBase const* tag,
+    std::vector<Read<T>> const& arrays, size_t* next) {
+  new_mesh->add_tag<T>(
+      ent_dim, tag->name(), tag->ncomps(), arrays[(*next)++], true);
+}
+
 void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
     Dist old_owners2new_ents) {
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
+  convert_rc_tags_to_mesh<I8>(old_mesh, ent_dim);
+  convert_rc_tags_to_mesh<I32>(old_mesh, ent_dim);
+  convert_rc_tags_to_mesh<I64>(old_mesh, ent_dim);
+  convert_rc_tags_to_mesh<Real>(old_mesh, ent_dim);
+  std::vector<Int> idxs[4];
   for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
     auto tag = old_mesh->get_tag(ent_dim, i);
-    auto const& name = tag->name();
+    if (is<I8>(tag)) idxs[0].push_back(i);
+    else if (is<I32>(tag)) idxs[1].push_back(i);
+    else if (is<I64>(tag)) idxs[2].push_back(i);
+    else if (is<Real>(tag)) idxs[3].push_back(i);
+  }
+  auto i8_arrays = exch_tags<I8>(old_mesh, ent_dim, idxs[0], old_owners2new_ents);
+  auto i32_arrays =
+      exch_tags<I32>(old_mesh, ent_dim, idxs[1], old_owners2new_ents);
+  auto i64_arrays =
+      exch_tags<I64>(old_mesh, ent_dim, idxs[2], old_owners2new_ents);
+  auto real_arrays =
+      exch_tags<Real>(old_mesh, ent_dim, idxs[3], old_owners2new_ents);
+  size_t next[4] = {0, 0, 0, 0};
+  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    if (is<I8>(tag)) {
+      add_pushed_tag(new_mesh, ent_dim, tag, i8_arrays, &next[0]);
+    } else if (is<I32>(tag)) {
+      add_pushed_tag(new_mesh, ent_dim, tag, i32_arrays, &next[1]);
+    } else if (is<I64>(tag)) {
+      add_pushed_tag(new_mesh, ent_dim, tag, i64_arrays, &next[2]);
+    } else if (is<Real>(tag)) {
+      add_pushed_tag(new_mesh, ent_dim, tag, real_arrays, &next[3]);
+    }
+  }
+  /* classification tags are all in place now, so boundary fields can be
+   * restricted back to their classified entities */
+  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    if (tag->name().find("_rc") == std::string::npos) continue;
     auto ncomps = tag->ncomps();
+    auto const& name = tag->name();
     auto class_ids = tag->class_ids();
-
     if (is<I8>(tag)) {
-
-      //TODO call this after creating a new flag to check if conversion is
-      // needed
-      size_t found = name.find("_rc");
-      if (found != std::string::npos) {
-        if (old_mesh->nents(ent_dim)) 
-          old_mesh->change_tagToMesh<I8> (ent_dim, ncomps, name, class_ids);
-      }
-
-      auto array = as<I8>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I8>(ent_dim, tag->name(), tag->ncomps(), array, true);
-
-      if (found != std::string::npos) {
-        new_mesh->change_tagTorc<I8> (ent_dim, ncomps, name, class_ids);
-      }
-
+      new_mesh->change_tagTorc<I8>(ent_dim, ncomps, name, class_ids);
     } else if (is<I32>(tag)) {
-
-      size_t found = (tag->name()).find("_rc");
-      if (found != std::string::npos) {
-        if (old_mesh->nents(ent_dim)) 
-          old_mesh->change_tagToMesh<I32> (ent_dim, ncomps, name, class_ids);
-      }
-
-      auto array = as<I32>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I32>(ent_dim, tag->name(), tag->ncomps(), array, true);
-
-      if (found != std::string::npos) {
-        new_mesh->change_tagTorc<I32> (ent_dim, ncomps, name, class_ids);
-      }
-
+      new_mesh->change_tagTorc<I32>(ent_dim, ncomps, name, class_ids);
     } else if (is<I64>(tag)) {
-
-      size_t found = (tag->name()).find("_rc");
-      if (found != std::string::npos) {
-        if (old_mesh->nents(ent_dim)) 
-          old_mesh->change_tagToMesh<I64> (ent_dim, ncomps, name, class_ids);
-      }
-
-      auto array = as<I64>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I64>(ent_dim, tag->name(), tag->ncomps(), array, true);
-
-      if (found != std::string::npos) {
-        new_mesh->change_tagTorc<I64> (ent_dim, ncomps, name, class_ids);
-      }
-
+      new_mesh->change_tagTorc<I64>(ent_dim, ncomps, name, class_ids);
     } else if (is<Real>(tag)) {
-
-      size_t found = (tag->name()).find("_rc");
-      if (found != std::string::npos) {
-        if (old_mesh->nents(ent_dim)) 
-          old_mesh->change_tagToMesh<Real> (ent_dim, ncomps, name, class_ids);
-      }
-
-      auto array = as<Real>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<Real>(ent_dim, tag->name(), tag->ncomps(), array, true);
-
-      if (found != std::string::npos) {
-        new_mesh->change_tagTorc<Real> (ent_dim, ncomps, name, class_ids);
-      }
-
+      new_mesh->change_tagTorc<Real>(ent_dim, ncomps, name, class_ids);
     }
   }
 }
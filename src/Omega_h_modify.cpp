@@ -83,21 +83,35 @@ static Remotes get_prod_owners_shared(Mesh* mesh, Few<LOs, 4> mods2mds,
   Write<LO> prod_own_idxs(nprods);
   for (Int mod_dim = 0; mod_dim < 4; ++mod_dim) {
     if (!mods2prods[mod_dim].exists()) continue;
-    auto prod_begin = mods2prods[mod_dim].first();
-    auto prod_end = mods2prods[mod_dim].last();
     auto nmods = mods2prods[mod_dim].size() - 1;
-    auto nmod_prods = prod_end - prod_begin;
-    /* assuming the number of products per split entity is constant! */
-    LO nprods_per_mod;
-    if (nmods == 0) nprods_per_mod = 0;
-    else nprods_per_mod = divide_no_remainder(nmod_prods, nmods);
-    nprods_per_mod = mesh->comm()->allreduce(nprods_per_mod, OMEGA_H_MAX);
+    /* the number of products may vary between modified entities,
+       so each one syncs a padded row of (width) product indices */
+    auto mods2nprods = get_degrees(mods2prods[mod_dim]);
+    auto width = (nmods == 0) ? LO(0) : get_max(mods2nprods);
+    width = mesh->comm()->allreduce(width, OMEGA_H_MAX);
+    if (width == 0) continue;
     auto md_ranks = mesh->ask_owners(mod_dim).ranks;
     auto mod_ranks = read(unmap(mods2mds[mod_dim], md_ranks, 1));
-    auto mod_prod_idxs = unmap_range(prod_begin, prod_end, prods2new_ents, 1);
-    mod_prod_idxs = mesh->sync_subset_array(
-        mod_dim, mod_prod_idxs, mods2mds[mod_dim], -1, nprods_per_mod);
-    map_into_range(mod_prod_idxs, prod_begin, prod_end, prod_own_idxs, 1);
+    auto mods2prods_dim = mods2prods[mod_dim];
+    Write<LO> mod_prod_idxs_w(nmods * width, -1);
+    auto pad = OMEGA_H_LAMBDA(LO mod) {
+      for (auto prod = mods2prods_dim[mod]; prod < mods2prods_dim[mod + 1];
+           ++prod) {
+        mod_prod_idxs_w[mod * width + (prod - mods2prods_dim[mod])] =
+            prods2new_ents[prod];
+      }
+    };
+    parallel_for(nmods, pad, "get_prod_owners_shared(pad)");
+    auto mod_prod_idxs = mesh->sync_subset_array(
+        mod_dim, LOs(mod_prod_idxs_w), mods2mds[mod_dim], -1, width);
+    auto unpad = OMEGA_H_LAMBDA(LO mod) {
+      for (auto prod = mods2prods_dim[mod]; prod < mods2prods_dim[mod + 1];
+           ++prod) {
+        prod_own_idxs[prod] =
+            mod_prod_idxs[mod * width + (prod - mods2prods_dim[mod])];
+      }
+    };
+    parallel_for(nmods, unpad, "get_prod_owners_shared(unpad)");
     expand_into(mod_ranks, mods2prods[mod_dim], prod_own_ranks, 1);
   }
   return {prod_own_ranks, prod_own_idxs};
@@ -356,22 +370,20 @@ void assign_new_numbering(Read<T> old_ents2new_numbers,
     if (mods2prods[mod_dim].exists()) nprods = mods2prods[mod_dim].last();
   }
   Write<T> prods2new_offsets_w(nprods);
+  /* a representative that stays in the new mesh numbers itself
+     before the products it represents. modified entities that are kept
+     (AMR refinement) always do, otherwise it depends on the representative,
+     e.g. an edge representing the products of a split face may be split
+     itself */
+  auto old_ents_are_same =
+      keep_mods ? Read<I8>()
+                : mark_image(same_ents2old_ents, old_ents2new_numbers.size());
   for (Int mod_dim = 0; mod_dim < 4; ++mod_dim) {
     if (!mods2prods[mod_dim].exists()) continue;
     auto mods2new_offsets = unmap(mods2reps[mod_dim], old_ents2new_numbers, 1);
     auto nmods = mods2reps[mod_dim].size();
     OMEGA_H_CHECK(nmods == mods2prods[mod_dim].size() - 1);
-    Int rep_self_count;
-    if (keep_mods) {
-      /* currently we only keep modified entities in the case of AMR refinement
-       */
-      rep_self_count = 1;
-    } else {
-      /* if modified entities aren't being kept, I assume we're doing simplex
-         adaptation, in which case representatives counting themselves should
-         only happen if we're splitting simplex edges. This is a HACK */
-      rep_self_count = (rep2md_order[mod_dim].exists() ? 1 : 0);
-    }
+    auto mods2reps_dim = mods2reps[mod_dim];
     auto mods2prods_dim = mods2prods[mod_dim];
     auto mods2mds_dim = mods2mds[mod_dim];
     if (rep2md_order[mod_dim].exists()) {
@@ -382,6 +394,8 @@ void assign_new_numbering(Read<T> old_ents2new_numbers,
         auto md = mods2mds_dim[mod];
         auto md_order = rep2md_order_dim[md];
         OMEGA_H_CHECK(md_order >= 0);
+        auto rep_self_count =
+            keep_mods ? 1 : old_ents_are_same[mods2reps_dim[mod]];
         auto offset = mods2new_offsets[mod] + md_order + rep_self_count;
         for (auto prod = mods2prods_dim[mod]; prod < mods2prods_dim[mod + 1];
              ++prod) {
@@ -391,6 +405,8 @@ void assign_new_numbering(Read<T> old_ents2new_numbers,
       parallel_for(nmods, std::move(write_prod_offsets));
     } else {
       auto write_prod_offsets = OMEGA_H_LAMBDA(LO mod) {
+        auto rep_self_count =
+            keep_mods ? 1 : old_ents_are_same[mods2reps_dim[mod]];
         auto offset = mods2new_offsets[mod] + rep_self_count;
         for (auto prod = mods2prods_dim[mod]; prod < mods2prods_dim[mod + 1];
              ++prod) {
@@ -541,4 +557,49 @@ void set_owners_by_indset(
   mesh->set_owners(elem_dim, elem_owners);
 }
 
+Read<I8> set_owners_by_colors(Mesh* mesh, Int key_dim, Read<I8> kd_colors) {
+  if (mesh->comm()->size() == 1) return kd_colors;
+  auto kd_owners = mesh->ask_owners(key_dim);
+  auto elem_dim = mesh->dim();
+  auto elems2kds = mesh->ask_down(elem_dim, key_dim).ab2b;
+  auto nkds_per_elem = element_degree(mesh->family(), elem_dim, key_dim);
+  auto elem_owners = mesh->ask_owners(elem_dim);
+  auto elems2owners = mesh->ask_dist(elem_dim);
+  auto new_elem_ranks = deep_copy(elem_owners.ranks);
+  auto f = OMEGA_H_LAMBDA(LO elem) {
+    I8 min_color = -1;
+    for (Int elem_kd = 0; elem_kd < nkds_per_elem; ++elem_kd) {
+      auto kd = elems2kds[elem * nkds_per_elem + elem_kd];
+      auto color = kd_colors[kd];
+      if (color < 0 || (min_color >= 0 && color >= min_color)) continue;
+      min_color = color;
+      new_elem_ranks[elem] = kd_owners.ranks[kd];
+    }
+  };
+  parallel_for(mesh->nents(elem_dim), f, "set_owners_by_colors");
+  auto kds2elems = mesh->ask_up(key_dim, elem_dim);
+  auto kds2kd_elems = kds2elems.a2ab;
+  auto kd_elems2elems = kds2elems.ab2b;
+  auto new_kd_colors = Write<I8>(mesh->nents(key_dim));
+  auto g = OMEGA_H_LAMBDA(LO kd) {
+    auto color = kd_colors[kd];
+    auto begin = kds2kd_elems[kd];
+    auto end = kds2kd_elems[kd + 1];
+    if (color > 0) {
+      for (auto kd_elem = begin; kd_elem < end; ++kd_elem) {
+        auto elem = kd_elems2elems[kd_elem];
+        if (new_elem_ranks[elem] != new_elem_ranks[kd_elems2elems[begin]]) {
+          color = -1;
+        }
+      }
+    }
+    new_kd_colors[kd] = color;
+  };
+  parallel_for(mesh->nents(key_dim), g, "check_color_cavities");
+  auto out = mesh->sync_array(key_dim, Read<I8>(new_kd_colors), 1);
+  elem_owners = update_ownership(elems2owners, new_elem_ranks);
+  mesh->set_owners(elem_dim, elem_owners);
+  return out;
+}
+
 }  // end namespace Omega_h
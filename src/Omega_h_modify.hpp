@@ -29,6 +29,15 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
 void set_owners_by_indset(
     Mesh* mesh, Int key_dim, LOs keys2kds, Graph kds2elems);
 
+/* kd_colors ranks keys by priority (-1 for non-keys), the keys of
+   color 0 being an independent set, and each key's cavity is its
+   adjacent elements. elements are given to the owner of their
+   lowest-colored key (the first one among equals). keys of positive
+   color whose cavity ends up on several ranks lose their color, so
+   every remaining cavity is whole on one rank after the move to
+   OMEGA_H_ELEM_BASED, also after the color 0 keys are applied there */
+Read<I8> set_owners_by_colors(Mesh* mesh, Int key_dim, Read<I8> kd_colors);
+
 }  // end namespace Omega_h
 
 #endif
@@ -0,0 +1,12 @@
+#include "Omega_h_language.hpp"
+
+namespace Omega_h {
+
+/* linked into osh_reader_tables itself, and into the library when
+   Omega_h_COMPILED_READER_TABLES is off, so that every language
+   builds its tables at runtime */
+CompiledReaderTables const* find_compiled_reader_tables(std::string const&) {
+  return nullptr;
+}
+
+}  // end namespace Omega_h
@@ -3,8 +3,11 @@
 #include <iostream>
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_hypercube.hpp"
 #include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_modify.hpp"
 #include "Omega_h_profile.hpp"
@@ -14,7 +17,7 @@
 
 namespace Omega_h {
 
-static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
+bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto comm = mesh->comm();
   auto edges_are_cands = mesh->get_array<I8>(EDGE, "candidate");
   mesh->remove_tag(EDGE, "candidate");
@@ -26,10 +29,16 @@ static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto edges_are_initial =
       map_onto(cands_are_good, cands2edges, nedges, I8(0), 1);
   auto edge_quals = map_onto(cand_quals, cands2edges, nedges, 0.0, 1);
-  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals, edges_are_initial);
+  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals,
+      edges_are_initial, opts.nindset_quality_buckets);
   mesh->add_tag(EDGE, "key", 1, edges_are_keys);
   mesh->add_tag(EDGE, "rep_vertex2md_order", 1,
       get_rep2md_order_adapt(mesh, EDGE, VERT, edges_are_keys));
+  return true;
+}
+
+void set_refine_owners(Mesh* mesh) {
+  auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
   auto keys2edges = collect_marked(edges_are_keys);
   Graph edges2elems;
   if (mesh->dim() == 1)
@@ -37,7 +46,6 @@ static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   else
     edges2elems = mesh->ask_up(EDGE, mesh->dim());
   set_owners_by_indset(mesh, EDGE, keys2edges, edges2elems);
-  return true;
 }
 
 static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
@@ -91,10 +99,11 @@ static bool refine(Mesh* mesh, AdaptOpts const& opts) {
   mesh->change_all_rcFieldsToMesh();
 
   if (!refine_ghosted(mesh, opts)) return false;
+  set_refine_owners(mesh);
 
   mesh->change_all_rcFieldsTorc();
 
-  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  unghost_for_rebuild(mesh, opts);
 
   mesh->change_all_rcFieldsToMesh();
 
@@ -103,13 +112,168 @@ static bool refine(Mesh* mesh, AdaptOpts const& opts) {
   return true;
 }
 
+/* multi-edge splitting: instead of an independent set, every candidate
+   edge is split unless that makes an element too poor. elements are
+   subdivided by templates (see split_simplex()), and the modified
+   entities are all the edges, faces and elements containing key edges,
+   which can be shared between MPI ranks much like in AMR */
+static bool split_ghosted(Mesh* mesh, AdaptOpts const& opts) {
+  auto comm = mesh->comm();
+  auto elem_dim = mesh->dim();
+  auto edges_are_keys = mesh->get_array<I8>(EDGE, "candidate");
+  mesh->remove_tag(EDGE, "candidate");
+  auto edge_globals = mesh->globals(EDGE);
+  auto edge_lengths = mesh->ask_lengths();
+  /* each poor element gives up the last edge it would split
+     (see split_simplex()) until none are poor */
+  while (elem_dim > EDGE) {
+    auto elems_are_cands = mark_up(mesh, EDGE, elem_dim, edges_are_keys);
+    auto cands2elems = collect_marked(elems_are_cands);
+    auto cand_quals = split_qualities(mesh, cands2elems, edges_are_keys);
+    auto cands_are_poor = each_lt(cand_quals, opts.min_quality_allowed);
+    if (get_max(comm, cands_are_poor) != 1) break;
+    auto elems2edges = mesh->ask_down(elem_dim, EDGE).ab2b;
+    auto nelem_edges = simplex_degree(elem_dim, EDGE);
+    Write<I8> edges_are_dropped(mesh->nedges(), 0);
+    auto f = OMEGA_H_LAMBDA(LO cand) {
+      if (!cands_are_poor[cand]) return;
+      auto elem = cands2elems[cand];
+      LO last = -1;
+      for (Int ee = 0; ee < nelem_edges; ++ee) {
+        auto edge = elems2edges[elem * nelem_edges + ee];
+        if (edges_are_keys[edge] &&
+            (last == -1 || edge_lengths[edge] < edge_lengths[last] ||
+                (edge_lengths[edge] == edge_lengths[last] &&
+                    edge_globals[edge] > edge_globals[last]))) {
+          last = edge;
+        }
+      }
+      edges_are_dropped[last] = 1;
+    };
+    parallel_for(cands2elems.size(), f, "split_ghosted");
+    auto dropped = mesh->sync_array(EDGE, Read<I8>(edges_are_dropped), 1);
+    edges_are_keys = land_each(edges_are_keys, invert_marks(dropped));
+  }
+  if (get_max(comm, edges_are_keys) != 1) return false;
+  mesh->add_tag(EDGE, "key", 1, edges_are_keys);
+  Few<LOs, 4> mods2mds;
+  for (Int mod_dim = EDGE; mod_dim <= elem_dim; ++mod_dim) {
+    auto mds_are_mods = (mod_dim == EDGE)
+                            ? edges_are_keys
+                            : mark_up(mesh, EDGE, mod_dim, edges_are_keys);
+    mods2mds[mod_dim] = collect_marked(mds_are_mods);
+  }
+  for (Int prod_dim = VERT; prod_dim < elem_dim; ++prod_dim) {
+    Few<LOs, 4> mods2nprods;
+    Few<bool, 4> mods_have_prods;
+    for (Int mod_dim = 0; mod_dim < 4; ++mod_dim) {
+      mods_have_prods[mod_dim] = (EDGE <= mod_dim && mod_dim <= elem_dim);
+      if (!mods_have_prods[mod_dim]) continue;
+      mods2nprods[mod_dim] = count_split_products(
+          mesh, mod_dim, prod_dim, mods2mds[mod_dim], edges_are_keys);
+    }
+    auto rep2md_orders = get_rep2md_order(
+        mesh, prod_dim, mods2mds, mods2nprods, mods_have_prods);
+    auto name =
+        std::string("rep_") + hypercube_singular_name(prod_dim) + "2md_order";
+    for (Int mod_dim = prod_dim + 1; mod_dim <= elem_dim; ++mod_dim) {
+      mesh->add_tag(mod_dim, name, 1, rep2md_orders[mod_dim]);
+    }
+  }
+  return true;
+}
+
+static void split_element_based(Mesh* mesh, AdaptOpts const& opts) {
+  auto comm = mesh->comm();
+  auto elem_dim = mesh->dim();
+  auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
+  Few<Bytes, 4> mds_are_mods;
+  Few<LOs, 4> mods2mds;
+  for (Int mod_dim = EDGE; mod_dim <= elem_dim; ++mod_dim) {
+    mds_are_mods[mod_dim] = (mod_dim == EDGE)
+                                ? edges_are_keys
+                                : mark_up(mesh, EDGE, mod_dim, edges_are_keys);
+    mods2mds[mod_dim] = collect_marked(mds_are_mods[mod_dim]);
+  }
+  auto ntotal_keys =
+      get_sum(comm, land_each(edges_are_keys, mesh->owned(EDGE)));
+  if (opts.verbosity >= EACH_REBUILD && comm->rank() == 0) {
+    std::cout << "splitting " << ntotal_keys << " edges\n";
+  }
+  auto new_mesh = mesh->copy_meta();
+  auto edges2midverts = LOs();
+  auto old_verts2new_verts = LOs();
+  auto old_lows2new_lows = LOs();
+  for (Int prod_dim = VERT; prod_dim <= elem_dim; ++prod_dim) {
+    Few<LOs, 4> mods2prods;
+    auto prod_verts2verts = LOs();
+    LO offset = 0;
+    for (Int mod_dim = max2(Int(EDGE), prod_dim); mod_dim <= elem_dim;
+         ++mod_dim) {
+      auto mod_prods = LOs();
+      auto mod_prod_verts2verts = LOs();
+      split_products(mesh, mod_dim, prod_dim, mods2mds[mod_dim],
+          edges_are_keys, edges2midverts, old_verts2new_verts, mod_prods,
+          mod_prod_verts2verts);
+      mods2prods[mod_dim] = add_to_each(mod_prods, offset);
+      offset = mods2prods[mod_dim].last();
+      if (prod_dim != VERT) {
+        prod_verts2verts = (mod_dim == prod_dim)
+                               ? mod_prod_verts2verts
+                               : LOs(concat(prod_verts2verts,
+                                     mod_prod_verts2verts));
+      }
+    }
+    auto prods2new_ents = LOs();
+    auto same_ents2old_ents = LOs();
+    auto same_ents2new_ents = LOs();
+    auto old_ents2new_ents = LOs();
+    modify_ents(mesh, &new_mesh, prod_dim, mods2mds, mds_are_mods, mods2prods,
+        prod_verts2verts, old_lows2new_lows, /*keep_mods*/ false,
+        /*mods_can_be_shared*/ true, &prods2new_ents, &same_ents2old_ents,
+        &same_ents2new_ents, &old_ents2new_ents);
+    if (prod_dim == VERT) {
+      edges2midverts =
+          map_onto(prods2new_ents, mods2mds[EDGE], mesh->nedges(), -1, 1);
+      old_verts2new_verts = old_ents2new_ents;
+    }
+    transfer_split(mesh, opts.xfer_opts, &new_mesh, mods2mds, mods2prods,
+        prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+    old_lows2new_lows = old_ents2new_ents;
+  }
+  *mesh = new_mesh;
+}
+
+static bool split(Mesh* mesh, AdaptOpts const& opts) {
+  mesh->change_all_rcFieldsTorc();
+  mesh->set_parting(OMEGA_H_GHOSTED);
+  mesh->change_all_rcFieldsToMesh();
+  if (!split_ghosted(mesh, opts)) return false;
+  mesh->change_all_rcFieldsTorc();
+  unghost_for_rebuild(mesh, opts);
+  mesh->change_all_rcFieldsToMesh();
+  split_element_based(mesh, opts);
+  return true;
+}
+
 bool refine_by_size(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
-  auto edge_is_cand = each_gt(lengths, opts.max_length_desired);
-  if (get_max(comm, edge_is_cand) != 1) return false;
+  auto cands2edges = get_length_candidates(mesh, opts);
+  auto cand_lengths = read(unmap(cands2edges, lengths, 1));
+  auto cand_is_long = each_gt(cand_lengths, opts.max_length_desired);
+  if (get_max(comm, cand_is_long) != 1) return false;
+  auto edge_is_cand =
+      map_onto(cand_is_long, cands2edges, mesh->nedges(), I8(0), 1);
   mesh->add_tag(EDGE, "candidate", 1, edge_is_cand);
+  /* the split templates have no conservative or user transfer */
+  auto xfer_opts = opts.xfer_opts;
+  if (opts.should_refine_multiple_edges && !xfer_opts.user_xfer &&
+      !should_conserve_any(mesh, xfer_opts) &&
+      !has_momentum_velocity(mesh, xfer_opts)) {
+    return split(mesh, opts);
+  }
   return refine(mesh, opts);
 }
 
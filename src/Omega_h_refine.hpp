@@ -5,6 +5,11 @@
 
 namespace Omega_h {
 
+/* on a ghosted mesh, turns the EDGE "candidate" tag into an independent
+   set of split keys (the EDGE "key" tag). returns false if none qualify */
+bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts);
+void set_refine_owners(Mesh* mesh);
+
 bool refine_by_size(Mesh* mesh, AdaptOpts const& opts);
 
 }  // end namespace Omega_h
@@ -2,6 +2,7 @@
 
 #include "Omega_h_align.hpp"
 #include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_metric.hpp"
 #include "Omega_h_quality.hpp"
 #include "Omega_h_refine_topology.hpp"
@@ -106,4 +107,83 @@ Reals refine_qualities(Mesh* mesh, LOs candidates) {
   OMEGA_H_NORETURN(Reals());
 }
 
+template <Int mesh_dim, Int metric_dim>
+Reals split_qualities_tmpl(
+    Mesh* mesh, LOs cands2elems, Read<I8> edges_are_keys) {
+  auto vert_metrics = mesh->get_array<Real>(VERT, "metric");
+  auto keys2edges = collect_marked(edges_are_keys);
+  auto edge_metrics =
+      map_onto(get_mident_metrics(mesh, EDGE, keys2edges, vert_metrics),
+          keys2edges, mesh->nedges(), 0.0, symm_ncomps(metric_dim));
+  auto cv2v = mesh->ask_verts_of(mesh_dim);
+  auto c2e = mesh->ask_down(mesh_dim, EDGE).ab2b;
+  auto edge_globals = mesh->globals(EDGE);
+  auto edge_lengths = mesh->ask_lengths();
+  auto coords = mesh->coords();
+  auto ncands = cands2elems.size();
+  Write<Real> quals_w(ncands);
+  auto f = OMEGA_H_LAMBDA(LO cand) {
+    auto c = cands2elems[cand];
+    constexpr auto nedges = SplitTemplate<mesh_dim>::nedges;
+    Few<GO, nedges> globals;
+    Few<Real, nedges> lengths;
+    for (Int ce = 0; ce < nedges; ++ce) {
+      auto e = c2e[c * nedges + ce];
+      globals[ce] = edges_are_keys[e] ? edge_globals[e] : GO(-1);
+      lengths[ce] = edge_lengths[e];
+    }
+    auto t = split_simplex<mesh_dim>(globals, lengths);
+    /* points and metrics of the template vertices */
+    Few<Vector<mesh_dim>, mesh_dim + 1 + nedges> tp;
+    Few<Matrix<metric_dim, metric_dim>, mesh_dim + 1 + nedges> tm;
+    for (Int cv = 0; cv <= mesh_dim; ++cv) {
+      auto v = cv2v[c * (mesh_dim + 1) + cv];
+      tp[cv] = get_vector<mesh_dim>(coords, v);
+      tm[cv] = get_symm<metric_dim>(vert_metrics, v);
+    }
+    for (Int ce = 0; ce < nedges; ++ce) {
+      if (globals[ce] < 0) continue;
+      auto a = split_edge_vert(mesh_dim, ce, 0);
+      auto b = split_edge_vert(mesh_dim, ce, 1);
+      tp[mesh_dim + 1 + ce] = (tp[a] + tp[b]) / 2.;
+      tm[mesh_dim + 1 + ce] =
+          get_symm<metric_dim>(edge_metrics, c2e[c * nedges + ce]);
+    }
+    auto minqual = 1.0;
+    for (Int s = 0; s < t.nsimplices; ++s) {
+      Few<Vector<mesh_dim>, mesh_dim + 1> p;
+      Few<Matrix<metric_dim, metric_dim>, mesh_dim + 1> ms;
+      for (Int sv = 0; sv <= mesh_dim; ++sv) {
+        p[sv] = tp[t.simplices[s][sv]];
+        ms[sv] = tm[t.simplices[s][sv]];
+      }
+      auto m = maxdet_metric(ms);
+      minqual = min2(minqual, metric_element_quality(p, m));
+    }
+    quals_w[cand] = minqual;
+  };
+  parallel_for(ncands, f, "split_qualities");
+  return quals_w;
+}
+
+Reals split_qualities(Mesh* mesh, LOs cands2elems, Read<I8> edges_are_keys) {
+  auto mesh_dim = mesh->dim();
+  auto metric_dim = get_metric_dim(mesh);
+  if (mesh_dim == 3 && metric_dim == 3) {
+    return split_qualities_tmpl<3, 3>(mesh, cands2elems, edges_are_keys);
+  }
+  if (mesh_dim == 2 && metric_dim == 2) {
+    return split_qualities_tmpl<2, 2>(mesh, cands2elems, edges_are_keys);
+  }
+  if (mesh_dim == 3 && metric_dim == 1) {
+    return split_qualities_tmpl<3, 1>(mesh, cands2elems, edges_are_keys);
+  }
+  if (mesh_dim == 2 && metric_dim == 1) {
+    return split_qualities_tmpl<2, 1>(mesh, cands2elems, edges_are_keys);
+  }
+  /* splitting an edge into two edges always gives perfect quality */
+  if (mesh_dim == 1) return Reals(cands2elems.size(), 1.0);
+  OMEGA_H_NORETURN(Reals());
+}
+
 }  // end namespace Omega_h
@@ -9,6 +9,10 @@ class Mesh;
 
 Reals refine_qualities(Mesh* mesh, LOs candidates);
 
+/* the worst quality among the elements that each candidate element
+   (cands2elems) becomes when all of its key edges are split at once */
+Reals split_qualities(Mesh* mesh, LOs cands2elems, Read<I8> edges_are_keys);
+
 }  // end namespace Omega_h
 
 #endif
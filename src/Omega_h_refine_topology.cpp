@@ -202,4 +202,123 @@ void refine_products(Mesh* mesh, Int ent_dim, LOs keys2edges, LOs keys2midverts,
   }
 }
 
+template <Int mod_dim>
+OMEGA_H_DEVICE LO get_split_edge(LO md, LOs mds2edges, Int which_edge) {
+  return (mod_dim == EDGE)
+             ? md
+             : mds2edges[md * SplitTemplate<mod_dim>::nedges + which_edge];
+}
+
+template <Int mod_dim>
+OMEGA_H_DEVICE SplitTemplate<mod_dim> get_split_template(
+    LO md, LOs mds2edges, Read<I8> edges_are_keys, Read<GO> edge_globals,
+    Reals edge_lengths) {
+  Few<GO, SplitTemplate<mod_dim>::nedges> globals;
+  Few<Real, SplitTemplate<mod_dim>::nedges> lengths;
+  for (Int e = 0; e < SplitTemplate<mod_dim>::nedges; ++e) {
+    auto edge = get_split_edge<mod_dim>(md, mds2edges, e);
+    globals[e] = edges_are_keys[edge] ? edge_globals[edge] : GO(-1);
+    lengths[e] = edge_lengths[edge];
+  }
+  return split_simplex<mod_dim>(globals, lengths);
+}
+
+template <Int mod_dim>
+static LOs count_split_products_tmpl(
+    Mesh* mesh, Int prod_dim, LOs mods2mds, Read<I8> edges_are_keys) {
+  auto nmods = mods2mds.size();
+  if (prod_dim > mod_dim) return LOs(nmods, 0);
+  auto mds2edges =
+      (mod_dim == EDGE) ? LOs() : mesh->ask_down(mod_dim, EDGE).ab2b;
+  auto edge_globals = mesh->globals(EDGE);
+  auto edge_lengths = mesh->ask_lengths();
+  Write<LO> counts(nmods);
+  auto f = OMEGA_H_LAMBDA(LO mod) {
+    auto t = get_split_template<mod_dim>(
+        mods2mds[mod], mds2edges, edges_are_keys, edge_globals, edge_lengths);
+    counts[mod] = get_split_products(t, prod_dim).nprods;
+  };
+  parallel_for(nmods, f, "count_split_products");
+  return counts;
+}
+
+LOs count_split_products(Mesh* mesh, Int mod_dim, Int prod_dim,
+    LOs mods2mds, Read<I8> edges_are_keys) {
+  if (mod_dim == 3) {
+    return count_split_products_tmpl<3>(
+        mesh, prod_dim, mods2mds, edges_are_keys);
+  }
+  if (mod_dim == 2) {
+    return count_split_products_tmpl<2>(
+        mesh, prod_dim, mods2mds, edges_are_keys);
+  }
+  if (mod_dim == 1) {
+    return count_split_products_tmpl<1>(
+        mesh, prod_dim, mods2mds, edges_are_keys);
+  }
+  OMEGA_H_NORETURN(LOs());
+}
+
+template <Int mod_dim>
+static void split_products_tmpl(Mesh* mesh, Int prod_dim, LOs mods2mds,
+    Read<I8> edges_are_keys, LOs edges2midverts, LOs old_verts2new_verts,
+    LOs& mods2prods, LOs& prod_verts2verts) {
+  mods2prods = offset_scan(count_split_products_tmpl<mod_dim>(
+      mesh, prod_dim, mods2mds, edges_are_keys));
+  prod_verts2verts = LOs();
+  /* new vertices have no connectivity to build */
+  if (prod_dim == VERT || prod_dim > mod_dim) return;
+  auto nmods = mods2mds.size();
+  auto mds2verts = mesh->ask_verts_of(mod_dim);
+  auto mds2edges =
+      (mod_dim == EDGE) ? LOs() : mesh->ask_down(mod_dim, EDGE).ab2b;
+  auto edge_globals = mesh->globals(EDGE);
+  auto edge_lengths = mesh->ask_lengths();
+  auto nppv = prod_dim + 1;
+  Write<LO> prod_verts2verts_w(mods2prods.last() * nppv);
+  auto f = OMEGA_H_LAMBDA(LO mod) {
+    auto md = mods2mds[mod];
+    auto t = get_split_template<mod_dim>(
+        md, mds2edges, edges_are_keys, edge_globals, edge_lengths);
+    auto p = get_split_products(t, prod_dim);
+    auto prod = mods2prods[mod];
+    for (Int q = 0; q < p.nprods; ++q, ++prod) {
+      for (Int ppv = 0; ppv < nppv; ++ppv) {
+        auto tv = p.prods[q][ppv];
+        LO v;
+        if (tv <= mod_dim) {
+          v = old_verts2new_verts[mds2verts[md * (mod_dim + 1) + tv]];
+        } else {
+          auto edge = get_split_edge<mod_dim>(md, mds2edges, tv - mod_dim - 1);
+          v = edges2midverts[edge];
+        }
+        prod_verts2verts_w[prod * nppv + ppv] = v;
+      }
+    }
+  };
+  parallel_for(nmods, f, "split_products");
+  prod_verts2verts = prod_verts2verts_w;
+}
+
+void split_products(Mesh* mesh, Int mod_dim, Int prod_dim, LOs mods2mds,
+    Read<I8> edges_are_keys, LOs edges2midverts, LOs old_verts2new_verts,
+    LOs& mods2prods, LOs& prod_verts2verts) {
+  if (mod_dim == 3) {
+    split_products_tmpl<3>(mesh, prod_dim, mods2mds, edges_are_keys,
+        edges2midverts, old_verts2new_verts, mods2prods, prod_verts2verts);
+    return;
+  }
+  if (mod_dim == 2) {
+    split_products_tmpl<2>(mesh, prod_dim, mods2mds, edges_are_keys,
+        edges2midverts, old_verts2new_verts, mods2prods, prod_verts2verts);
+    return;
+  }
+  if (mod_dim == 1) {
+    split_products_tmpl<1>(mesh, prod_dim, mods2mds, edges_are_keys,
+        edges2midverts, old_verts2new_verts, mods2prods, prod_verts2verts);
+    return;
+  }
+  OMEGA_H_NORETURN();
+}
+
 }  // end namespace Omega_h
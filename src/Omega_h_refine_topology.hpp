@@ -2,7 +2,9 @@
 #define OMEGA_H_REFINE_TOPOLOGY_HPP
 
 #include <Omega_h_array.hpp>
+#include <Omega_h_few.hpp>
 #include <Omega_h_scalar.hpp>
+#include <Omega_h_simplex.hpp>
 
 namespace Omega_h {
 
@@ -57,6 +59,142 @@ OMEGA_H_INLINE void flip_new_elem(Int dim, T ev[]) {
   if (dim == 3) swap2(ev[1], ev[2]);
 }
 
+/* multi-edge subdivision: a simplex with several key edges is split by
+   bisecting them one at a time, in an order that the whole mesh agrees
+   on. simplices sharing a side then split it the same way, and the
+   result is what a sequence of single-edge splits over the whole mesh
+   would produce.
+   template vertices [0, dim] are the simplex vertices, and
+   (dim + 1 + e) is the midpoint of its edge (e). */
+OMEGA_H_INLINE Int split_edge_vert(Int dim, Int which_edge, Int which_vert) {
+  return (dim == EDGE)
+             ? which_vert
+             : simplex_down_template(dim, EDGE, which_edge, which_vert);
+}
+
+template <Int dim>
+struct SplitTemplate {
+  enum { nedges = simplex_degree(dim, EDGE) };
+  enum { max_simplices = (dim == 3) ? 8 : ((dim == 2) ? 4 : 2) };
+  Int nsimplices;
+  Few<Few<Int, dim + 1>, max_simplices> simplices;
+};
+
+/* edges with a negative global number are not split. longer edges are
+   bisected first, which keeps the quality close to that of single-edge
+   splits, and ties are broken by global number */
+template <Int dim>
+OMEGA_H_INLINE SplitTemplate<dim> split_simplex(
+    Few<GO, SplitTemplate<dim>::nedges> edge_globals,
+    Few<Real, SplitTemplate<dim>::nedges> edge_lengths) {
+  SplitTemplate<dim> t;
+  t.nsimplices = 1;
+  for (Int v = 0; v <= dim; ++v) t.simplices[0][v] = v;
+  Few<bool, SplitTemplate<dim>::nedges> todo;
+  for (Int e = 0; e < SplitTemplate<dim>::nedges; ++e) {
+    todo[e] = (edge_globals[e] >= 0);
+  }
+  while (true) {
+    Int best = -1;
+    for (Int e = 0; e < SplitTemplate<dim>::nedges; ++e) {
+      if (!todo[e]) continue;
+      if (best == -1 || edge_lengths[e] > edge_lengths[best] ||
+          (edge_lengths[e] == edge_lengths[best] &&
+              edge_globals[e] < edge_globals[best])) {
+        best = e;
+      }
+    }
+    if (best == -1) break;
+    todo[best] = false;
+    auto a = split_edge_vert(dim, best, 0);
+    auto b = split_edge_vert(dim, best, 1);
+    auto m = dim + 1 + best;
+    auto n = t.nsimplices;
+    for (Int s = 0; s < n; ++s) {
+      Int sa = -1, sb = -1;
+      for (Int sv = 0; sv <= dim; ++sv) {
+        if (t.simplices[s][sv] == a) sa = sv;
+        if (t.simplices[s][sv] == b) sb = sv;
+      }
+      if (sa == -1 || sb == -1) continue;
+      /* replacing one endpoint by the midpoint keeps the orientation */
+      auto& other = t.simplices[t.nsimplices++];
+      other = t.simplices[s];
+      t.simplices[s][sb] = m;
+      other[sa] = m;
+    }
+  }
+  return t;
+}
+
+/* the sides of the simplex containing a template vertex,
+   as a bit mask indexed by the opposite simplex vertex */
+template <Int dim>
+OMEGA_H_INLINE Int split_vert_sides(Int v) {
+  Int all = (Int(1) << (dim + 1)) - 1;
+  if (v <= dim) return all & ~(Int(1) << v);
+  auto e = v - (dim + 1);
+  return all & ~(Int(1) << split_edge_vert(dim, e, 0)) &
+         ~(Int(1) << split_edge_vert(dim, e, 1));
+}
+
+template <Int dim>
+struct SplitProducts {
+  enum { max_prods = 8 };
+  Int nprods;
+  Few<Few<Int, dim + 1>, max_prods> prods;
+};
+
+/* the entities of (prod_dim) in a split simplex that are not on its
+   boundary, in an order that only depends on the template */
+template <Int dim>
+OMEGA_H_INLINE SplitProducts<dim> get_split_products(
+    SplitTemplate<dim> const& t, Int prod_dim) {
+  SplitProducts<dim> p;
+  p.nprods = 0;
+  if (prod_dim == dim) {
+    for (Int s = 0; s < t.nsimplices; ++s) p.prods[p.nprods++] = t.simplices[s];
+    return p;
+  }
+  auto nsub = simplex_degree(dim, prod_dim);
+  for (Int s = 0; s < t.nsimplices; ++s) {
+    for (Int sub = 0; sub < nsub; ++sub) {
+      Few<Int, dim + 1> verts;
+      Int sides = (Int(1) << (dim + 1)) - 1;
+      for (Int pv = 0; pv <= prod_dim; ++pv) {
+        auto sv = (prod_dim == VERT)
+                      ? sub
+                      : simplex_down_template(dim, prod_dim, sub, pv);
+        verts[pv] = t.simplices[s][sv];
+        sides &= split_vert_sides<dim>(verts[pv]);
+      }
+      if (sides) continue;
+      bool is_new = true;
+      for (Int q = 0; q < p.nprods && is_new; ++q) {
+        Int nshared = 0;
+        for (Int pv = 0; pv <= prod_dim; ++pv) {
+          for (Int qv = 0; qv <= prod_dim; ++qv) {
+            if (verts[pv] == p.prods[q][qv]) ++nshared;
+          }
+        }
+        if (nshared == prod_dim + 1) is_new = false;
+      }
+      if (is_new) p.prods[p.nprods++] = verts;
+    }
+  }
+  return p;
+}
+
+/* the number of (prod_dim) products of each modified simplex of
+   (mod_dim), given which edges are split */
+LOs count_split_products(Mesh* mesh, Int mod_dim, Int prod_dim,
+    LOs mods2mds, Read<I8> edges_are_keys);
+
+/* (edges2midverts) maps old key edges to their new midpoint vertices */
+void split_products(Mesh* mesh, Int mod_dim, Int prod_dim, LOs mods2mds,
+    Read<I8> edges_are_keys, LOs edges2midverts, LOs old_verts2new_verts,
+    LOs& mods2prods, LOs& prod_verts2verts);
+
 }  // end namespace Omega_h
 
 #endif
@@ -105,6 +105,10 @@ ReaderTablesPtr ask_reader_tables() {
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+  if (ptr.use_count() == 0) {
+    auto lang = regex::ask_language();
+    ptr = get_compiled_reader_tables("regex", *lang);
+  }
   if (ptr.use_count() == 0) {
     auto lang = regex::ask_language();
     auto grammar = build_grammar(*lang);
@@ -114,6 +118,7 @@ ReaderTablesPtr ask_reader_tables() {
     indent_info.is_sensitive = false;
     indent_info.indent_token = -1;
     indent_info.dedent_token = -1;
+    indent_info.newline_token = -1;
     ptr.reset(new ReaderTables{parser, lexer, indent_info});
   }
   return ptr;
@@ -55,7 +55,21 @@ Alloc::Alloc(std::size_t size_in, std::string&& name_in)
   init();
 }
 
+Alloc::Alloc(void* ptr_in, std::size_t size_in, std::string const& name_in,
+    std::function<void()> release_in)
+    : size(size_in),
+      name(name_in),
+      ptr(ptr_in),
+      use_count(1),
+      prev(nullptr),
+      next(nullptr),
+      release(std::move(release_in)) {}
+
 OMEGA_H_DLL Alloc::~Alloc() {
+  if (release) {
+    release();
+    return;
+  }
   ::Omega_h::maybe_pooled_device_free(ptr, size);
   auto ga = global_allocs;
   if (ga) {
@@ -124,6 +138,12 @@ SharedAlloc::SharedAlloc(std::size_t size_in, std::string&& name_in) {
 
 SharedAlloc::SharedAlloc(std::size_t size_in) : SharedAlloc(size_in, "") {}
 
+SharedAlloc::SharedAlloc(void* ptr_in, std::size_t size_in,
+    std::string const& name_in, std::function<void()> release_in) {
+  alloc = new Alloc(ptr_in, size_in, name_in, std::move(release_in));
+  direct_ptr = ptr_in;
+}
+
 SharedAlloc SharedAlloc::identity(std::size_t size_in) {
   SharedAlloc out;
   out.direct_ptr = nullptr;
@@ -3,6 +3,7 @@
 
 #include <Omega_h_macros.h>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -25,8 +26,13 @@ struct Alloc {
   int use_count;
   Alloc* prev;
   Alloc* next;
+  /* set when ptr is borrowed from outside Omega_h: it is called instead
+     of freeing ptr, and the memory is not tracked */
+  std::function<void()> release;
   Alloc(std::size_t size_in, std::string const& name_in);
   Alloc(std::size_t size_in, std::string&& name_in);
+  Alloc(void* ptr_in, std::size_t size_in, std::string const& name_in,
+      std::function<void()> release_in);
   OMEGA_H_DLL ~Alloc();
   Alloc(Alloc const&) = delete;
   Alloc(Alloc&&) = delete;
@@ -55,6 +61,8 @@ struct SharedAlloc {
   SharedAlloc(std::size_t size_in, std::string const& name_in);
   SharedAlloc(std::size_t size_in, std::string&& name_in);
   SharedAlloc(std::size_t size_in);
+  SharedAlloc(void* ptr_in, std::size_t size_in, std::string const& name_in,
+      std::function<void()> release_in);
   enum : std::uintptr_t {
     FREE_BIT1 = 0x1,
     FREE_BIT2 = 0x2,
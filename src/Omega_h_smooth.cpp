@@ -0,0 +1,383 @@
+#include "Omega_h_smooth.hpp"
+
+#include <iostream>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_indset.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
+#include "Omega_h_profile.hpp"
+#include "Omega_h_quality.hpp"
+#include "Omega_h_shape.hpp"
+#include "Omega_h_transfer.hpp"
+
+namespace Omega_h {
+
+/* the element around (v), at its old position, that (x) is in or
+   nearest to, and the barycentric coordinates of (x) in it */
+template <Int dim>
+OMEGA_H_DEVICE LO locate_in_star(LO v, Vector<dim> x, LOs v2ve, LOs ve2e,
+    LOs elem_verts2verts, Reals coords, Vector<dim + 1>* bc) {
+  LO best_elem = -1;
+  Real best_distance = 0.0;
+  *bc = zero_vector<dim + 1>();
+  for (auto ve = v2ve[v]; ve < v2ve[v + 1]; ++ve) {
+    auto e = ve2e[ve];
+    auto eev2v = gather_verts<dim + 1>(elem_verts2verts, e);
+    auto p = gather_vectors<dim + 1, dim>(coords, eev2v);
+    auto xi = form_barycentric(invert(simplex_affine(p)) * x);
+    auto distance = -reduce(xi, minimum<Real>());
+    if (best_elem == -1 || distance < best_distance) {
+      best_elem = e;
+      best_distance = distance;
+      /* form_barycentric() puts the weight of p[0] last */
+      (*bc)[0] = xi[dim];
+      for (Int i = 0; i < dim; ++i) (*bc)[i + 1] = xi[i];
+    }
+  }
+  return best_elem;
+}
+
+template <Int dim, Int metric_dim>
+struct MovedVertQualities {
+  Reals coords;
+  Reals metrics;
+  Reals log_metrics;
+  LOs elem_verts2verts;
+  LOs v2ve;
+  LOs ve2e;
+  LOs v2vv;
+  LOs vv2v;
+  Real max_length;
+  MovedVertQualities(Mesh* mesh, AdaptOpts const& opts)
+      : coords(mesh->coords()),
+        metrics(mesh->get_array<Real>(VERT, "metric")),
+        elem_verts2verts(mesh->ask_elem_verts()),
+        max_length(opts.max_length_allowed) {
+    log_metrics = linearize_metrics(mesh->nverts(), metrics);
+    auto v2e = mesh->ask_up(VERT, dim);
+    v2ve = v2e.a2ab;
+    ve2e = v2e.ab2b;
+    auto v2v = mesh->ask_star(VERT);
+    v2vv = v2v.a2ab;
+    vv2v = v2v.ab2b;
+  }
+  /* the metric interpolated at (x), which (v) will carry there */
+  OMEGA_H_DEVICE Tensor<metric_dim> metric_at(LO v, Vector<dim> x) const {
+    Vector<dim + 1> bc;
+    auto e = locate_in_star(v, x, v2ve, ve2e, elem_verts2verts, coords, &bc);
+    auto eev2v = gather_verts<dim + 1>(elem_verts2verts, e);
+    auto log_ms = gather_symms<dim + 1, metric_dim>(log_metrics, eev2v);
+    auto log_m = zero_matrix<metric_dim, metric_dim>();
+    for (Int i = 0; i < dim + 1; ++i) log_m = log_m + log_ms[i] * bc[i];
+    return delinearize_metric(log_m);
+  }
+  /* quality of element (e) once its vertex (v) moves to (x)
+     with metric (m) */
+  OMEGA_H_DEVICE Real measure_elem(
+      LO v, LO e, Vector<dim> x, Tensor<metric_dim> m) const {
+    auto eev2v = gather_verts<dim + 1>(elem_verts2verts, e);
+    auto p = gather_vectors<dim + 1, dim>(coords, eev2v);
+    auto ms = gather_symms<dim + 1, metric_dim>(metrics, eev2v);
+    for (Int i = 0; i < dim + 1; ++i) {
+      if (eev2v[i] == v) {
+        p[i] = x;
+        ms[i] = m;
+      }
+    }
+    return metric_element_quality(p, maxdet_metric(ms));
+  }
+  /* minimum quality of the elements around (v) once it moves to (x),
+     or -1 if that makes one of its edges too long.
+     (worst) is the element of that minimum, or the first one */
+  OMEGA_H_DEVICE Real measure(
+      LO v, Vector<dim> x, LO* worst, Tensor<metric_dim>* m) const {
+    *worst = ve2e[v2ve[v]];
+    *m = metric_at(v, x);
+    Few<Vector<dim>, 2> p;
+    Few<Tensor<metric_dim>, 2> ms;
+    p[0] = x;
+    ms[0] = *m;
+    for (auto vv = v2vv[v]; vv < v2vv[v + 1]; ++vv) {
+      auto ov = vv2v[vv];
+      p[1] = get_vector<dim>(coords, ov);
+      ms[1] = get_symm<metric_dim>(metrics, ov);
+      if (metric_edge_length<dim, metric_dim>(p, ms) > max_length) {
+        return -1.0;
+      }
+    }
+    Real minqual = 1.0;
+    for (auto ve = v2ve[v]; ve < v2ve[v + 1]; ++ve) {
+      auto e = ve2e[ve];
+      auto qual = measure_elem(v, e, x, *m);
+      if (qual < minqual) {
+        minqual = qual;
+        *worst = e;
+      }
+    }
+    return minqual;
+  }
+};
+
+template <Int dim, Int metric_dim>
+static void smooth_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
+    LOs cands2verts, Reals* cand_quals, Reals* cand_coords) {
+  auto measure = MovedVertQualities<dim, metric_dim>(mesh, opts);
+  auto coords = mesh->coords();
+  auto verts_are_owned = mesh->owned(VERT);
+  auto v2vv = measure.v2vv;
+  auto vv2v = measure.vv2v;
+  auto ncands = cands2verts.size();
+  auto cand_quals_w = Write<Real>(ncands);
+  auto cand_coords_w = Write<Real>(ncands * dim);
+  auto f = OMEGA_H_LAMBDA(LO cand) {
+    auto v = cands2verts[cand];
+    auto x = get_vector<dim>(coords, v);
+    /* non-owned vertices may be missing elements,
+       their results will be overwritten by the owner's */
+    if (!verts_are_owned[v]) {
+      cand_quals_w[cand] = -1.0;
+      set_vector(cand_coords_w, cand, x);
+      return;
+    }
+    LO worst = -1;
+    Tensor<metric_dim> m;
+    auto qual = measure.measure(v, x, &worst, &m);
+    /* start from the centroid of the neighbors if it is better,
+       and scale the steps by the distance to the nearest one */
+    auto centroid = zero_vector<dim>();
+    auto h = ArithTraits<Real>::max();
+    for (auto vv = v2vv[v]; vv < v2vv[v + 1]; ++vv) {
+      auto p = get_vector<dim>(coords, vv2v[vv]);
+      centroid = centroid + p;
+      h = min2(h, norm(p - x));
+    }
+    centroid = centroid / Real(v2vv[v + 1] - v2vv[v]);
+    LO centroid_worst = -1;
+    Tensor<metric_dim> centroid_m;
+    auto centroid_qual =
+        measure.measure(v, centroid, &centroid_worst, &centroid_m);
+    if (centroid_qual > qual) {
+      x = centroid;
+      qual = centroid_qual;
+      worst = centroid_worst;
+      m = centroid_m;
+    }
+    /* the minimum quality is not smooth, so climb the gradient of
+       the worst element and accept only steps that raise the minimum */
+    for (Int iter = 0; iter < 10; ++iter) {
+      auto worst_qual = measure.measure_elem(v, worst, x, m);
+      auto fd = h * 1e-6;
+      Vector<dim> grad;
+      for (Int i = 0; i < dim; ++i) {
+        auto xi = x;
+        xi[i] += fd;
+        grad[i] = (measure.measure_elem(v, worst, xi, m) - worst_qual) / fd;
+      }
+      auto grad_norm = norm(grad);
+      if (!(grad_norm > 0.0)) break;
+      auto dir = grad / grad_norm;
+      bool moved = false;
+      for (auto step = h / 2.0; step > h * 1e-3; step /= 2.0) {
+        auto y = x + dir * step;
+        LO y_worst = -1;
+        Tensor<metric_dim> y_m;
+        auto y_qual = measure.measure(v, y, &y_worst, &y_m);
+        if (y_qual > qual) {
+          x = y;
+          qual = y_qual;
+          worst = y_worst;
+          m = y_m;
+          moved = true;
+          break;
+        }
+      }
+      if (!moved) break;
+    }
+    cand_quals_w[cand] = qual;
+    set_vector(cand_coords_w, cand, x);
+  };
+  parallel_for(ncands, f, "smooth_qualities");
+  *cand_quals = mesh->sync_subset_array(
+      VERT, Reals(cand_quals_w), cands2verts, -1.0, 1);
+  *cand_coords = cand_coords_w;
+}
+
+void smooth_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2verts,
+    Reals* cand_quals, Reals* cand_coords) {
+  OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
+  auto metrics = mesh->get_array<Real>(VERT, "metric");
+  auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
+  if (mesh->dim() == 3 && metric_dim == 3) {
+    smooth_qualities_tmpl<3, 3>(
+        mesh, opts, cands2verts, cand_quals, cand_coords);
+    return;
+  }
+  if (mesh->dim() == 2 && metric_dim == 2) {
+    smooth_qualities_tmpl<2, 2>(
+        mesh, opts, cands2verts, cand_quals, cand_coords);
+    return;
+  }
+  if (mesh->dim() == 3 && metric_dim == 1) {
+    smooth_qualities_tmpl<3, 1>(
+        mesh, opts, cands2verts, cand_quals, cand_coords);
+    return;
+  }
+  if (mesh->dim() == 2 && metric_dim == 1) {
+    smooth_qualities_tmpl<2, 1>(
+        mesh, opts, cands2verts, cand_quals, cand_coords);
+    return;
+  }
+  OMEGA_H_NORETURN();
+}
+
+template <Int dim>
+static void locate_moved_verts_tmpl(Mesh* mesh, LOs keys2verts,
+    Reals key_coords, LOs* keys2elems, Reals* key_bcs) {
+  auto coords = mesh->coords();
+  auto elem_verts2verts = mesh->ask_elem_verts();
+  auto v2e = mesh->ask_up(VERT, dim);
+  auto v2ve = v2e.a2ab;
+  auto ve2e = v2e.ab2b;
+  auto nkeys = keys2verts.size();
+  auto keys2elems_w = Write<LO>(nkeys);
+  auto key_bcs_w = Write<Real>(nkeys * (dim + 1));
+  auto f = OMEGA_H_LAMBDA(LO key) {
+    auto v = keys2verts[key];
+    auto x = get_vector<dim>(key_coords, key);
+    Vector<dim + 1> bc;
+    keys2elems_w[key] =
+        locate_in_star(v, x, v2ve, ve2e, elem_verts2verts, coords, &bc);
+    set_vector(key_bcs_w, key, bc);
+  };
+  parallel_for(nkeys, f, "locate_moved_verts");
+  *keys2elems = keys2elems_w;
+  *key_bcs = key_bcs_w;
+}
+
+static Reals interpolate_moved_verts(Mesh* mesh, LOs keys2elems,
+    Reals key_bcs, Reals data, Int ncomps) {
+  auto elem_verts2verts = mesh->ask_elem_verts();
+  auto nelem_verts = mesh->dim() + 1;
+  auto nkeys = keys2elems.size();
+  auto key_data = Write<Real>(nkeys * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO key) {
+    auto e = keys2elems[key];
+    for (Int c = 0; c < ncomps; ++c) {
+      Real val = 0.0;
+      for (Int i = 0; i < nelem_verts; ++i) {
+        auto v = elem_verts2verts[e * nelem_verts + i];
+        val += key_bcs[key * nelem_verts + i] * data[v * ncomps + c];
+      }
+      key_data[key * ncomps + c] = val;
+    }
+  };
+  parallel_for(nkeys, f, "interpolate_moved_verts");
+  return key_data;
+}
+
+/* the keys' vertex fields are interpolated at their new positions,
+   metrics in their log space, with the same element and weights
+   smooth_qualities() used for the metric */
+static void transfer_smooth(Mesh* mesh, TransferOpts const& opts,
+    LOs keys2verts, Reals key_coords) {
+  LOs keys2elems;
+  Reals key_bcs;
+  if (mesh->dim() == 3) {
+    locate_moved_verts_tmpl<3>(
+        mesh, keys2verts, key_coords, &keys2elems, &key_bcs);
+  } else {
+    locate_moved_verts_tmpl<2>(
+        mesh, keys2verts, key_coords, &keys2elems, &key_bcs);
+  }
+  auto nkeys = keys2verts.size();
+  for (Int i = 0; i < mesh->ntags(VERT); ++i) {
+    auto tagbase = mesh->get_tag(VERT, i);
+    auto& name = tagbase->name();
+    if (name == "coordinates") continue;
+    auto ncomps = tagbase->ncomps();
+    Reals key_data;
+    if (is_metric(mesh, opts, VERT, tagbase)) {
+      auto data = mesh->get_array<Real>(VERT, name);
+      auto log_data = linearize_metrics(mesh->nverts(), data);
+      key_data = delinearize_metrics(nkeys,
+          interpolate_moved_verts(mesh, keys2elems, key_bcs, log_data, ncomps));
+    } else if (should_interpolate(mesh, opts, VERT, tagbase)) {
+      auto data = mesh->get_array<Real>(VERT, name);
+      key_data =
+          interpolate_moved_verts(mesh, keys2elems, key_bcs, data, ncomps);
+    } else {
+      continue;
+    }
+    auto new_data = deep_copy(mesh->get_array<Real>(VERT, name));
+    map_into(key_data, keys2verts, new_data, ncomps);
+    mesh->set_tag(VERT, name, mesh->sync_array(VERT, Reals(new_data), ncomps));
+  }
+  auto new_coords = deep_copy(mesh->coords());
+  map_into(key_coords, keys2verts, new_coords, mesh->dim());
+  mesh->set_coords(mesh->sync_array(VERT, Reals(new_coords), mesh->dim()));
+}
+
+bool smooth_verts(Mesh* mesh, AdaptOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  if (mesh->dim() < 2) return false;
+  /* moving vertices changes element volumes, which conservative,
+     momentum and user transfers have no rule for */
+  auto& xfer_opts = opts.xfer_opts;
+  if (xfer_opts.user_xfer || should_conserve_any(mesh, xfer_opts) ||
+      has_momentum_velocity(mesh, xfer_opts)) {
+    return false;
+  }
+
+  mesh->change_all_rcFieldsTorc();
+
+  mesh->set_parting(OMEGA_H_GHOSTED);
+
+  mesh->change_all_rcFieldsToMesh();
+
+  auto comm = mesh->comm();
+  auto dim = mesh->dim();
+  auto elem_quals = mesh->ask_qualities();
+  auto elems_are_cands = each_lt(elem_quals, opts.min_quality_desired);
+  auto verts_are_cands = mark_down(mesh, dim, VERT, elems_are_cands);
+  /* only move interior vertices, so the boundary keeps its shape */
+  auto verts_are_inter = mark_by_class_dim(mesh, VERT, dim);
+  verts_are_cands = land_each(verts_are_cands, verts_are_inter);
+  if (get_max(comm, verts_are_cands) <= 0) return false;
+  auto cands2verts = collect_marked(verts_are_cands);
+  Reals cand_quals;
+  Reals cand_coords;
+  smooth_qualities(mesh, opts, cands2verts, &cand_quals, &cand_coords);
+  auto verts2elems = mesh->ask_up(VERT, dim);
+  auto vert_old_quals = graph_reduce(verts2elems, elem_quals, 1, OMEGA_H_MIN);
+  vert_old_quals = mesh->sync_array(VERT, vert_old_quals, 1);
+  auto cand_old_quals = read(unmap(cands2verts, vert_old_quals, 1));
+  auto kept2cands = collect_marked(gt_each(cand_quals, cand_old_quals));
+  if (comm->reduce_and(kept2cands.size() == 0)) return false;
+  auto kept2verts = LOs(unmap(kept2cands, cands2verts, 1));
+  auto kept_quals = read(unmap(kept2cands, cand_quals, 1));
+  auto kept_coords = read(unmap(kept2cands, cand_coords, dim));
+  auto verts_are_kept = mark_image(kept2verts, mesh->nverts());
+  auto vert_quals = map_onto(kept_quals, kept2verts, mesh->nverts(), -1.0, 1);
+  auto verts_are_keys = find_indset(mesh, VERT, vert_quals, verts_are_kept,
+      opts.nindset_quality_buckets);
+  auto keys2kept = collect_marked(read(unmap(kept2verts, verts_are_keys, 1)));
+  auto keys2verts = unmap(keys2kept, kept2verts, 1);
+  if (opts.verbosity >= EACH_REBUILD) {
+    auto nkeys = keys2verts.size();
+    auto ntotal_keys = comm->allreduce(GO(nkeys), OMEGA_H_SUM);
+    if (comm->rank() == 0) {
+      std::cout << "smoothing " << ntotal_keys << " vertices\n";
+    }
+  }
+  /* no two keys share an element, so each element changes
+     exactly as smooth_qualities() evaluated it */
+  auto key_coords = read(unmap(keys2kept, kept_coords, dim));
+  transfer_smooth(mesh, xfer_opts, keys2verts, key_coords);
+  return true;
+}
+
+}  // end namespace Omega_h
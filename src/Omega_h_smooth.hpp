@@ -0,0 +1,29 @@
+#ifndef OMEGA_H_SMOOTH_HPP
+#define OMEGA_H_SMOOTH_HPP
+
+#include <Omega_h_adapt.hpp>
+
+namespace Omega_h {
+
+/* for each candidate vertex, the position that maximizes the minimum
+   quality of its elements, found by a line search up the quality gradient
+   of the worst one. the vertex is measured with the metric interpolated
+   at each trial position. the results are in (cand_coords), and that
+   minimum quality in (cand_quals), which is -1 for vertices this rank
+   does not own and for moves that would make an edge longer than
+   opts.max_length_allowed */
+void smooth_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2verts,
+    Reals* cand_quals, Reals* cand_coords);
+
+/* moves an independent set of interior vertices next to elements below
+   opts.min_quality_desired, each one only if that raises the minimum
+   quality of its elements. the topology does not change. the moved
+   vertices' metrics and linearly interpolated fields are interpolated
+   at their new positions; other vertex fields keep their values.
+   returns false if no vertex could be moved, and does nothing when
+   conservative, momentum or user transfers are requested */
+bool smooth_verts(Mesh* mesh, AdaptOpts const& opts);
+
+}  // end namespace Omega_h
+
+#endif
@@ -1,8 +1,12 @@
 #include "Omega_h_swap.hpp"
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_modify.hpp"
 #include "Omega_h_profile.hpp"
 #include "Omega_h_swap2d.hpp"
 #include "Omega_h_swap3d.hpp"
@@ -38,7 +42,10 @@ void filter_swap(Read<I8> keep_cands, LOs* cands2edges, Reals* cand_quals) {
 }
 
 Read<I8> filter_swap_improve(Mesh* mesh, LOs cands2edges, Reals cand_quals) {
-  OMEGA_H_CHECK(mesh->owners_have_all_upward(EDGE));
+  /* element-based meshes only evaluate deferred candidates,
+     whose cavities set_owners_by_colors() kept whole on one rank */
+  OMEGA_H_CHECK(
+      mesh->owners_have_all_upward(EDGE) || mesh->has_tag(EDGE, "color"));
   auto elem_quals = mesh->ask_qualities();
   auto edges2elems = mesh->ask_up(EDGE, mesh->dim());
   auto edge_old_quals = graph_reduce(edges2elems, elem_quals, 1, OMEGA_H_MIN);
@@ -47,6 +54,52 @@ Read<I8> filter_swap_improve(Mesh* mesh, LOs cands2edges, Reals cand_quals) {
   return gt_each(cand_quals, cand_old_quals);
 }
 
+Read<I8> color_swap_cands(
+    Mesh* mesh, Read<I8> edges_are_cands, Read<I8> edges_are_keys) {
+  auto edge_colors = Write<I8>(mesh->nedges());
+  auto f = OMEGA_H_LAMBDA(LO edge) {
+    if (edges_are_keys[edge])
+      edge_colors[edge] = SWAP_KEY;
+    else if (edges_are_cands[edge])
+      edge_colors[edge] = SWAP_DEFERRED;
+    else
+      edge_colors[edge] = -1;
+  };
+  parallel_for(mesh->nedges(), f, "color_swap_cands");
+  return set_owners_by_colors(mesh, EDGE, edge_colors);
+}
+
+void transfer_swap_colors(Mesh* old_mesh, Mesh* new_mesh, LOs prods2new_ents,
+    LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  auto old_colors = old_mesh->get_array<I8>(EDGE, "color");
+  auto same_colors = read(unmap(same_ents2old_ents, old_colors, 1));
+  auto new_colors = Write<I8>(new_mesh->nedges(), I8(-1));
+  map_into(same_colors, same_ents2new_ents, new_colors, 1);
+  map_value_into(I8(SWAP_PRODUCT), prods2new_ents, new_colors);
+  new_mesh->add_tag(EDGE, "color", 1, Read<I8>(new_colors));
+}
+
+LOs get_deferred_swap_cands(Mesh* mesh, AdaptOpts const& opts) {
+  auto edge_colors = mesh->get_array<I8>(EDGE, "color");
+  auto elems_are_slivers =
+      each_lt(mesh->ask_qualities(), opts.min_quality_desired);
+  auto edges_are_near =
+      mark_down(mesh->ask_up(EDGE, mesh->dim()), elems_are_slivers);
+  auto edges_are_prods = each_eq_to(edge_colors, I8(SWAP_PRODUCT));
+  auto edges_are_cands = lor_each(each_eq_to(edge_colors, I8(SWAP_DEFERRED)),
+      land_each(edges_are_prods, edges_are_near));
+  return collect_marked(edges_are_cands);
+}
+
+Read<I8> find_local_swap_keys(Mesh* mesh, AdaptOpts const& opts,
+    LOs cands2edges, Reals cand_quals) {
+  auto edges_are_cands = mark_image(cands2edges, mesh->nedges());
+  auto edge_quals = map_onto(cand_quals, cands2edges, mesh->nedges(), -1.0, 1);
+  /* the candidates are not shared, so their stars are all local */
+  return find_indset(mesh, EDGE, mesh->ask_star(EDGE), edge_quals,
+      edges_are_cands, opts.nindset_quality_buckets);
+}
+
 bool swap_edges(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
   bool ret = false;
@@ -11,6 +11,23 @@ void filter_swap(
     Read<I8> keep_cands, LOs* cands2edges, Reals* cand_quals = nullptr);
 Read<I8> filter_swap_improve(Mesh* mesh, LOs cands2edges, Reals cand_quals);
 
+/* when opts.nswap_rebuilds_per_ghost is more than one, the EDGE "color" tag
+   schedules the rebuilds after the first one of a ghosting:
+   candidates left out of the key independent set are deferred, and
+   set_owners_by_colors() keeps their cavities whole on one rank so that
+   they, and the new edges of later rebuilds, can be swapped without
+   ghosting again */
+enum : I8 { SWAP_KEY = 0, SWAP_DEFERRED = 1, SWAP_PRODUCT = 2 };
+Read<I8> color_swap_cands(
+    Mesh* mesh, Read<I8> edges_are_cands, Read<I8> edges_are_keys);
+void transfer_swap_colors(Mesh* old_mesh, Mesh* new_mesh, LOs prods2new_ents,
+    LOs same_ents2old_ents, LOs same_ents2new_ents);
+/* deferred edges and new edges next to elements
+   below opts.min_quality_desired */
+LOs get_deferred_swap_cands(Mesh* mesh, AdaptOpts const& opts);
+Read<I8> find_local_swap_keys(
+    Mesh* mesh, AdaptOpts const& opts, LOs cands2edges, Reals cand_quals);
+
 bool swap_edges(Mesh* mesh, AdaptOpts const& opts);
 
 }  // end namespace Omega_h
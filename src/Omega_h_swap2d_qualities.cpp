@@ -72,7 +72,9 @@ Reals swap2d_qualities_tmpl(
 }
 
 Reals swap2d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges) {
-  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
+  /* see filter_swap_improve() for the element-based case */
+  OMEGA_H_CHECK(
+      mesh->parting() == OMEGA_H_GHOSTED || mesh->has_tag(EDGE, "color"));
   auto metrics = mesh->get_array<Real>(VERT, "metric");
   auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
   if (metric_dim == 2) {
@@ -15,6 +15,7 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto comm = mesh->comm();
   auto edges_are_cands = mesh->get_array<I8>(EDGE, "candidate");
   mesh->remove_tag(EDGE, "candidate");
+  auto edges_were_cands = edges_are_cands;
   auto cands2edges = collect_marked(edges_are_cands);
   auto cand_quals = Reals();
   auto cand_configs = Read<I8>();
@@ -26,11 +27,17 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   if (comm->reduce_and(cands2edges.size() == 0)) return false;
   edges_are_cands = mark_image(cands2edges, mesh->nedges());
   auto edge_quals = map_onto(cand_quals, cands2edges, mesh->nedges(), -1.0, 1);
-  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals, edges_are_cands);
-  Graph edges2cav_elems;
-  edges2cav_elems = mesh->ask_up(EDGE, mesh->dim());
+  auto edges_are_keys = find_indset(mesh, EDGE, edge_quals,
+      edges_are_cands, opts.nindset_quality_buckets);
   mesh->add_tag(EDGE, "key", 1, edges_are_keys);
   mesh->add_tag(EDGE, "config", 1, edge_configs);
+  if (opts.nswap_rebuilds_per_ghost > 1) {
+    auto edge_colors = color_swap_cands(mesh, edges_were_cands, edges_are_keys);
+    mesh->add_tag(EDGE, "color", 1, edge_colors);
+    return true;
+  }
+  Graph edges2cav_elems;
+  edges2cav_elems = mesh->ask_up(EDGE, mesh->dim());
   auto keys2edges = collect_marked(edges_are_keys);
   set_owners_by_indset(mesh, EDGE, keys2edges, edges2cav_elems);
   return true;
@@ -70,22 +77,49 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
     transfer_swap(mesh, opts.xfer_opts, &new_mesh, ent_dim, keys2edges,
         keys2prods[ent_dim], prods2new_ents, same_ents2old_ents,
         same_ents2new_ents);
+    if (ent_dim == EDGE && mesh->has_tag(EDGE, "color")) {
+      transfer_swap_colors(mesh, &new_mesh, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents);
+    }
     old_lows2new_lows = old_ents2new_ents;
   }
   *mesh = new_mesh;
 }
 
+static bool swap3d_deferred(Mesh* mesh, AdaptOpts const& opts) {
+  auto comm = mesh->comm();
+  auto cands2edges = get_deferred_swap_cands(mesh, opts);
+  auto cand_quals = Reals();
+  auto cand_configs = Read<I8>();
+  swap3d_qualities(mesh, opts, cands2edges, &cand_quals, &cand_configs);
+  auto edge_configs =
+      map_onto(cand_configs, cands2edges, mesh->nedges(), I8(-1), 1);
+  auto keep_cands = filter_swap_improve(mesh, cands2edges, cand_quals);
+  filter_swap(keep_cands, &cands2edges, &cand_quals);
+  if (comm->reduce_and(cands2edges.size() == 0)) return false;
+  auto edges_are_keys =
+      find_local_swap_keys(mesh, opts, cands2edges, cand_quals);
+  mesh->add_tag(EDGE, "key", 1, edges_are_keys);
+  mesh->add_tag(EDGE, "config", 1, edge_configs);
+  return true;
+}
+
 bool swap_edges_3d(Mesh* mesh, AdaptOpts const& opts) {
   if (!swap_part1(mesh, opts)) return false;
   if (!swap3d_ghosted(mesh, opts)) return false;
 
   mesh->change_all_rcFieldsTorc();
 
-  mesh->set_parting(OMEGA_H_ELEM_BASED, false);
+  unghost_for_rebuild(mesh, opts);
 
   mesh->change_all_rcFieldsToMesh();
 
   swap3d_element_based(mesh, opts);
+  for (Int i = 1; i < opts.nswap_rebuilds_per_ghost; ++i) {
+    if (!swap3d_deferred(mesh, opts)) break;
+    swap3d_element_based(mesh, opts);
+  }
+  if (mesh->has_tag(EDGE, "color")) mesh->remove_tag(EDGE, "color");
   return true;
 }
 
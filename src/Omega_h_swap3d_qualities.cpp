@@ -59,7 +59,9 @@ void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
 
 void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
     Reals* cand_quals, Read<I8>* cand_configs) {
-  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
+  /* see filter_swap_improve() for the element-based case */
+  OMEGA_H_CHECK(
+      mesh->parting() == OMEGA_H_GHOSTED || mesh->has_tag(EDGE, "color"));
   OMEGA_H_CHECK(mesh->dim() == 3);
   auto metrics = mesh->get_array<Real>(VERT, "metric");
   auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
@@ -10,6 +10,8 @@
 #include "Omega_h_shape.hpp"
 
 #include <iostream>
+#include <memory>
+#include <vector>
 namespace Omega_h {
 
 bool is_transfer_required(
@@ -344,6 +346,11 @@ void transfer_length(Mesh* old_mesh, Mesh* new_mesh, LOs same_ents2old_ents,
       auto prod_data = measure_edges_metric(new_mesh, prods2new_ents);
       transfer_common(old_mesh, new_mesh, EDGE, same_ents2old_ents,
           same_ents2new_ents, prods2new_ents, tagbase, prod_data);
+    } else if (tagbase->name() == "length_active" &&
+               tagbase->type() == OMEGA_H_I8 && tagbase->ncomps() == 1) {
+      auto prod_data = Read<I8>(prods2new_ents.size(), I8(1));
+      transfer_common(old_mesh, new_mesh, EDGE, same_ents2old_ents,
+          same_ents2new_ents, prods2new_ents, tagbase, prod_data);
     }
   }
 }
@@ -428,6 +435,107 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   end_code();
 }
 
+/* products of a multi-edge split inherit from the modified entity
+   (edge, face, or element) whose interior they fill */
+template <typename T>
+static void transfer_inherit_split_tmpl(Mesh* old_mesh, Mesh* new_mesh,
+    Few<LOs, 4> mods2mds, Few<LOs, 4> mods2prods, Int prod_dim,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    TagBase const* tagbase) {
+  auto const& name = tagbase->name();
+  auto ncomps = tagbase->ncomps();
+  auto nprods = prods2new_ents.size();
+  auto prod_data = Write<T>(nprods * ncomps);
+  for (Int mod_dim = 0; mod_dim <= old_mesh->dim(); ++mod_dim) {
+    if (!mods2prods[mod_dim].exists()) continue;
+    auto md_data = old_mesh->get_array<T>(mod_dim, name);
+    auto mods2mds_dim = mods2mds[mod_dim];
+    auto mods2prods_dim = mods2prods[mod_dim];
+    auto f = OMEGA_H_LAMBDA(LO mod) {
+      auto md = mods2mds_dim[mod];
+      for (auto prod = mods2prods_dim[mod]; prod < mods2prods_dim[mod + 1];
+           ++prod) {
+        for (Int comp = 0; comp < ncomps; ++comp) {
+          prod_data[prod * ncomps + comp] = md_data[md * ncomps + comp];
+        }
+      }
+    };
+    parallel_for(mods2mds_dim.size(), f, "transfer_inherit_split");
+  }
+  transfer_common(old_mesh, new_mesh, prod_dim, same_ents2old_ents,
+      same_ents2new_ents, prods2new_ents, tagbase, Read<T>(prod_data));
+}
+
+static void transfer_inherit_split(Mesh* old_mesh, Mesh* new_mesh,
+    Few<LOs, 4> mods2mds, Few<LOs, 4> mods2prods, Int prod_dim,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents,
+    TagBase const* tagbase) {
+  switch (tagbase->type()) {
+    case OMEGA_H_I8:
+      transfer_inherit_split_tmpl<I8>(old_mesh, new_mesh, mods2mds, mods2prods,
+          prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+          tagbase);
+      break;
+    case OMEGA_H_I32:
+      transfer_inherit_split_tmpl<I32>(old_mesh, new_mesh, mods2mds,
+          mods2prods, prod_dim, prods2new_ents, same_ents2old_ents,
+          same_ents2new_ents, tagbase);
+      break;
+    case OMEGA_H_I64:
+      transfer_inherit_split_tmpl<I64>(old_mesh, new_mesh, mods2mds,
+          mods2prods, prod_dim, prods2new_ents, same_ents2old_ents,
+          same_ents2new_ents, tagbase);
+      break;
+    case OMEGA_H_F64:
+      transfer_inherit_split_tmpl<Real>(old_mesh, new_mesh, mods2mds,
+          mods2prods, prod_dim, prods2new_ents, same_ents2old_ents,
+          same_ents2new_ents, tagbase);
+      break;
+  }
+}
+
+void transfer_split(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
+    Few<LOs, 4> mods2mds, Few<LOs, 4> mods2prods, Int prod_dim,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  begin_code("transfer_split");
+  auto dim = old_mesh->dim();
+  for (Int i = 0; i < old_mesh->ntags(prod_dim); ++i) {
+    auto tagbase = old_mesh->get_tag(prod_dim, i);
+    /* densities and pointwise fields are just inherited, as in
+       transfer_refine() */
+    if (should_inherit(old_mesh, opts, prod_dim, tagbase) ||
+        (prod_dim == dim &&
+            (should_transfer_density(old_mesh, opts, dim, tagbase) ||
+                should_fit(old_mesh, opts, dim, tagbase)))) {
+      transfer_inherit_split(old_mesh, new_mesh, mods2mds, mods2prods,
+          prod_dim, prods2new_ents, same_ents2old_ents, same_ents2new_ents,
+          tagbase);
+    }
+  }
+  if (prod_dim == VERT) {
+    /* only split edges produce vertices, one each */
+    auto keys2edges = mods2mds[EDGE];
+    transfer_linear_interp(old_mesh, opts, new_mesh, keys2edges,
+        prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+    transfer_metric(old_mesh, opts, new_mesh, keys2edges, prods2new_ents,
+        same_ents2old_ents, same_ents2new_ents);
+  }
+  if (prod_dim == EDGE) {
+    transfer_length(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+  } else if (prod_dim == FACE) {
+    transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
+        same_ents2new_ents, prods2new_ents);
+  }
+  if (prod_dim == dim) {
+    transfer_size(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+    transfer_quality(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
+        prods2new_ents);
+  }
+  end_code();
+}
+
 template <typename T>
 static void transfer_inherit_coarsen_tmpl(Mesh* old_mesh, Mesh* new_mesh,
     Adj keys2doms, Int prod_dim, LOs prods2new_ents, LOs same_ents2old_ents,
@@ -622,6 +730,80 @@ void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   end_code();
 }
 
+template <typename T>
+static void keep_prod_data_tmpl(Mesh* new_mesh, Int prod_dim,
+    LOs prods2new_ents, TagBase const* tagbase) {
+  auto const& name = tagbase->name();
+  if (!new_mesh->has_tag(prod_dim, name)) return;
+  auto ncomps = tagbase->ncomps();
+  auto prod_data =
+      read(unmap(prods2new_ents, as<T>(tagbase)->array(), ncomps));
+  auto new_data = deep_copy(new_mesh->get_array<T>(prod_dim, name));
+  map_into(prod_data, prods2new_ents, new_data, ncomps);
+  new_mesh->add_tag(prod_dim, name, ncomps, Read<T>(new_data), true);
+}
+
+template <typename T>
+static std::shared_ptr<TagBase> copy_tag_tmpl(TagBase const* tagbase) {
+  auto tag = new Tag<T>(tagbase->name(), tagbase->ncomps());
+  tag->set_array(as<T>(tagbase)->array());
+  return std::shared_ptr<TagBase>(tag);
+}
+
+void transfer_refine_and_coarsen(Mesh* old_mesh, TransferOpts const& opts,
+    Mesh* new_mesh, LOs keys2edges, LOs keys2midverts, LOs split_keys2prods,
+    LOs split_prods2new_ents, LOs keys2verts, Adj keys2doms,
+    LOs collapse_prods2new_ents, Int prod_dim, LOs same_ents2old_ents,
+    LOs same_ents2new_ents) {
+  begin_code("transfer_refine_and_coarsen");
+  transfer_coarsen(old_mesh, opts, new_mesh, keys2verts, keys2doms, prod_dim,
+      collapse_prods2new_ents, same_ents2old_ents, same_ents2new_ents);
+  /* transfer_refine writes each array in full, leaving the collapse
+     products undefined, so their values are kept aside and put back */
+  std::vector<std::shared_ptr<TagBase>> coarsened;
+  for (Int i = 0; i < new_mesh->ntags(prod_dim); ++i) {
+    auto tagbase = new_mesh->get_tag(prod_dim, i);
+    switch (tagbase->type()) {
+      case OMEGA_H_I8:
+        coarsened.push_back(copy_tag_tmpl<I8>(tagbase));
+        break;
+      case OMEGA_H_I32:
+        coarsened.push_back(copy_tag_tmpl<I32>(tagbase));
+        break;
+      case OMEGA_H_I64:
+        coarsened.push_back(copy_tag_tmpl<I64>(tagbase));
+        break;
+      case OMEGA_H_F64:
+        coarsened.push_back(copy_tag_tmpl<Real>(tagbase));
+        break;
+    }
+  }
+  transfer_refine(old_mesh, opts, new_mesh, keys2edges, keys2midverts,
+      prod_dim, split_keys2prods, split_prods2new_ents, same_ents2old_ents,
+      same_ents2new_ents);
+  for (auto const& tag : coarsened) {
+    switch (tag->type()) {
+      case OMEGA_H_I8:
+        keep_prod_data_tmpl<I8>(
+            new_mesh, prod_dim, collapse_prods2new_ents, tag.get());
+        break;
+      case OMEGA_H_I32:
+        keep_prod_data_tmpl<I32>(
+            new_mesh, prod_dim, collapse_prods2new_ents, tag.get());
+        break;
+      case OMEGA_H_I64:
+        keep_prod_data_tmpl<I64>(
+            new_mesh, prod_dim, collapse_prods2new_ents, tag.get());
+        break;
+      case OMEGA_H_F64:
+        keep_prod_data_tmpl<Real>(
+            new_mesh, prod_dim, collapse_prods2new_ents, tag.get());
+        break;
+    }
+  }
+  end_code();
+}
+
 template <typename T>
 static void transfer_copy_tmpl(
     Mesh* new_mesh, Int prod_dim, TagBase const* tagbase) {
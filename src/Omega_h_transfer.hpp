@@ -32,6 +32,12 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     LOs keys2edges, LOs keys2midverts, Int prod_dim, LOs keys2prods,
     LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents);
 
+/* transfer after all key edges of an element were split at once
+   (see split_products()). conserved and momentum fields are not supported */
+void transfer_split(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
+    Few<LOs, 4> mods2mds, Few<LOs, 4> mods2prods, Int prod_dim,
+    LOs prods2new_ents, LOs same_ents2old_ents, LOs same_ents2new_ents);
+
 void transfer_inherit_refine(Mesh* old_mesh, Mesh* new_mesh, LOs keys2edges,
     Int prod_dim, LOs keys2prods, LOs prods2new_ents, LOs same_ents2old_ents,
     LOs same_ents2new_ents, TagBase const* tagbase);
@@ -40,6 +46,14 @@ void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     LOs keys2verts, Adj keys2doms, Int prod_dim, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents);
 
+/* both operators' transfers for one rebuild that applied disjoint
+   edge splits and vertex collapses together */
+void transfer_refine_and_coarsen(Mesh* old_mesh, TransferOpts const& opts,
+    Mesh* new_mesh, LOs keys2edges, LOs keys2midverts, LOs split_keys2prods,
+    LOs split_prods2new_ents, LOs keys2verts, Adj keys2doms,
+    LOs collapse_prods2new_ents, Int prod_dim, LOs same_ents2old_ents,
+    LOs same_ents2new_ents);
+
 void transfer_swap(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
     Int prod_dim, LOs keys2edges, LOs keys2prods, LOs prods2new_ents,
     LOs same_ents2old_ents, LOs same_ents2new_ents);
@@ -122,8 +122,31 @@ void describe_array(std::ostream& stream, std::string const& name, Int ncomps) {
   stream << " format=\"binary\"";
 }
 
+/* room for ' offset=""' around any 64-bit offset */
+static constexpr std::size_t appended_offset_width = 30;
+
+/* the offset of an appended array is only known once the blocks before
+   it are written, so blank space is left in the start tag here and
+   write_appended_data() writes the offset attribute over it */
+template <typename T>
+static void describe_appended_array(std::ostream& stream,
+    std::string const& name, Int ncomps, AppendedData* appended) {
+  stream << "type=\"" << Traits<T>::name() << "\"";
+  stream << " Name=\"" << name << "\"";
+  stream << " NumberOfComponents=\"" << ncomps << "\"";
+  stream << " format=\"appended\"";
+  auto const pos = stream.tellp();
+  if (pos == std::streampos(-1)) {
+    Omega_h_fail("vtk: appended data needs a seekable output stream\n");
+  }
+  appended->offset_positions.push_back(pos);
+  stream << std::string(appended_offset_width, ' ');
+}
+
+/* offset_out is set to the offset into the appended data for arrays
+   with format="appended", and to the maximum value for inline arrays */
 static bool read_array_start_tag(std::istream& stream, Omega_h_Type* type_out,
-    std::string* name_out, Int* ncomps_out) {
+    std::string* name_out, Int* ncomps_out, std::uint64_t* offset_out) {
   auto st = xml_lite::read_tag(stream);
   if (st.elem_name != "DataArray" || st.type != xml_lite::Tag::START) {
     OMEGA_H_CHECK(st.type == xml_lite::Tag::END);
@@ -140,44 +163,93 @@ static bool read_array_start_tag(std::istream& stream, Omega_h_Type* type_out,
     *type_out = OMEGA_H_F64;
   *name_out = st.attribs["Name"];
   *ncomps_out = std::stoi(st.attribs["NumberOfComponents"]);
-  OMEGA_H_CHECK(st.attribs["format"] == "binary");
+  if (st.attribs["format"] == "appended") {
+    *offset_out = std::stoull(st.attribs["offset"]);
+  } else {
+    OMEGA_H_CHECK(st.attribs["format"] == "binary");
+    *offset_out = std::numeric_limits<std::uint64_t>::max();
+  }
   return true;
 }
 
+/* writes the header and (possibly compressed) bytes of one appended
+   array and returns how many bytes that took */
+template <typename T_osh>
+static std::uint64_t write_appended_block(
+    std::ostream& stream, Read<T_osh> array, bool compress) {
+  HostRead<T_osh> uncompressed(array);
+  std::uint64_t uncompressed_bytes =
+      sizeof(T_osh) * static_cast<uint64_t>(array.size());
+#ifdef OMEGA_H_USE_ZLIB
+  if (compress) {
+    begin_code("zlib");
+    uLong source_bytes = uncompressed_bytes;
+    uLong dest_bytes = ::compressBound(source_bytes);
+    std::vector< ::Bytef> compressed(dest_bytes);
+    int ret = ::compress2(compressed.data(), &dest_bytes,
+        reinterpret_cast<const ::Bytef*>(nonnull(uncompressed.data())),
+        source_bytes, Z_BEST_SPEED);
+    end_code();
+    OMEGA_H_CHECK(ret == Z_OK);
+    std::uint64_t header[4] = {
+        1, uncompressed_bytes, uncompressed_bytes, dest_bytes};
+    stream.write(reinterpret_cast<char const*>(header), sizeof(header));
+    stream.write(reinterpret_cast<char const*>(compressed.data()),
+        std::streamsize(dest_bytes));
+    return sizeof(header) + dest_bytes;
+  }
+#else
+  OMEGA_H_CHECK(!compress);
+#endif
+  stream.write(reinterpret_cast<char const*>(&uncompressed_bytes),
+      sizeof(std::uint64_t));
+  stream.write(reinterpret_cast<char const*>(nonnull(uncompressed.data())),
+      std::streamsize(uncompressed_bytes));
+  return sizeof(std::uint64_t) + uncompressed_bytes;
+}
+
 template <typename T_osh, typename T_vtk>
 void write_array(std::ostream& stream, std::string const& name, Int ncomps,
-    Read<T_osh> array, bool compress) {
+    Read<T_osh> array, bool compress, AppendedData* appended) {
   OMEGA_H_TIME_FUNCTION;
   if (!(array.exists())) {
     Omega_h_fail("vtk::write_array: \"%s\" doesn't exist\n", name.c_str());
   }
   begin_code("header");
   stream << "<DataArray ";
-  describe_array<T_vtk>(stream, name, ncomps);
+  if (appended) {
+    describe_appended_array<T_vtk>(stream, name, ncomps, appended);
+  } else {
+    describe_array<T_vtk>(stream, name, ncomps);
+  }
   stream << ">\n";
   end_code();
+  if (appended) {
+    appended->blocks.push_back([=](std::ostream& out) {
+      return write_appended_block(out, array, compress);
+    });
+    stream << "</DataArray>\n";
+    return;
+  }
   HostRead<T_osh> uncompressed(array);
   std::uint64_t uncompressed_bytes =
       sizeof(T_osh) * static_cast<uint64_t>(array.size());
-  std::string enc_header;
-  std::string encoded;
 #ifdef OMEGA_H_USE_ZLIB
   if (compress) {
     begin_code("zlib");
     uLong source_bytes = uncompressed_bytes;
     uLong dest_bytes = ::compressBound(source_bytes);
-    auto compressed = new ::Bytef[dest_bytes];
-    int ret = ::compress2(compressed, &dest_bytes,
+    std::vector< ::Bytef> compressed(dest_bytes);
+    int ret = ::compress2(compressed.data(), &dest_bytes,
         reinterpret_cast<const ::Bytef*>(nonnull(uncompressed.data())),
         source_bytes, Z_BEST_SPEED);
     end_code();
     OMEGA_H_CHECK(ret == Z_OK);
-    begin_code("base64");
-    encoded = base64::encode(compressed, dest_bytes);
-    delete[] compressed;
     std::uint64_t header[4] = {
         1, uncompressed_bytes, uncompressed_bytes, dest_bytes};
-    enc_header = base64::encode(header, sizeof(header));
+    begin_code("base64");
+    base64::encode(stream, header, sizeof(header));
+    base64::encode(stream, compressed.data(), dest_bytes);
     end_code();
   } else
 #else
@@ -185,86 +257,183 @@ void write_array(std::ostream& stream, std::string const& name, Int ncomps,
 #endif
   {
     begin_code("base64 bulk");
-    enc_header = base64::encode(&uncompressed_bytes, sizeof(std::uint64_t));
-    encoded = base64::encode(nonnull(uncompressed.data()), uncompressed_bytes);
+    base64::encode(stream, &uncompressed_bytes, sizeof(std::uint64_t));
+    base64::encode(stream, nonnull(uncompressed.data()), uncompressed_bytes);
     end_code();
   }
-  begin_code("stream bulk");
-  // stream << enc_header << encoded << '\n';
-  // the following three lines are 30% faster than the above line
-  stream.write(enc_header.data(), std::streamsize(enc_header.length()));
-  stream.write(encoded.data(), std::streamsize(encoded.length()));
-  stream.write("\n", 1);
-  end_code();
   begin_code("footer");
+  stream.write("\n", 1);
   stream << "</DataArray>\n";
   end_code();
 }
 
+/* each block is converted, compressed and written in turn, so only one
+   array's host copy and compressed bytes exist at a time. the offset
+   of each block is written back into its DataArray start tag */
+void write_appended_data(std::ostream& stream, AppendedData const& appended) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(appended.blocks.size() == appended.offset_positions.size());
+  stream << "<AppendedData encoding=\"raw\">\n_";
+  std::uint64_t offset = 0;
+  for (std::size_t i = 0; i < appended.blocks.size(); ++i) {
+    auto const resume = stream.tellp();
+    stream.seekp(appended.offset_positions[i]);
+    stream << " offset=\"" << offset << "\"";
+    stream.seekp(resume);
+    offset += appended.blocks[i](stream);
+  }
+  stream << "\n</AppendedData>\n";
+}
+
+/* The header and payload are decoded straight from the stream into their
+   final buffers: compressed bytes into the zlib input, uncompressed bytes
+   into the destination array. */
 template <typename T>
 static Read<T> read_array(
     std::istream& stream, LO size, bool needs_swapping, bool is_compressed) {
-  auto enc_both = base64::read_encoded(stream);
   std::uint64_t uncompressed_bytes;
-  std::string encoded;
+  HostWrite<T> uncompressed(size);
 #ifdef OMEGA_H_USE_ZLIB
-  std::uint64_t compressed_bytes;
   if (is_compressed) {
     std::uint64_t header[4];
-    auto nheader_chars = base64::encoded_size(sizeof(header));
-    auto enc_header = enc_both.substr(0, nheader_chars);
-    base64::decode(enc_header, header, sizeof(header));
+    base64::read_decoded(stream, header, sizeof(header));
     if (needs_swapping) {
       for (std::uint64_t i = 0; i < 4; ++i) {
         binary::swap_bytes(header[i]);
       }
     }
-    encoded = enc_both.substr(nheader_chars);
     uncompressed_bytes = header[2];
-    compressed_bytes = header[3];
+    auto compressed_bytes = header[3];
+    OMEGA_H_CHECK(uncompressed_bytes == std::uint64_t(size) * sizeof(T));
+    std::vector< ::Bytef> compressed(compressed_bytes);
+    begin_code("base64");
+    base64::read_decoded(stream, compressed.data(), compressed_bytes);
+    end_code();
+    begin_code("zlib");
+    uLong dest_bytes = static_cast<uLong>(uncompressed_bytes);
+    uLong source_bytes = static_cast<uLong>(compressed_bytes);
+    ::Bytef* uncompressed_ptr =
+        reinterpret_cast< ::Bytef*>(nonnull(uncompressed.data()));
+    int ret = ::uncompress(
+        uncompressed_ptr, &dest_bytes, compressed.data(), source_bytes);
+    end_code();
+    if (ret != Z_OK) {
+      Omega_h_fail("code %d: couldn't decompress a VTK array\n", ret);
+    }
+    OMEGA_H_CHECK(dest_bytes == static_cast<uLong>(uncompressed_bytes));
   } else
 #else
   OMEGA_H_CHECK(is_compressed == false);
 #endif
   {
-    auto nheader_chars = base64::encoded_size(sizeof(std::uint64_t));
-    auto enc_header = enc_both.substr(0, nheader_chars);
-    base64::decode(enc_header, &uncompressed_bytes, sizeof(uncompressed_bytes));
+    base64::read_decoded(
+        stream, &uncompressed_bytes, sizeof(uncompressed_bytes));
     if (needs_swapping) binary::swap_bytes(uncompressed_bytes);
+    OMEGA_H_CHECK(uncompressed_bytes == std::uint64_t(size) * sizeof(T));
+    begin_code("base64");
+    base64::read_decoded(
+        stream, nonnull(uncompressed.data()), uncompressed_bytes);
+    end_code();
+  }
+  // the newline ending the payload, so the end tag is next
+  stream.get();
+  return binary::swap_bytes(Read<T>(uncompressed.write()), needs_swapping);
+}
+
+/* The XML ahead of the appended data holds no array payloads, so it is
+   cheap to scan forward from the current position for the '_' that marks
+   the start of the raw bytes. */
+static std::streampos find_appended_data(std::istream& stream) {
+  for (std::string line;;) {
+    auto const line_start = stream.tellg();
+    if (!std::getline(stream, line)) break;
+    auto const tag_pos = line.find("<AppendedData");
+    if (tag_pos == std::string::npos) continue;
+    auto const underscore = line.find('_', line.find('>', tag_pos));
+    if (underscore != std::string::npos) {
+      return line_start + std::streamoff(underscore + 1);
+    }
+    int c;
+    while ((c = stream.get()) != '_' && c != EOF)
+      ;
+    OMEGA_H_CHECK(c == '_');
+    return stream.tellg();
+  }
+  Omega_h_fail("vtk: appended array without an <AppendedData> section\n");
+}
+
+/* (appended_base) is where the raw bytes start, found on the first
+   appended array of a file and reused for the rest of it. reading
+   continues after the array's end tag */
+template <typename T>
+static Read<T> read_appended_array(std::istream& stream, std::uint64_t offset,
+    LO size, bool needs_swapping, bool is_compressed,
+    std::streampos* appended_base) {
+  auto const resume = stream.tellg();
+  if (*appended_base == std::streampos(-1)) {
+    *appended_base = find_appended_data(stream);
+  }
+  auto const base = *appended_base;
+  stream.clear();
+  stream.seekg(base + std::streamoff(offset));
+  std::uint64_t uncompressed_bytes;
 #ifdef OMEGA_H_USE_ZLIB
-    compressed_bytes = uncompressed_bytes;
+  std::uint64_t compressed_bytes = 0;
+  if (is_compressed) {
+    std::uint64_t header[4];
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (needs_swapping) {
+      for (std::uint64_t i = 0; i < 4; ++i) binary::swap_bytes(header[i]);
+    }
+    OMEGA_H_CHECK(header[0] == 1);
+    uncompressed_bytes = header[2];
+    compressed_bytes = header[3];
+  } else
 #endif
-    encoded = enc_both.substr(nheader_chars);
+  {
+    stream.read(reinterpret_cast<char*>(&uncompressed_bytes),
+        sizeof(uncompressed_bytes));
+    if (needs_swapping) binary::swap_bytes(uncompressed_bytes);
   }
   OMEGA_H_CHECK(uncompressed_bytes == std::uint64_t(size) * sizeof(T));
   HostWrite<T> uncompressed(size);
 #ifdef OMEGA_H_USE_ZLIB
   if (is_compressed) {
-    auto compressed = new ::Bytef[compressed_bytes];
-    base64::decode(encoded, compressed, compressed_bytes);
+    std::vector< ::Bytef> compressed(compressed_bytes);
+    stream.read(reinterpret_cast<char*>(compressed.data()),
+        std::streamsize(compressed_bytes));
     uLong dest_bytes = static_cast<uLong>(uncompressed_bytes);
-    uLong source_bytes = static_cast<uLong>(compressed_bytes);
-    ::Bytef* uncompressed_ptr =
-        reinterpret_cast< ::Bytef*>(nonnull(uncompressed.data()));
-    int ret =
-        ::uncompress(uncompressed_ptr, &dest_bytes, compressed, source_bytes);
-    if (ret != Z_OK) {
-      Omega_h_fail(
-          "code %d: couln't decompress \"%s\"\n", ret, encoded.c_str());
-    }
+    int ret = ::uncompress(
+        reinterpret_cast< ::Bytef*>(nonnull(uncompressed.data())), &dest_bytes,
+        compressed.data(), static_cast<uLong>(compressed_bytes));
+    OMEGA_H_CHECK(ret == Z_OK);
     OMEGA_H_CHECK(dest_bytes == static_cast<uLong>(uncompressed_bytes));
-    delete[] compressed;
   } else
+#else
+  OMEGA_H_CHECK(is_compressed == false);
 #endif
   {
-    base64::decode(encoded, nonnull(uncompressed.data()), uncompressed_bytes);
+    stream.read(reinterpret_cast<char*>(nonnull(uncompressed.data())),
+        std::streamsize(uncompressed_bytes));
   }
+  OMEGA_H_CHECK(bool(stream));
+  stream.seekg(resume);
   return binary::swap_bytes(Read<T>(uncompressed.write()), needs_swapping);
 }
 
+template <typename T>
+static Read<T> read_array(std::istream& stream, std::uint64_t offset, LO size,
+    bool needs_swapping, bool is_compressed, std::streampos* appended_base) {
+  if (offset != std::numeric_limits<std::uint64_t>::max()) {
+    return read_appended_array<T>(
+        stream, offset, size, needs_swapping, is_compressed, appended_base);
+  }
+  return read_array<T>(stream, size, needs_swapping, is_compressed);
+}
+
 void write_tag(
     std::ostream& stream, TagBase const* tag, Int space_dim, Int ent_dim, 
-    Mesh *mesh, bool compress) {
+    Mesh *mesh, bool compress, AppendedData* appended) {
   OMEGA_H_TIME_FUNCTION;
 
   auto ncomps = tag->ncomps();
@@ -281,7 +450,8 @@ void write_tag(
     }
 
     write_array(
-        stream, tag->name(), tag->ncomps(), as<I8>(tag)->array(), compress);
+        stream, tag->name(), tag->ncomps(), as<I8>(tag)->array(), compress,
+        appended);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I8> (ent_dim, ncomps, name, class_ids);
@@ -296,7 +466,8 @@ void write_tag(
     }
 
     write_array(
-        stream, tag->name(), tag->ncomps(), as<I32>(tag)->array(), compress);
+        stream, tag->name(), tag->ncomps(), as<I32>(tag)->array(), compress,
+        appended);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I32> (ent_dim, ncomps, name, class_ids);
@@ -311,7 +482,8 @@ void write_tag(
     }
 
     write_array(
-        stream, tag->name(), tag->ncomps(), as<I64>(tag)->array(), compress);
+        stream, tag->name(), tag->ncomps(), as<I64>(tag)->array(), compress,
+        appended);
 
     if (found != std::string::npos) {
       mesh->change_tagTorc<I64> (ent_dim, ncomps, name, class_ids);
@@ -333,17 +505,19 @@ void write_tag(
         // this filter adds a 3rd zero component to any
         // fields with 2 components for 2D meshes
         write_array(stream, tag->name(), 3, resize_vectors(array, space_dim, 3),
-            compress);
+            compress, appended);
       } else if (tag->ncomps() == symm_ncomps(space_dim)) {
         // Likewise, ParaView has component names specially set up for
         // 3D symmetric tensors
         write_array(stream, tag->name(), symm_ncomps(3),
-            resize_symms(array, space_dim, 3), compress);
+            resize_symms(array, space_dim, 3), compress, appended);
       } else {
-        write_array(stream, tag->name(), tag->ncomps(), array, compress);
+        write_array(
+            stream, tag->name(), tag->ncomps(), array, compress, appended);
       }
     } else {
-      write_array(stream, tag->name(), tag->ncomps(), array, compress);
+      write_array(
+          stream, tag->name(), tag->ncomps(), array, compress, appended);
     }
 
     if (found != std::string::npos) {
@@ -356,11 +530,12 @@ void write_tag(
 }
 
 static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
-    bool needs_swapping, bool is_compressed) {
+    bool needs_swapping, bool is_compressed, std::streampos* appended_base) {
   Omega_h_Type type = OMEGA_H_I8;
   std::string name;
   Int ncomps = -1;
-  if (!read_array_start_tag(stream, &type, &name, &ncomps)) {
+  auto offset = std::numeric_limits<std::uint64_t>::max();
+  if (!read_array_start_tag(stream, &type, &name, &ncomps, &offset)) {
     return false;
   }
   auto class_ids = LOs() ;
@@ -371,7 +546,8 @@ static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
   mesh->remove_tag(ent_dim, name);
   auto size = mesh->nents(ent_dim) * ncomps;
   if (type == OMEGA_H_I8) {
-    auto array = read_array<I8>(stream, size, needs_swapping, is_compressed);
+    auto array = read_array<I8>(
+        stream, offset, size, needs_swapping, is_compressed, appended_base);
     mesh->add_tag(ent_dim, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -380,7 +556,8 @@ static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
     }
 
   } else if (type == OMEGA_H_I32) {
-    auto array = read_array<I32>(stream, size, needs_swapping, is_compressed);
+    auto array = read_array<I32>(
+        stream, offset, size, needs_swapping, is_compressed, appended_base);
     mesh->add_tag(ent_dim, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -389,7 +566,8 @@ static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
     }
 
   } else if (type == OMEGA_H_I64) {
-    auto array = read_array<I64>(stream, size, needs_swapping, is_compressed);
+    auto array = read_array<I64>(
+        stream, offset, size, needs_swapping, is_compressed, appended_base);
     mesh->add_tag(ent_dim, name, ncomps, array, true);
 
     size_t found = name.find("_rc");
@@ -398,7 +576,8 @@ static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
     }
 
   } else {
-    auto array = read_array<Real>(stream, size, needs_swapping, is_compressed);
+    auto array = read_array<Real>(
+        stream, offset, size, needs_swapping, is_compressed, appended_base);
     // undo the resizes done in write_tag()
     if (1 < mesh->dim() && mesh->dim() < 3) {
       if (ncomps == 3) {
@@ -425,15 +604,20 @@ static bool read_tag(std::istream& stream, Mesh* mesh, Int ent_dim,
 
 template <typename T>
 static Read<T> read_known_array(std::istream& stream, std::string const& name,
-    LO nents, Int ncomps, bool needs_swapping, bool is_compressed) {
+    LO nents, Int ncomps, bool needs_swapping, bool is_compressed,
+    std::streampos* appended_base) {
   auto st = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(st.elem_name == "DataArray");
   OMEGA_H_CHECK(st.type == xml_lite::Tag::START);
   OMEGA_H_CHECK(st.attribs["Name"] == name);
   OMEGA_H_CHECK(st.attribs["type"] == Traits<T>::name());
   OMEGA_H_CHECK(st.attribs["NumberOfComponents"] == std::to_string(ncomps));
-  auto array =
-      read_array<T>(stream, nents * ncomps, needs_swapping, is_compressed);
+  auto offset = std::numeric_limits<std::uint64_t>::max();
+  if (st.attribs["format"] == "appended") {
+    offset = std::stoull(st.attribs["offset"]);
+  }
+  auto array = read_array<T>(stream, offset, nents * ncomps, needs_swapping,
+      is_compressed, appended_base);
   auto et = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(et.elem_name == "DataArray");
   OMEGA_H_CHECK(et.type == xml_lite::Tag::END);
@@ -522,17 +706,17 @@ static void read_piece_start_tag(
   *ncells_out = std::stoi(st.attribs["NumberOfCells"]);
 }
 
-static void write_connectivity(
-    std::ostream& stream, Mesh* mesh, Int cell_dim, bool compress) {
+static void write_connectivity(std::ostream& stream, Mesh* mesh,
+    Int cell_dim, bool compress, AppendedData* appended = nullptr) {
   Read<I8> types(mesh->nents(cell_dim), vtk_type(mesh->family(), cell_dim));
-  write_array(stream, "types", 1, types, compress);
+  write_array(stream, "types", 1, types, compress, appended);
   LOs ev2v = mesh->ask_verts_of(cell_dim);
   auto deg = element_degree(mesh->family(), cell_dim, VERT);
   /* starts off already at the end of the first entity's adjacencies,
      increments by a constant value */
   LOs ends(mesh->nents(cell_dim), deg, deg);
-  write_array(stream, "connectivity", 1, ev2v, compress);
-  write_array(stream, "offsets", 1, ends, compress);
+  write_array(stream, "connectivity", 1, ev2v, compress, appended);
+  write_array(stream, "offsets", 1, ends, compress, appended);
 }
 
 static void write_connectivity(
@@ -610,10 +794,10 @@ static void write_connectivity(
 }
 
 static void read_connectivity(std::istream& stream, CommPtr comm, LO ncells,
-    bool needs_swapping, bool is_compressed, Omega_h_Family* family_out,
-    Int* dim_out, LOs* ev2v_out) {
-  auto types = read_known_array<I8>(
-      stream, "types", ncells, 1, needs_swapping, is_compressed);
+    bool needs_swapping, bool is_compressed, std::streampos* appended_base,
+    Omega_h_Family* family_out, Int* dim_out, LOs* ev2v_out) {
+  auto types = read_known_array<I8>(stream, "types", ncells, 1,
+      needs_swapping, is_compressed, appended_base);
   Omega_h_Family family = OMEGA_H_SIMPLEX;
   Int dim = -1;
   if (types.size()) {
@@ -641,42 +825,44 @@ static void read_connectivity(std::istream& stream, CommPtr comm, LO ncells,
   *family_out = family;
   *dim_out = dim;
   auto deg = element_degree(family, dim, VERT);
-  auto ev2v = read_known_array<LO>(
-      stream, "connectivity", ncells * deg, 1, needs_swapping, is_compressed);
+  auto ev2v = read_known_array<LO>(stream, "connectivity", ncells * deg, 1,
+      needs_swapping, is_compressed, appended_base);
   *ev2v_out = ev2v;
-  read_known_array<LO>(
-      stream, "offsets", ncells, 1, needs_swapping, is_compressed);
+  read_known_array<LO>(stream, "offsets", ncells, 1, needs_swapping,
+      is_compressed, appended_base);
 }
 
-static void write_locals(
-    std::ostream& stream, Mesh* mesh, Int ent_dim, bool compress) {
-  write_array(
-      stream, "local", 1, Read<LO>(mesh->nents(ent_dim), 0, 1), compress);
+static void write_locals(std::ostream& stream, Mesh* mesh, Int ent_dim,
+    bool compress, AppendedData* appended = nullptr) {
+  write_array(stream, "local", 1, Read<LO>(mesh->nents(ent_dim), 0, 1),
+      compress, appended);
 }
 
-static void write_owners(
-    std::ostream& stream, Mesh* mesh, Int ent_dim, bool compress) {
+static void write_owners(std::ostream& stream, Mesh* mesh, Int ent_dim,
+    bool compress, AppendedData* appended = nullptr) {
   if (mesh->comm()->size() == 1) return;
-  write_array(stream, "owner", 1, mesh->ask_owners(ent_dim).ranks, compress);
+  write_array(stream, "owner", 1, mesh->ask_owners(ent_dim).ranks, compress,
+      appended);
 }
 
-static void write_vtk_ghost_types(
-    std::ostream& stream, Mesh* mesh, Int ent_dim, bool compress) {
+static void write_vtk_ghost_types(std::ostream& stream, Mesh* mesh,
+    Int ent_dim, bool compress, AppendedData* appended = nullptr) {
   if (mesh->comm()->size() == 1) return;
   const auto owned = mesh->owned(ent_dim);
   auto ghost_types = each_eq_to(owned, static_cast<I8>(0));
   write_array<I8, std::uint8_t>(
-      stream, "vtkGhostType", 1, ghost_types, compress);
+      stream, "vtkGhostType", 1, ghost_types, compress, appended);
 }
 
 static void write_locals_and_owners(std::ostream& stream, Mesh* mesh,
-    Int ent_dim, TagSet const& tags, bool compress) {
+    Int ent_dim, TagSet const& tags, bool compress,
+    AppendedData* appended = nullptr) {
   OMEGA_H_TIME_FUNCTION;
   if (tags[size_t(ent_dim)].count("local")) {
-    write_locals(stream, mesh, ent_dim, compress);
+    write_locals(stream, mesh, ent_dim, compress, appended);
   }
   if (tags[size_t(ent_dim)].count("owner")) {
-    write_owners(stream, mesh, ent_dim, compress);
+    write_owners(stream, mesh, ent_dim, compress, appended);
   }
 }
 
@@ -804,33 +990,35 @@ void write_vtkfile_vtu_start_tag(std::ostream& stream, bool compress) {
 }
 
 void write_vtu(std::ostream& stream, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress) {
+    TagSet const& tags, bool compress, bool appended) {
   OMEGA_H_TIME_FUNCTION;
   default_dim(mesh, &cell_dim);
   verify_vtk_tagset(mesh, cell_dim, tags);
+  AppendedData appended_data;
+  auto const data = appended ? &appended_data : nullptr;
   write_vtkfile_vtu_start_tag(stream, compress);
   stream << "<UnstructuredGrid>\n";
   write_piece_start_tag(stream, mesh, cell_dim);
   stream << "<Cells>\n";
-  write_connectivity(stream, mesh, cell_dim, compress);
+  write_connectivity(stream, mesh, cell_dim, compress, data);
   stream << "</Cells>\n";
   stream << "<Points>\n";
   auto coords = mesh->coords();
   write_array(stream, "coordinates", 3, resize_vectors(coords, mesh->dim(), 3),
-      compress);
+      compress, data);
   stream << "</Points>\n";
   stream << "<PointData>\n";
   /* globals go first so read_vtu() knows where to find them */
   if (mesh->has_tag(VERT, "global") && tags[VERT].count("global")) {
     write_tag(stream, mesh->get_tag<GO>(VERT, "global"), mesh->dim(), VERT, 
-              mesh, compress);
+              mesh, compress, data);
   }
-  write_locals_and_owners(stream, mesh, VERT, tags, compress);
+  write_locals_and_owners(stream, mesh, VERT, tags, compress, data);
   for (Int i = 0; i < mesh->ntags(VERT); ++i) {
     auto tag = mesh->get_tag(VERT, i);
     if (tag->name() != "coordinates" && tag->name() != "global" &&
         tags[VERT].count(tag->name())) {
-      write_tag(stream, tag, mesh->dim(), VERT, mesh, compress);
+      write_tag(stream, tag, mesh->dim(), VERT, mesh, compress, data);
     }
   }
   stream << "</PointData>\n";
@@ -840,21 +1028,22 @@ void write_vtu(std::ostream& stream, Mesh* mesh, Int cell_dim,
       tags[size_t(cell_dim)].count("global")) {
     write_tag(
         stream, mesh->get_tag<GO>(cell_dim, "global"), mesh->dim(), cell_dim,
-        mesh, compress);
+        mesh, compress, data);
   }
-  write_locals_and_owners(stream, mesh, cell_dim, tags, compress);
+  write_locals_and_owners(stream, mesh, cell_dim, tags, compress, data);
   if (tags[size_t(cell_dim)].count("vtkGhostType")) {
-    write_vtk_ghost_types(stream, mesh, cell_dim, compress);
+    write_vtk_ghost_types(stream, mesh, cell_dim, compress, data);
   }
   for (Int i = 0; i < mesh->ntags(cell_dim); ++i) {
     auto tag = mesh->get_tag(cell_dim, i);
     if (tag->name() != "global" && tags[size_t(cell_dim)].count(tag->name())) {
-      write_tag(stream, tag, mesh->dim(), cell_dim, mesh, compress);
+      write_tag(stream, tag, mesh->dim(), cell_dim, mesh, compress, data);
     }
   }
   stream << "</CellData>\n";
   stream << "</Piece>\n";
   stream << "</UnstructuredGrid>\n";
+  if (appended) write_appended_data(stream, appended_data);
   stream << "</VTKFile>\n";
 }
 
@@ -965,6 +1154,7 @@ void read_vtu(std::istream& stream, CommPtr comm, Mesh* mesh) {
 void read_vtu_ents(std::istream& stream, Mesh* mesh) {
   bool needs_swapping, is_compressed;
   read_vtkfile_vtu_start_tag(stream, &needs_swapping, &is_compressed);
+  std::streampos appended_base = -1;
   auto tag1 = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(tag1.elem_name == "UnstructuredGrid");
   LO nverts, ncells;
@@ -976,15 +1166,15 @@ void read_vtu_ents(std::istream& stream, Mesh* mesh) {
   Int dim;
   LOs ev2v;
   read_connectivity(stream, comm, ncells, needs_swapping, is_compressed,
-      &family, &dim, &ev2v);
+      &appended_base, &family, &dim, &ev2v);
   mesh->set_family(family);
   mesh->set_dim(dim);
   auto tag3 = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(tag3.elem_name == "Cells");
   auto tag4 = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(tag4.elem_name == "Points");
-  auto coords = read_known_array<Real>(
-      stream, "coordinates", nverts, 3, needs_swapping, is_compressed);
+  auto coords = read_known_array<Real>(stream, "coordinates", nverts, 3,
+      needs_swapping, is_compressed, &appended_base);
   if (dim < 3) coords = resize_vectors(coords, 3, dim);
   auto tag5 = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(tag5.elem_name == "Points");
@@ -992,14 +1182,15 @@ void read_vtu_ents(std::istream& stream, Mesh* mesh) {
   OMEGA_H_CHECK(tag6.elem_name == "PointData");
   GOs vert_globals;
   if (mesh->could_be_shared(VERT)) {
-    vert_globals = read_known_array<GO>(
-        stream, "global", nverts, 1, needs_swapping, is_compressed);
+    vert_globals = read_known_array<GO>(stream, "global", nverts, 1,
+        needs_swapping, is_compressed, &appended_base);
   } else {
     vert_globals = Read<GO>(nverts, 0, 1);
   }
   build_verts_from_globals(mesh, vert_globals);
   mesh->add_tag(VERT, "coordinates", dim, coords, true);
-  while (read_tag(stream, mesh, VERT, needs_swapping, is_compressed))
+  while (read_tag(
+      stream, mesh, VERT, needs_swapping, is_compressed, &appended_base))
     ;
   mesh->remove_tag(VERT, "local");
   mesh->remove_tag(VERT, "owner");
@@ -1007,13 +1198,14 @@ void read_vtu_ents(std::istream& stream, Mesh* mesh) {
   OMEGA_H_CHECK(tag7.elem_name == "CellData");
   GOs elem_globals;
   if (mesh->could_be_shared(dim)) {
-    elem_globals = read_known_array<GO>(
-        stream, "global", ncells, 1, needs_swapping, is_compressed);
+    elem_globals = read_known_array<GO>(stream, "global", ncells, 1,
+        needs_swapping, is_compressed, &appended_base);
   } else {
     elem_globals = Read<GO>(ncells, 0, 1);
   }
   build_ents_from_elems2verts(mesh, ev2v, vert_globals, elem_globals);
-  while (read_tag(stream, mesh, dim, needs_swapping, is_compressed))
+  while (read_tag(
+      stream, mesh, dim, needs_swapping, is_compressed, &appended_base))
     ;
   mesh->remove_tag(dim, "local");
   mesh->remove_tag(dim, "owner");
@@ -1022,15 +1214,18 @@ void read_vtu_ents(std::istream& stream, Mesh* mesh) {
   auto tag9 = xml_lite::read_tag(stream);
   OMEGA_H_CHECK(tag9.elem_name == "UnstructuredGrid");
   auto tag10 = xml_lite::read_tag(stream);
-  OMEGA_H_CHECK(tag10.elem_name == "VTKFile");
+  /* raw appended bytes follow the last piece; they were already consumed
+     by seeking, so there is nothing left to parse */
+  OMEGA_H_CHECK(
+      tag10.elem_name == "VTKFile" || tag10.elem_name == "AppendedData");
 }
 
 void write_vtu(filesystem::path const& filename, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress) {
-  std::ofstream file(filename.c_str());
+    TagSet const& tags, bool compress, bool appended) {
+  std::ofstream file(filename.c_str(), std::ios::binary);
   OMEGA_H_CHECK(file.is_open());
   ask_for_mesh_tags(mesh, tags);
-  write_vtu(file, mesh, cell_dim, tags, compress);
+  write_vtu(file, mesh, cell_dim, tags, compress, appended);
 }
 
 void write_vtu(
@@ -1159,7 +1354,7 @@ void read_pvtu(filesystem::path const& pvtupath, CommPtr comm, I32* npieces_out,
 }
 
 void write_parallel(filesystem::path const& path, Mesh* mesh, Int cell_dim,
-    TagSet const& tags, bool compress) {
+    TagSet const& tags, bool compress, bool appended) {
   ScopedTimer timer("vtk::write_parallel");
   default_dim(mesh, &cell_dim);
   ask_for_mesh_tags(mesh, tags);
@@ -1179,7 +1374,8 @@ void write_parallel(filesystem::path const& path, Mesh* mesh, Int cell_dim,
     auto const relative_piecepath = filesystem::path("pieces") / "piece";
     write_pvtu(pvtuname, mesh, cell_dim, relative_piecepath, tags);
   }
-  write_vtu(piece_filename(piecepath, rank), mesh, cell_dim, tags, compress);
+  write_vtu(piece_filename(piecepath, rank), mesh, cell_dim, tags, compress,
+      appended);
 }
 
 void write_parallel(
@@ -1201,7 +1397,7 @@ void read_parallel(filesystem::path const& pvtupath, CommPtr comm, Mesh* mesh) {
   bool in_subcomm = (comm->rank() < npieces);
   auto subcomm = comm->split(I32(!in_subcomm), 0);
   if (in_subcomm) {
-    std::ifstream vtustream(vtupath.c_str());
+    std::ifstream vtustream(vtupath.c_str(), std::ios::binary);
     OMEGA_H_CHECK(vtustream.is_open());
     mesh->set_comm(subcomm);
     if (nghost_layers == 0) {
@@ -1308,18 +1504,26 @@ Writer::Writer()
       root_path_("/not-set"),
       cell_dim_(-1),
       compress_(OMEGA_H_DEFAULT_COMPRESS),
+      share_geometry_(false),
+      appended_(false),
       step_(-1),
       pvd_pos_(0) {}
 
 Writer::Writer(filesystem::path const& root_path, Mesh* mesh, Int cell_dim,
-    Real restart_time, bool compress)
+    Real restart_time, bool compress, bool share_geometry, bool appended)
     : mesh_(mesh),
       root_path_(root_path),
       cell_dim_(cell_dim),
       compress_(compress),
+      share_geometry_(share_geometry),
+      appended_(appended),
       step_(0),
       pvd_pos_(0) {
   default_dim(mesh_, &cell_dim_);
+  if (share_geometry_) {
+    xdmf_ = xdmf::Writer(root_path_, mesh_, cell_dim_, restart_time);
+    return;
+  }
   auto const comm = mesh->comm();
   auto const rank = comm->rank();
   if (rank == 0) {
@@ -1338,8 +1542,12 @@ Writer::Writer(filesystem::path const& root_path, Mesh* mesh, Int cell_dim,
 
 void Writer::write(I64 step, Real time, TagSet const& tags) {
   step_ = step;
-  write_parallel(
-      get_step_path(root_path_, step_), mesh_, cell_dim_, tags, compress_);
+  if (share_geometry_) {
+    xdmf_.write(step_, time, tags);
+    return;
+  }
+  write_parallel(get_step_path(root_path_, step_), mesh_, cell_dim_, tags,
+      compress_, appended_);
   if (mesh_->comm()->rank() == 0) {
     update_pvd(root_path_, &pvd_pos_, step_, time);
   }
@@ -1382,7 +1590,7 @@ void FullWriter::write() {
   template void write_p_data_array<T>(                                         \
       std::ostream & stream, std::string const& name, Int ncomps);             \
   template void write_array(std::ostream& stream, std::string const& name,     \
-      Int ncomps, Read<T> array, bool compress);
+      Int ncomps, Read<T> array, bool compress, AppendedData* appended);
 OMEGA_H_EXPL_INST(I8)
 OMEGA_H_EXPL_INST(I32)
 OMEGA_H_EXPL_INST(I64)
@@ -1390,7 +1598,8 @@ OMEGA_H_EXPL_INST(Real)
 #undef OMEGA_H_EXPL_INST
 
 template void write_array<Real, std::uint8_t>(std::ostream& stream,
-    std::string const& name, Int ncomps, Read<Real> array, bool compress);
+    std::string const& name, Int ncomps, Read<Real> array, bool compress,
+    AppendedData* appended);
 
 }  // end namespace vtk
 
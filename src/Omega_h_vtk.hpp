@@ -1,6 +1,8 @@
 #ifndef OMEGA_H_VTK_HPP
 #define OMEGA_H_VTK_HPP
 
+#include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -51,13 +53,25 @@ struct IntTraits;
 template <std::size_t size>
 struct FloatTraits;
 
+/* The arrays of a VTU file written in appended mode: their DataArray
+   elements only carry an offset, and the raw bytes are written after
+   the UnstructuredGrid in one <AppendedData encoding="raw"> block.
+   Until then only the arrays and where their offsets go are kept; each
+   block writes one array and returns its size in bytes. */
+struct AppendedData {
+  std::vector<std::streampos> offset_positions;
+  std::vector<std::function<std::uint64_t(std::ostream&)>> blocks;
+};
+
+void write_appended_data(std::ostream& stream, AppendedData const& appended);
+
 void write_vtkfile_vtu_start_tag(std::ostream& stream, bool compress);
 
 void write_p_tag(std::ostream& stream, TagBase const* tag, Int space_dim);
 
 void write_tag(
     std::ostream& stream, TagBase const* tag, Int space_dim, Int ent_dim, 
-    Mesh *mesh, bool compress);
+    Mesh *mesh, bool compress, AppendedData* appended = nullptr);
 
 template <typename T>
 void write_p_data_array(
@@ -65,13 +79,14 @@ void write_p_data_array(
 
 template <typename T_osh, typename T_vtk = T_osh>
 void write_array(std::ostream& stream, std::string const& name, Int ncomps,
-    Read<T_osh> array, bool compress);
+    Read<T_osh> array, bool compress, AppendedData* appended = nullptr);
 
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
   extern template void write_p_data_array<T>(                                  \
       std::ostream & stream, std::string const& name, Int ncomps);             \
   extern template void write_array(std::ostream& stream,                       \
-      std::string const& name, Int ncomps, Read<T> array, bool compress);
+      std::string const& name, Int ncomps, Read<T> array, bool compress,       \
+      AppendedData* appended);
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
@@ -79,7 +94,8 @@ OMEGA_H_EXPL_INST_DECL(Real)
 #undef OMEGA_H_EXPL_INST_DECL
 
 extern template void write_array<Real, std::uint8_t>(std::ostream& stream,
-    std::string const& name, Int ncomps, Read<Real> array, bool compress);
+    std::string const& name, Int ncomps, Read<Real> array, bool compress,
+    AppendedData* appended);
 
 }  // namespace vtk
 
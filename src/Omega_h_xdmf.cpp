@@ -0,0 +1,495 @@
+#include "Omega_h_file.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Omega_h_element.hpp"
+#include "Omega_h_profile.hpp"
+#include "Omega_h_scalar.hpp"
+#include "Omega_h_vector.hpp"
+#include "Omega_h_xml_lite.hpp"
+
+namespace Omega_h {
+
+namespace xdmf {
+
+namespace {
+
+template <typename T>
+struct NumberType;
+
+template <>
+struct NumberType<I8> {
+  static char const* name() { return "Char"; }
+};
+
+template <>
+struct NumberType<I32> {
+  static char const* name() { return "Int"; }
+};
+
+template <>
+struct NumberType<I64> {
+  static char const* name() { return "Int"; }
+};
+
+template <>
+struct NumberType<Real> {
+  static char const* name() { return "Float"; }
+};
+
+char const* topology_type(Omega_h_Family family, Int cell_dim) {
+  switch (cell_dim) {
+    case 1:
+      return "Polyline";
+    case 2:
+      return family == OMEGA_H_SIMPLEX ? "Triangle" : "Quadrilateral";
+    case 3:
+      return family == OMEGA_H_SIMPLEX ? "Tetrahedron" : "Hexahedron";
+  }
+  Omega_h_fail("xdmf: can't write cells of dimension %d\n", cell_dim);
+}
+
+filesystem::path get_xmf_path(filesystem::path const& root_path) {
+  return root_path / "steps.xmf";
+}
+
+filesystem::path get_rel_geometry_path(I64 geometry) {
+  return filesystem::path("geometry_" + std::to_string(geometry));
+}
+
+filesystem::path get_rel_step_path(I64 step) {
+  auto result = filesystem::path("steps");
+  result /= "step_" + std::to_string(step);
+  return result;
+}
+
+filesystem::path heavy_filename(std::string const& name, I32 rank) {
+  return filesystem::path(name + "_" + std::to_string(rank) + ".bin");
+}
+
+std::string field_name(Int ent_dim, std::string const& name) {
+  return std::string(dimensional_plural_name(ent_dim)) + "_" + name;
+}
+
+/* heavy data is always little-endian, whatever the writing CPU is */
+template <typename T>
+void write_heavy(std::ostream& stream, Read<T> array) {
+  HostRead<T> host_array(binary::swap_bytes(array, !is_little_endian_cpu()));
+  stream.write(reinterpret_cast<char const*>(nonnull(host_array.data())),
+      std::streamsize(sizeof(T)) * host_array.size());
+  OMEGA_H_CHECK(bool(stream));
+}
+
+template <typename T>
+void write_heavy(filesystem::path const& path, Read<T> array) {
+  std::ofstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("xdmf: couldn't open \"%s\"\n", path.c_str());
+  }
+  write_heavy(file, array);
+}
+
+/* where one array of a piece lives: a heavy file and a byte offset */
+struct HeavyRef {
+  filesystem::path file;
+  I64 offset;
+};
+
+template <typename T>
+void write_data_item(
+    std::ostream& stream, LO n, Int ncomps, HeavyRef const& ref) {
+  stream << "<DataItem Dimensions=\"" << n;
+  if (ncomps > 1) stream << ' ' << ncomps;
+  stream << "\" NumberType=\"" << NumberType<T>::name() << "\"";
+  stream << " Precision=\"" << sizeof(T) << "\"";
+  stream << " Format=\"Binary\" Endian=\"Little\"";
+  if (ref.offset) stream << " Seek=\"" << ref.offset << "\"";
+  stream << ">" << ref.file.string() << "</DataItem>\n";
+}
+
+/* the attributes written for one step, described from the calling rank's
+   tags, which every rank shares */
+struct Field {
+  Int ent_dim;
+  std::string name;
+  Omega_h_Type type;
+  Int ncomps;
+};
+
+std::vector<Field> get_fields(Mesh* mesh, Int cell_dim, TagSet const& tags) {
+  std::vector<Field> fields;
+  for (Int ent_dim : {Int(VERT), cell_dim}) {
+    for (auto& name : tags[size_t(ent_dim)]) {
+      if (name == "local" || name == "owner") {
+        fields.push_back({ent_dim, name, OMEGA_H_I32, 1});
+        continue;
+      }
+      /* ghosting is described by the piece structure in XDMF */
+      if (name == "vtkGhostType") continue;
+      if (ent_dim == VERT && name == "coordinates") continue;
+      auto tag = mesh->get_tagbase(ent_dim, name);
+      auto ncomps = tag->ncomps();
+      /* like VTK, XDMF vectors always have three components */
+      if (tag->type() == OMEGA_H_REAL && mesh->dim() == 2 && ncomps == 2) {
+        ncomps = 3;
+      }
+      fields.push_back({ent_dim, name, tag->type(), ncomps});
+    }
+  }
+  return fields;
+}
+
+template <typename T>
+Read<T> get_field_array(Mesh* mesh, Field const& field) {
+  return mesh->get_array<T>(field.ent_dim, field.name);
+}
+
+void write_field_heavy(std::ostream& stream, Mesh* mesh, Field const& field) {
+  if (field.name == "local") {
+    write_heavy(stream, Read<LO>(mesh->nents(field.ent_dim), 0, 1));
+  } else if (field.name == "owner") {
+    write_heavy(stream, mesh->ask_owners(field.ent_dim).ranks);
+  } else if (field.type == OMEGA_H_REAL) {
+    auto array = get_field_array<Real>(mesh, field);
+    auto tag = mesh->get_tagbase(field.ent_dim, field.name);
+    if (field.ncomps != tag->ncomps()) {
+      array = resize_vectors(array, mesh->dim(), 3);
+    }
+    write_heavy(stream, array);
+  } else if (field.type == OMEGA_H_I8) {
+    write_heavy(stream, get_field_array<I8>(mesh, field));
+  } else if (field.type == OMEGA_H_I32) {
+    write_heavy(stream, get_field_array<I32>(mesh, field));
+  } else if (field.type == OMEGA_H_I64) {
+    write_heavy(stream, get_field_array<I64>(mesh, field));
+  }
+}
+
+void write_field_heavy(
+    filesystem::path const& path, Mesh* mesh, Field const& field) {
+  std::ofstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("xdmf: couldn't open \"%s\"\n", path.c_str());
+  }
+  write_field_heavy(file, mesh, field);
+}
+
+I64 type_size(Omega_h_Type type) {
+  switch (type) {
+    case OMEGA_H_I8:
+      return sizeof(I8);
+    case OMEGA_H_I32:
+      return sizeof(I32);
+    case OMEGA_H_I64:
+      return sizeof(I64);
+    case OMEGA_H_F64:
+      return sizeof(Real);
+  }
+  return -1;
+}
+
+void write_field_data_item(
+    std::ostream& stream, Field const& field, LO n, HeavyRef const& ref) {
+  switch (field.type) {
+    case OMEGA_H_I8:
+      write_data_item<I8>(stream, n, field.ncomps, ref);
+      break;
+    case OMEGA_H_I32:
+      write_data_item<I32>(stream, n, field.ncomps, ref);
+      break;
+    case OMEGA_H_I64:
+      write_data_item<I64>(stream, n, field.ncomps, ref);
+      break;
+    case OMEGA_H_F64:
+      write_data_item<Real>(stream, n, field.ncomps, ref);
+      break;
+  }
+}
+
+char const* attribute_type(Int ncomps) {
+  if (ncomps == 1) return "Scalar";
+  if (ncomps == 3) return "Vector";
+  return "Matrix";
+}
+
+/* neighbor collectives are the only gathers Comm offers, so build a
+   graph in which every rank sends to rank 0 */
+template <typename T>
+Read<T> gather_to_root(CommPtr comm, T x) {
+  auto srcs = (comm->rank() == 0) ? Read<I32>(comm->size(), 0, 1)
+                                  : Read<I32>({});
+  auto gather_comm = comm->graph_adjacent(srcs, Read<I32>({0}));
+  return gather_comm->allgather(x);
+}
+
+/* refs holds the connectivity, the coordinates and then each field */
+void write_piece(std::ostream& stream, Mesh* mesh, Int cell_dim,
+    std::vector<Field> const& fields, I32 piece, LO nverts, LO nelems,
+    std::vector<HeavyRef> const& refs) {
+  auto const deg = element_degree(mesh->family(), cell_dim, VERT);
+  stream << "<Grid Name=\"piece_" << piece << "\" GridType=\"Uniform\">\n";
+  stream << "<Topology TopologyType=\""
+         << topology_type(mesh->family(), cell_dim) << "\"";
+  if (cell_dim == EDGE) stream << " NodesPerElement=\"2\"";
+  stream << " NumberOfElements=\"" << nelems << "\">\n";
+  write_data_item<LO>(stream, nelems, deg, refs[0]);
+  stream << "</Topology>\n";
+  stream << "<Geometry GeometryType=\"XYZ\">\n";
+  write_data_item<Real>(stream, nverts, 3, refs[1]);
+  stream << "</Geometry>\n";
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    auto& field = fields[i];
+    auto const n = (field.ent_dim == VERT) ? nverts : nelems;
+    stream << "<Attribute Name=\"" << field.name << "\" AttributeType=\""
+           << attribute_type(field.ncomps) << "\" Center=\""
+           << ((field.ent_dim == VERT) ? "Node" : "Cell") << "\">\n";
+    write_field_data_item(stream, field, n, refs[i + 2]);
+    stream << "</Attribute>\n";
+  }
+  stream << "</Grid>\n";
+}
+
+char const xmf_prologue[] =
+    "<?xml version=\"1.0\"?>\n<Xdmf Version=\"3.0\">\n<Domain>\n"
+    "<Grid Name=\"steps\" GridType=\"Collection\" "
+    "CollectionType=\"Temporal\">\n";
+char const xmf_epilogue[] = "</Grid>\n</Domain>\n</Xdmf>\n";
+
+/* the contents of an existing steps.xmf up to the first step whose time
+   is not before restart_time, like the .pvd of vtk::Writer.
+   every tag of a step is on its own line. (geometry_out) is set to the
+   last geometry those steps refer to, or -1 */
+std::string read_existing_xmf(
+    filesystem::path const& xmfpath, Real restart_time, I64* geometry_out) {
+  *geometry_out = -1;
+  std::ifstream file(xmfpath.c_str());
+  if (!file.is_open()) return xmf_prologue;
+  std::string contents;
+  std::string line;
+  while (contents.size() < sizeof(xmf_prologue) - 1 &&
+         std::getline(file, line)) {
+    contents += line;
+    contents += '\n';
+  }
+  // existing file may be corrupted somehow
+  if (contents != xmf_prologue) return xmf_prologue;
+  std::string step;
+  I64 step_geometry = -1;
+  Int depth = 0;
+  while (std::getline(file, line)) {
+    xml_lite::Tag tag;
+    bool const is_tag = xml_lite::parse_tag(line, &tag);
+    bool const is_grid = is_tag && tag.elem_name == "Grid";
+    if (depth == 0 && !(is_grid && tag.type == xml_lite::Tag::START)) break;
+    if (is_tag && tag.elem_name == "Time") {
+      if (std::stod(tag.attribs["Value"]) >= restart_time) break;
+    }
+    char const geometry_prefix[] = ">geometry_";
+    auto const geometry_pos = line.find(geometry_prefix);
+    if (geometry_pos != std::string::npos) {
+      auto const number =
+          line.substr(geometry_pos + sizeof(geometry_prefix) - 1);
+      step_geometry = max2(step_geometry, I64(std::stoll(number)));
+    }
+    if (is_grid) depth += (tag.type == xml_lite::Tag::START) ? 1 : -1;
+    step += line;
+    step += '\n';
+    if (depth == 0) {
+      contents += step;
+      step.clear();
+      *geometry_out = max2(*geometry_out, step_geometry);
+    }
+  }
+  return contents;
+}
+
+}  // end anonymous namespace
+
+void write(filesystem::path const& path, Mesh* mesh, Int cell_dim,
+    TagSet const& tags, I32 nfiles) {
+  OMEGA_H_TIME_FUNCTION;
+  if (cell_dim == -1) cell_dim = mesh->dim();
+  ask_for_mesh_tags(mesh, tags);
+  auto const comm = mesh->comm();
+  auto const rank = comm->rank();
+  if (nfiles == -1) nfiles = comm->size();
+  OMEGA_H_CHECK(nfiles >= 1);
+  nfiles = min2(nfiles, comm->size());
+  if (rank == 0) filesystem::create_directory(path);
+  comm->barrier();
+  auto const fields = get_fields(mesh, cell_dim, tags);
+  std::stringstream heavy;
+  write_heavy(heavy, mesh->ask_verts_of(cell_dim));
+  write_heavy(heavy, resize_vectors(mesh->coords(), mesh->dim(), 3));
+  for (auto& field : fields) write_field_heavy(heavy, mesh, field);
+  /* each rank's arrays are one contiguous run of its file */
+  auto const offset = binary::write_aggregated_bytes(
+      comm, path, ".bin", nfiles, heavy.str(), false);
+  auto const piece_nverts = gather_to_root(comm, mesh->nverts());
+  auto const piece_nelems = gather_to_root(comm, mesh->nents(cell_dim));
+  auto const piece_offsets = gather_to_root(comm, offset);
+  if (rank == 0) {
+    HostRead<LO> nverts(piece_nverts);
+    HostRead<LO> nelems(piece_nelems);
+    HostRead<I64> offsets(piece_offsets);
+    auto const deg = element_degree(mesh->family(), cell_dim, VERT);
+    std::ofstream file((path / "mesh.xmf").c_str());
+    OMEGA_H_CHECK(file.is_open());
+    file << "<?xml version=\"1.0\"?>\n<Xdmf Version=\"3.0\">\n<Domain>\n";
+    file << "<Grid Name=\"mesh\" GridType=\"Collection\" "
+            "CollectionType=\"Spatial\">\n";
+    for (I32 piece = 0; piece < comm->size(); ++piece) {
+      auto const piece_file =
+          binary::aggregate_file_of(piece, comm->size(), nfiles);
+      auto const heavy_path =
+          filesystem::path(std::to_string(piece_file) + ".bin");
+      auto pos = offsets[piece];
+      std::vector<HeavyRef> refs;
+      refs.push_back({heavy_path, pos});
+      pos += I64(nelems[piece]) * deg * I64(sizeof(LO));
+      refs.push_back({heavy_path, pos});
+      pos += I64(nverts[piece]) * 3 * I64(sizeof(Real));
+      for (auto& field : fields) {
+        refs.push_back({heavy_path, pos});
+        auto const n = (field.ent_dim == VERT) ? nverts[piece] : nelems[piece];
+        pos += I64(n) * field.ncomps * type_size(field.type);
+      }
+      write_piece(file, mesh, cell_dim, fields, piece, nverts[piece],
+          nelems[piece], refs);
+    }
+    file << "</Grid>\n</Domain>\n</Xdmf>\n";
+  }
+  comm->barrier();
+}
+
+void write(
+    filesystem::path const& path, Mesh* mesh, Int cell_dim, I32 nfiles) {
+  if (cell_dim == -1) cell_dim = mesh->dim();
+  write(path, mesh, cell_dim, vtk::get_all_vtk_tags(mesh, cell_dim), nfiles);
+}
+
+Writer::Writer()
+    : mesh_(nullptr),
+      root_path_("/not-set"),
+      cell_dim_(-1),
+      step_(-1),
+      geometry_(-1),
+      xmf_pos_(0) {}
+
+Writer::Writer(filesystem::path const& root_path, Mesh* mesh, Int cell_dim,
+    Real restart_time)
+    : mesh_(mesh),
+      root_path_(root_path),
+      cell_dim_(cell_dim),
+      step_(0),
+      geometry_(-1),
+      xmf_pos_(0) {
+  if (cell_dim_ == -1) cell_dim_ = mesh_->dim();
+  auto const comm = mesh_->comm();
+  if (comm->rank() == 0) {
+    filesystem::create_directory(root_path_);
+    filesystem::create_directory(root_path_ / "steps");
+    auto const xmfpath = get_xmf_path(root_path_);
+    /* new geometries are numbered after the ones the kept steps use */
+    auto const content = read_existing_xmf(xmfpath, restart_time, &geometry_);
+    std::ofstream file(xmfpath.c_str());
+    OMEGA_H_CHECK(file.is_open());
+    file << content;
+    xmf_pos_ = file.tellp();
+    file << xmf_epilogue;
+  }
+  comm->bcast(geometry_);
+}
+
+/* holding on to the written arrays keeps their memory from being reused,
+   so comparing data pointers is a sound test for an unchanged mesh */
+bool Writer::geometry_changed() const {
+  auto const coords = mesh_->coords();
+  auto const verts = mesh_->ask_verts_of(cell_dim_);
+  bool const same = coords_.exists() && verts_.exists() &&
+                    coords.data() == coords_.data() &&
+                    coords.size() == coords_.size() &&
+                    verts.data() == verts_.data() &&
+                    verts.size() == verts_.size();
+  return mesh_->comm()->reduce_or(!same);
+}
+
+void Writer::write_geometry() {
+  OMEGA_H_TIME_FUNCTION;
+  ++geometry_;
+  coords_ = mesh_->coords();
+  verts_ = mesh_->ask_verts_of(cell_dim_);
+  auto const comm = mesh_->comm();
+  auto const rank = comm->rank();
+  auto const dir = root_path_ / get_rel_geometry_path(geometry_);
+  if (rank == 0) filesystem::create_directory(dir);
+  comm->barrier();
+  write_heavy(dir / heavy_filename("coordinates", rank),
+      resize_vectors(coords_, mesh_->dim(), 3));
+  write_heavy(dir / heavy_filename("connectivity", rank), verts_);
+  piece_nverts_ = gather_to_root(comm, mesh_->nverts());
+  piece_nelems_ = gather_to_root(comm, mesh_->nents(cell_dim_));
+}
+
+void Writer::write(I64 step, Real time, TagSet const& tags) {
+  OMEGA_H_TIME_FUNCTION;
+  step_ = step;
+  ask_for_mesh_tags(mesh_, tags);
+  if (geometry_changed()) write_geometry();
+  auto const comm = mesh_->comm();
+  auto const rank = comm->rank();
+  auto const rel_step_path = get_rel_step_path(step_);
+  auto const step_path = root_path_ / rel_step_path;
+  if (rank == 0) filesystem::create_directory(step_path);
+  comm->barrier();
+  auto const fields = get_fields(mesh_, cell_dim_, tags);
+  for (auto& field : fields) {
+    auto const name = field_name(field.ent_dim, field.name);
+    write_field_heavy(step_path / heavy_filename(name, rank), mesh_, field);
+  }
+  if (rank != 0) return;
+  HostRead<LO> nverts(piece_nverts_);
+  HostRead<LO> nelems(piece_nelems_);
+  auto const rel_geometry_path = get_rel_geometry_path(geometry_);
+  std::fstream file;
+  file.open(get_xmf_path(root_path_).c_str(), std::ios::out | std::ios::in);
+  OMEGA_H_CHECK(file.is_open());
+  file.seekp(xmf_pos_);
+  file << std::scientific << std::setprecision(18);
+  file << "<Grid Name=\"step_" << step_
+       << "\" GridType=\"Collection\" CollectionType=\"Spatial\">\n";
+  file << "<Time Value=\"" << time << "\"/>\n";
+  for (I32 piece = 0; piece < comm->size(); ++piece) {
+    std::vector<HeavyRef> refs;
+    refs.push_back(
+        {rel_geometry_path / heavy_filename("connectivity", piece), 0});
+    refs.push_back(
+        {rel_geometry_path / heavy_filename("coordinates", piece), 0});
+    for (auto& field : fields) {
+      auto const name = field_name(field.ent_dim, field.name);
+      refs.push_back({rel_step_path / heavy_filename(name, piece), 0});
+    }
+    write_piece(file, mesh_, cell_dim_, fields, piece, nverts[piece],
+        nelems[piece], refs);
+  }
+  file << "</Grid>\n";
+  xmf_pos_ = file.tellp();
+  file << xmf_epilogue;
+}
+
+void Writer::write(Real time, TagSet const& tags) {
+  this->write(step_, time, tags);
+  ++step_;
+}
+
+void Writer::write(Real time) {
+  this->write(time, vtk::get_all_vtk_tags(mesh_, cell_dim_));
+}
+
+void Writer::write() { this->write(Real(step_)); }
+
+}  // end namespace xdmf
+
+}  // end namespace Omega_h
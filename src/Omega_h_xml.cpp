@@ -157,7 +157,8 @@ ReaderTablesPtr ask_reader_tables() {
 #endif
   if (ptr.use_count() == 0) {
     auto lang = ask_language();
-    ptr = build_reader_tables(*lang);
+    ptr = get_compiled_reader_tables("xml", *lang);
+    if (!ptr) ptr = build_reader_tables(*lang);
   }
   return ptr;
 }
@@ -205,7 +205,9 @@ ReaderTablesPtr ask_reader_tables() {
 #pragma clang diagnostic pop
 #endif
   if (ptr.use_count() == 0) {
-    ptr = build_reader_tables(*(yaml::ask_language()));
+    auto lang = yaml::ask_language();
+    ptr = get_compiled_reader_tables("yaml", *lang);
+    if (!ptr) ptr = build_reader_tables(*lang);
   }
   return ptr;
 }
@@ -8,6 +8,7 @@
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 #ifdef __GNUC__
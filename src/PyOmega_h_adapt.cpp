@@ -12,11 +12,34 @@ void pybind11_adapt(py::module& module) {
       .value("EACH_REBUILD", EACH_REBUILD)
       .value("EXTRA_STATS", EXTRA_STATS)
       .export_values();
+  py::enum_<AdaptStatus>(module, "AdaptStatus", "How far adaptation got")
+      .value("ADAPT_UNCHANGED", ADAPT_UNCHANGED)
+      .value("ADAPT_SATISFIED", ADAPT_SATISFIED)
+      .value("ADAPT_QUALITY_UNSATISFIED", ADAPT_QUALITY_UNSATISFIED)
+      .value("ADAPT_OUT_OF_TIME", ADAPT_OUT_OF_TIME)
+      .value("ADAPT_OUT_OF_REBUILDS", ADAPT_OUT_OF_REBUILDS)
+      .value("ADAPT_SLOW_PROGRESS", ADAPT_SLOW_PROGRESS)
+      .export_values()
+      /* enums are always true in Python, so restore the meaning
+         adapt() had when it returned whether the mesh changed */
+      .def("__bool__", [](AdaptStatus s) { return s != ADAPT_UNCHANGED; })
+      .def("__nonzero__",
+          [](AdaptStatus s) { return s != ADAPT_UNCHANGED; });
   py::class_<AdaptOpts>(
       module, "AdaptOpts", "Options controlling adaptation behavior")
       .def(py::init<Mesh*>())
       .def_readwrite("verbosity", &AdaptOpts::verbosity)
-      .def_readwrite("min_quality_allowed", &AdaptOpts::min_quality_allowed);
+      .def_readwrite("min_quality_allowed", &AdaptOpts::min_quality_allowed)
+      .def_readwrite("nsmooth_sets", &AdaptOpts::nsmooth_sets)
+      .def_readwrite(
+          "should_unghost_locally", &AdaptOpts::should_unghost_locally)
+      .def_readwrite("max_adapt_seconds", &AdaptOpts::max_adapt_seconds)
+      .def_readwrite("max_adapt_rebuilds", &AdaptOpts::max_adapt_rebuilds)
+      .def_readwrite(
+          "min_pass_improvement", &AdaptOpts::min_pass_improvement)
+      .def_readwrite("max_imbalance", &AdaptOpts::max_imbalance)
+      .def_readwrite(
+          "should_weight_imbalance", &AdaptOpts::should_weight_imbalance);
   py::class_<MetricSource>(
       module, "MetricSource", "Describes a single source metric field")
       .def(py::init<Omega_h_Source, Real, std::string const&, Omega_h_Isotropy,
@@ -47,12 +70,15 @@ void pybind11_adapt(py::module& module) {
   module.def("grade_fix_adapt", &grade_fix_adapt,
       "Apply gradation control, possibly fix quality, then adapt",
       py::arg("mesh"), py::arg("opts"), py::arg("target_metric"),
-      py::arg("verbose") = true);
-  module.def("add_implied_metric_tag", &add_implied_metric_tag);
-  module.def("generate_target_metric_tag", &generate_target_metric_tag);
+      py::arg("verbose") = true, py::call_guard<py::gil_scoped_release>());
+  module.def("add_implied_metric_tag", &add_implied_metric_tag,
+      py::call_guard<py::gil_scoped_release>());
+  module.def("generate_target_metric_tag", &generate_target_metric_tag,
+      py::call_guard<py::gil_scoped_release>());
   module.def("approach_metric", &approach_metric, py::arg("mesh"),
-      py::arg("opts"), py::arg("min_step") = 1e-4);
-  module.def("adapt", &adapt);
+      py::arg("opts"), py::arg("min_step") = 1e-4,
+      py::call_guard<py::gil_scoped_release>());
+  module.def("adapt", &adapt, py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace Omega_h
@@ -1,8 +1,73 @@
 #include <Omega_h_array.hpp>
 #include <PyOmega_h.hpp>
 
+#include <algorithm>
+
 namespace Omega_h {
 
+template <class Scalar>
+using NumpyArray = py::array_t<Scalar, py::array::c_style>;
+
+/* The NumPy array keeps a HostRead/HostWrite alive through its base
+   object. Those share the array memory unless it lives on a device, so
+   in host builds this is a view and not a copy. */
+template <class Scalar, class Host>
+static py::array_t<Scalar> to_numpy(Host host, bool writeable) {
+  auto owner = new Host(host);
+  py::capsule base(owner, [](void* p) { delete static_cast<Host*>(p); });
+  py::array_t<Scalar> out(
+      {py::ssize_t(owner->size())}, {py::ssize_t(sizeof(Scalar))},
+      owner->data(), base);
+  if (!writeable) out.attr("setflags")(py::arg("write") = false);
+  return out;
+}
+
+template <class Scalar>
+static py::array_t<Scalar> read_to_numpy(Read<Scalar> a) {
+  return to_numpy<Scalar>(HostRead<Scalar>(a), false);
+}
+
+/* writes through the result only reach the array if it was a view */
+template <class Scalar>
+static py::array_t<Scalar> write_to_numpy(Write<Scalar> a) {
+  HostWrite<Scalar> host(a);
+  return to_numpy<Scalar>(host, host.data() == a.data());
+}
+
+/* In host builds the array borrows the NumPy memory, holding a reference
+   to the NumPy array until Omega_h drops its last reference. Arrays may
+   be released from threads that don't hold the GIL. Only contiguous 1D
+   arrays of the exact dtype are accepted, since converting them would
+   silently detach the Omega_h array from the caller's memory. */
+template <class Scalar>
+static Write<Scalar> from_numpy(
+    py::array a, std::string const& name, bool writeable) {
+  if (!py::isinstance<NumpyArray<Scalar>>(a) || a.ndim() != 1) {
+    throw py::type_error(
+        "expected a contiguous 1D NumPy array of dtype " +
+        std::string(py::str(py::dtype::of<Scalar>())) + ", got " +
+        std::to_string(a.ndim()) + "D " + std::string(py::str(a.dtype())));
+  }
+  auto b = py::reinterpret_borrow<NumpyArray<Scalar>>(a);
+  auto const size = LO(b.size());
+#if defined(OMEGA_H_USE_KOKKOS) || defined(OMEGA_H_USE_CUDA)
+  (void)writeable;
+  HostWrite<Scalar> host(size, name);
+  std::copy_n(b.data(), size, nonnull(host.data()));
+  return host.write();
+#else
+  auto data = writeable ? b.mutable_data() : const_cast<Scalar*>(b.data());
+  auto owner = new py::object(std::move(b));
+  auto release = [owner]() {
+    if (Py_IsInitialized()) {
+      py::gil_scoped_acquire gil;
+      delete owner;
+    }
+  };
+  return Write<Scalar>(data, size, release, name);
+#endif
+}
+
 template <class Scalar, class Wrapper>
 static void pybind11_array_type(py::module& module,
     std::string const& py_scalar, std::string const& py_wrapper) {
@@ -12,12 +77,38 @@ static void pybind11_array_type(py::module& module,
   auto hostwrite_name = std::string("HostWrite_") + py_scalar;
   auto deepcopy_name = std::string("deep_copy_") + py_scalar;
   py::class_<Write<Scalar>>(module, write_name.c_str())
-      .def("size", &Write<Scalar>::size);
+      .def(py::init([](py::array a, std::string const& name) {
+        return from_numpy(a, name, true);
+      }),
+          "Wrap a writeable NumPy array without copying it", py::arg("array"),
+          py::arg("name") = "")
+      .def("size", &Write<Scalar>::size)
+      .def("numpy", &write_to_numpy<Scalar>,
+          "View the array as a NumPy array, writeable in host builds")
+      .def("__array__",
+          [](Write<Scalar> const& a, py::args, py::kwargs) {
+            return write_to_numpy(a);
+          });
   py::class_<Read<Scalar>>(module, read_name.c_str())
       .def(py::init<Write<Scalar>>())
-      .def("size", &Read<Scalar>::size);
+      .def(py::init([](py::array a, std::string const& name) {
+        return Read<Scalar>(from_numpy(a, name, false));
+      }),
+          "Wrap a NumPy array without copying it", py::arg("array"),
+          py::arg("name") = "")
+      .def("size", &Read<Scalar>::size)
+      .def("numpy", &read_to_numpy<Scalar>,
+          "View the array as a read-only NumPy array")
+      .def("__array__", [](Read<Scalar> const& a, py::args, py::kwargs) {
+        return read_to_numpy(a);
+      });
   py::class_<Wrapper, Read<Scalar>>(module, py_wrapper.c_str())
       .def(py::init<Write<Scalar>>())
+      .def(py::init([](py::array a, std::string const& name) {
+        return Wrapper(from_numpy(a, name, false));
+      }),
+          "Wrap a NumPy array without copying it", py::arg("array"),
+          py::arg("name") = "")
       .def(py::init<LO, Scalar, std::string const&>(), py::arg("size"),
           py::arg("value"), py::arg("name") = "");
   py::class_<HostRead<Scalar>>(
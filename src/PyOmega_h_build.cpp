@@ -10,7 +10,8 @@ void pybind11_build(py::module& module) {
       py::arg("comm") /*= pybind11_global_library->world()*/,
       py::arg("family") = OMEGA_H_SIMPLEX, py::arg("x") = 1.0,
       py::arg("y") = 1.0, py::arg("z") = 1.0, py::arg("nx") = 0,
-      py::arg("ny") = 0, py::arg("nz") = 0, py::arg("symmetric") = false);
+      py::arg("ny") = 0, py::arg("nz") = 0, py::arg("symmetric") = false,
+      py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace Omega_h
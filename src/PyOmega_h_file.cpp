@@ -16,20 +16,25 @@ void pybind11_file(py::module& module) {
       &vtk::write_parallel;
   void (*vtk_write_parallel)(std::string const&, Mesh*, bool) =
       &vtk::write_parallel;
-  module.def("gmsh_read_file", gmsh_read_file, "Read a Gmsh file");
-  module.def("gmsh_write_file", gmsh_write_file, "Write a Gmsh file");
+  module.def("gmsh_read_file", gmsh_read_file, "Read a Gmsh file",
+      py::call_guard<py::gil_scoped_release>());
+  module.def("gmsh_write_file", gmsh_write_file, "Write a Gmsh file",
+      py::call_guard<py::gil_scoped_release>());
   module.def("vtk_write_vtu", vtk_write_vtu, "Write a mesh as a .vtu file",
-      py::arg("path"), py::arg("mesh"), py::arg("compress") = true);
+      py::arg("path"), py::arg("mesh"), py::arg("compress") = true,
+      py::call_guard<py::gil_scoped_release>());
   module.def("vtk_write_vtu_dim", vtk_write_vtu_dim,
       "Write entities of one dimension as a .vtu file", py::arg("path"),
-      py::arg("mesh"), py::arg("cell_dim"), py::arg("compress") = true);
+      py::arg("mesh"), py::arg("cell_dim"), py::arg("compress") = true,
+      py::call_guard<py::gil_scoped_release>());
   module.def("vtk_write_parallel", vtk_write_parallel,
       "Write a mesh as a directory of parallel VTK files", py::arg("path"),
-      py::arg("mesh"), py::arg("compress") = true);
+      py::arg("mesh"), py::arg("compress") = true,
+      py::call_guard<py::gil_scoped_release>());
   module.def("vtk_write_parallel_dim", vtk_write_parallel_dim,
       "Write entities of one dimension as a directory of parallel VTK files",
       py::arg("path"), py::arg("mesh"), py::arg("cell_dim"),
-      py::arg("compress") = true);
+      py::arg("compress") = true, py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace Omega_h
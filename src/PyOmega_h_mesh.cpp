@@ -31,7 +31,8 @@ void pybind11_mesh(py::module& module) {
               OMEGA_H_DEF_TYPE(Real, float64)
       .def("min_quality", &Omega_h::Mesh::min_quality)
       .def("max_length", &Omega_h::Mesh::max_length)
-      .def("balance", balance, py::arg("predictive") = false);
+      .def("balance", balance, py::arg("predictive") = false,
+          py::call_guard<py::gil_scoped_release>());
   module.def(
       "new_empty_mesh", []() { return Mesh(pybind11_global_library.get()); });
 }
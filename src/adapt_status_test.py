@@ -0,0 +1,14 @@
+import PyOmega_h as omega_h
+
+comm = omega_h.world()
+mesh = omega_h.build_box(comm, omega_h.Family.SIMPLEX, 1.0, 1.0, 0.0, 4, 4, 0)
+omega_h.add_implied_metric_tag(mesh)
+opts = omega_h.AdaptOpts(mesh)
+opts.verbosity = omega_h.SILENT
+
+# statuses are true only if adaptation changed the mesh
+status = omega_h.adapt(mesh, opts)
+assert status == omega_h.ADAPT_UNCHANGED
+assert not status
+assert omega_h.ADAPT_SATISFIED
+assert omega_h.ADAPT_OUT_OF_REBUILDS
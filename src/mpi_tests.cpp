@@ -1,12 +1,17 @@
+#include <Omega_h_adapt.hpp>
 #include <Omega_h_array_ops.hpp>
 #include <Omega_h_bipart.hpp>
 #include <Omega_h_build.hpp>
 #include <Omega_h_compare.hpp>
 #include <Omega_h_for.hpp>
+#include <Omega_h_ghost.hpp>
 #include <Omega_h_inertia.hpp>
+#include <Omega_h_metric.hpp>
 #include <Omega_h_owners.hpp>
+#include <Omega_h_shape.hpp>
 #include <Omega_h_vtk.hpp>
 
+#include <fstream>
 #include <sstream>
 
 using namespace Omega_h;
@@ -363,6 +368,276 @@ static void test_binary_io(Library* lib, CommPtr comm) {
       OMEGA_H_SAME == compare_meshes(&mesh0, &mesh2, opts, true, true));
 }
 
+static void test_binary_nparts(Library* lib, CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  binary::write("mpi_test_nparts.osh", &mesh0);
+  binary::write_aggregated("mpi_test_aggregated.osh", &mesh0, 2);
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  Mesh mesh1(lib);
+  binary::read("mpi_test_aggregated.osh", comm, &mesh1, true);
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&mesh0, &mesh1, opts, true, true));
+  auto half = comm->split(comm->rank() % 2, comm->rank());
+  auto mesh2 = build_box(half, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  for (auto path : {"mpi_test_nparts.osh", "mpi_test_aggregated.osh"}) {
+    Mesh mesh3(lib);
+    binary::read(path, half, &mesh3);
+    OMEGA_H_CHECK(mesh3.comm()->size() == half->size());
+    /* derived entities are re-oriented canonically when merging parts */
+    OMEGA_H_CHECK(
+        OMEGA_H_SAME == compare_meshes(&mesh2, &mesh3, opts, true, false));
+  }
+}
+
+static Reals rc_coord_sums(Mesh* mesh) {
+  auto rc_ids = mesh->ask_revClass(VERT).ab2b;
+  auto coords = mesh->coords();
+  Write<Real> sums(rc_ids.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto v = rc_ids[i];
+    sums[i] = coords[v * 3] + coords[v * 3 + 1] + coords[v * 3 + 2];
+  };
+  parallel_for(sums.size(), f);
+  return sums;
+}
+
+static void test_binary_merged_rc(Library* lib, CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  mesh0.add_rcField<Real>(VERT, "sum", 1, rc_coord_sums(&mesh0));
+  auto set_name = "part_" + std::to_string(comm->rank());
+  mesh0.class_sets[set_name] = {ClassPair(3, comm->rank())};
+  binary::write("mpi_test_merged_rc.osh", &mesh0);
+  auto half = comm->split(comm->rank() % 2, comm->rank());
+  Mesh mesh1(lib);
+  binary::read("mpi_test_merged_rc.osh", half, &mesh1);
+  OMEGA_H_CHECK(
+      mesh1.get_rcField_array<Real>(VERT, "sum") == rc_coord_sums(&mesh1));
+  /* every part's class sets survive the merge */
+  I32 nsets = 0;
+  for (auto& set : mesh1.class_sets) nsets += (set.first.find("part_") == 0);
+  OMEGA_H_CHECK(half->allreduce(nsets, OMEGA_H_SUM) == comm->size());
+}
+
+static void test_xdmf_aggregated(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  xdmf::write("mpi_test_xdmf", &mesh);
+  xdmf::write("mpi_test_xdmf_aggregated", &mesh, -1, 1);
+  if (comm->rank() == 0) {
+    std::streamoff total = 0;
+    for (I32 rank = 0; rank < comm->size(); ++rank) {
+      auto path = "mpi_test_xdmf/" + std::to_string(rank) + ".bin";
+      std::ifstream file(path, std::ios::binary | std::ios::ate);
+      OMEGA_H_CHECK(file.is_open());
+      total += file.tellg();
+    }
+    std::ifstream file(
+        "mpi_test_xdmf_aggregated/0.bin", std::ios::binary | std::ios::ate);
+    OMEGA_H_CHECK(file.is_open());
+    OMEGA_H_CHECK(file.tellg() == total);
+    OMEGA_H_CHECK(!filesystem::exists("mpi_test_xdmf_aggregated/1.bin"));
+  }
+}
+
+/* a binary MSH 4.1 file with one block per boundary entity and node tags
+   in reverse file order, so that the sliced reader has to look them up */
+static void write_gmsh_binary(filesystem::path const& path, Mesh* mesh) {
+  std::ofstream stream(path.c_str(), std::ios::binary);
+  auto ints = [&](std::vector<I32> const& values) {
+    for (auto value : values) binary::write_value(stream, value, false);
+  };
+  auto const dim = mesh->dim();
+  auto const nverts = mesh->nverts();
+  auto const coords = HostRead<Real>(mesh->coords());
+  stream << "$MeshFormat\n4.1 1 8\n";
+  ints({1});
+  stream << "\n$EndMeshFormat\n$Nodes\n";
+  ints({1, nverts, 1, nverts, dim, 1, 0, nverts});
+  for (LO v = 0; v < nverts; ++v) ints({nverts - v});
+  for (LO v = 0; v < nverts; ++v) {
+    for (Int j = 0; j < 3; ++j) {
+      binary::write_value(stream, j < dim ? coords[v * dim + j] : 0., false);
+    }
+  }
+  stream << "\n$EndNodes\n$Elements\n";
+  std::vector<I32> blocks;
+  I32 nblocks = 0;
+  I32 nents = 0;
+  for (Int ent_dim = 0; ent_dim <= dim; ++ent_dim) {
+    auto const types = std::vector<I32>{15, 1, 2, 4};
+    auto const ev2v = HostRead<LO>(mesh->ask_verts_of(ent_dim));
+    auto const class_dims =
+        HostRead<I8>(mesh->get_array<I8>(ent_dim, "class_dim"));
+    auto const class_ids =
+        HostRead<ClassId>(mesh->get_array<ClassId>(ent_dim, "class_id"));
+    auto const neev = ent_dim + 1;
+    if (ent_dim == dim) {
+      ++nblocks;
+      blocks.insert(blocks.end(), {dim, class_ids[0], types[std::size_t(dim)],
+                                      mesh->nelems()});
+    }
+    for (LO e = 0; e < mesh->nents(ent_dim); ++e) {
+      if (ent_dim < dim) {
+        if (class_dims[e] != ent_dim) continue;
+        ++nblocks;
+        blocks.insert(blocks.end(),
+            {ent_dim, class_ids[e], types[std::size_t(ent_dim)], 1});
+      }
+      blocks.push_back(++nents);
+      for (Int j = 0; j < neev; ++j) {
+        blocks.push_back(nverts - ev2v[e * neev + j]);
+      }
+    }
+  }
+  ints({nblocks, nents, 1, nents});
+  ints(blocks);
+  stream << "\n$EndElements\n";
+}
+
+static void count_classified(Mesh* mesh, GO counts[4], GO id_sums[4]) {
+  for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
+    auto const owned = HostRead<I8>(mesh->owned(ent_dim));
+    auto const class_dims =
+        HostRead<I8>(mesh->get_array<I8>(ent_dim, "class_dim"));
+    auto const class_ids =
+        HostRead<ClassId>(mesh->get_array<ClassId>(ent_dim, "class_id"));
+    GO count = 0;
+    GO id_sum = 0;
+    for (LO e = 0; e < mesh->nents(ent_dim); ++e) {
+      if (!owned[e] || class_dims[e] != ent_dim) continue;
+      ++count;
+      id_sum += class_ids[e];
+    }
+    counts[ent_dim] = mesh->comm()->allreduce(count, OMEGA_H_SUM);
+    id_sums[ent_dim] = mesh->comm()->allreduce(id_sum, OMEGA_H_SUM);
+  }
+}
+
+static void test_gmsh_sliced(Library* lib, CommPtr comm) {
+  auto const path = "mpi_test_sliced.msh";
+  GO counts[2][4];
+  GO id_sums[2][4];
+  GO nelems = 0;
+  if (comm->rank() == 0) {
+    auto mesh = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 0., 5, 4, 0);
+    write_gmsh_binary(path, &mesh);
+    auto serial = gmsh::read(path, lib->self());
+    nelems = serial.nelems();
+    count_classified(&serial, counts[0], id_sums[0]);
+  }
+  comm->bcast(nelems);
+  for (Int ent_dim = 0; ent_dim < 3; ++ent_dim) {
+    comm->bcast(counts[0][ent_dim]);
+    comm->bcast(id_sums[0][ent_dim]);
+  }
+  auto mesh = gmsh::read(path, comm);
+  OMEGA_H_CHECK(mesh.comm()->size() == comm->size());
+  OMEGA_H_CHECK(mesh.nglobal_ents(mesh.dim()) == nelems);
+  OMEGA_H_CHECK(mesh.nelems() < nelems);
+  count_classified(&mesh, counts[1], id_sums[1]);
+  for (Int ent_dim = 0; ent_dim < 3; ++ent_dim) {
+    OMEGA_H_CHECK(counts[0][ent_dim] == counts[1][ent_dim]);
+    OMEGA_H_CHECK(id_sums[0][ent_dim] == id_sums[1][ent_dim]);
+  }
+}
+
+static void test_binary_sliced(Library* lib, CommPtr comm) {
+  auto const path = "mpi_test_serial.osh";
+  if (comm->rank() == 0) {
+    auto mesh = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+    binary::write(path, &mesh);
+  }
+  comm->barrier();
+  auto mesh0 = binary::read(path, comm);
+  mesh0.balance();
+  auto mesh1 = binary::read_sliced(path, comm);
+  OMEGA_H_CHECK(mesh1.nelems() < mesh1.nglobal_ents(3));
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&mesh0, &mesh1, opts, true, false));
+  GO counts[2][4];
+  GO id_sums[2][4];
+  count_classified(&mesh0, counts[0], id_sums[0]);
+  count_classified(&mesh1, counts[1], id_sums[1]);
+  for (Int ent_dim = 0; ent_dim <= 3; ++ent_dim) {
+    OMEGA_H_CHECK(counts[0][ent_dim] == counts[1][ent_dim]);
+    OMEGA_H_CHECK(id_sums[0][ent_dim] == id_sums[1][ent_dim]);
+  }
+}
+
+static void test_box_sliced(CommPtr comm, Omega_h_Family family, Real x,
+    Real y, Real z, LO nx, LO ny, LO nz) {
+  auto mesh0 = build_box(comm, family, x, y, z, nx, ny, nz);
+  auto mesh1 = build_box_sliced(comm, family, x, y, z, nx, ny, nz);
+  OMEGA_H_CHECK(mesh1.dim() == mesh0.dim());
+  OMEGA_H_CHECK(mesh1.nelems() < mesh1.nglobal_ents(mesh1.dim()));
+  GO counts[2][4];
+  GO id_sums[2][4];
+  count_classified(&mesh0, counts[0], id_sums[0]);
+  count_classified(&mesh1, counts[1], id_sums[1]);
+  for (Int ent_dim = 0; ent_dim <= mesh0.dim(); ++ent_dim) {
+    OMEGA_H_CHECK(
+        mesh0.nglobal_ents(ent_dim) == mesh1.nglobal_ents(ent_dim));
+    OMEGA_H_CHECK(counts[0][ent_dim] == counts[1][ent_dim]);
+    OMEGA_H_CHECK(id_sums[0][ent_dim] == id_sums[1][ent_dim]);
+  }
+  if (family == OMEGA_H_SIMPLEX) {
+    auto const volume = get_sum(comm,
+        mesh1.owned_array(mesh1.dim(), measure_elements_real(&mesh1), 1));
+    OMEGA_H_CHECK(are_close(volume, x * (y ? y : 1.) * (z ? z : 1.)));
+  }
+}
+
+static void test_adapt_rebalance(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  auto coords = mesh.coords();
+  Write<Real> metrics(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto h = (coords[v * 2] < 0.15) ? 0.01 : 0.125;
+    metrics[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "metric", 1, Reals(metrics));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.max_imbalance = 1.5;
+  OMEGA_H_CHECK(adapt(&mesh, opts) == ADAPT_SATISFIED);
+  OMEGA_H_CHECK(mesh.imbalance() < 1.5 * 1.5);
+}
+
+static void test_unghost_mesh(CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  mesh0.add_tag(VERT, "field", 1, get_vector_norms(mesh0.coords(), 3));
+  mesh0.set_parting(OMEGA_H_GHOSTED);
+  auto mesh1 = mesh0;
+  mesh0.set_parting(OMEGA_H_ELEM_BASED);
+  unghost_mesh(&mesh1);
+  OMEGA_H_CHECK(mesh1.parting() == OMEGA_H_ELEM_BASED);
+  OMEGA_H_CHECK(mesh1.nelems() == mesh0.nelems());
+  for (Int ent_dim = 0; ent_dim <= 3; ++ent_dim) {
+    OMEGA_H_CHECK(mesh1.nents(ent_dim) == mesh0.nents(ent_dim));
+    auto nowned = get_sum(mesh1.owned(ent_dim));
+    OMEGA_H_CHECK(comm->allreduce(GO(nowned), OMEGA_H_SUM) ==
+                  mesh0.nglobal_ents(ent_dim));
+    auto globals = mesh1.globals(ent_dim);
+    OMEGA_H_CHECK(mesh1.sync_array(ent_dim, globals, 1) == globals);
+  }
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(compare_meshes(&mesh0, &mesh1, opts, true) == OMEGA_H_SAME);
+}
+
+static void test_adapt_unghost_locally(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.add_tag(VERT, "metric", 1,
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.05)));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.should_unghost_locally = true;
+  OMEGA_H_CHECK(adapt(&mesh, opts) == ADAPT_SATISFIED);
+  OMEGA_H_CHECK(mesh.parting() == OMEGA_H_ELEM_BASED);
+  auto globals = mesh.globals(VERT);
+  OMEGA_H_CHECK(mesh.sync_array(VERT, globals, 1) == globals);
+}
+
 static void test_two_ranks(Library* lib, CommPtr comm) {
   test_two_ranks_dist(comm);
   test_two_ranks_dist_for_two_variable_sized_actors(comm);
@@ -424,5 +699,20 @@ int main(int argc, char** argv) {
     }
   }
   world->barrier();
+  if (world->size() > 2) {
+    test_binary_nparts(&lib, world);
+    test_binary_merged_rc(&lib, world);
+  }
+  if (world->size() > 1) {
+    test_gmsh_sliced(&lib, world);
+    test_binary_sliced(&lib, world);
+    test_box_sliced(world, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+    test_box_sliced(world, OMEGA_H_SIMPLEX, 2., 1., 0., 8, 2, 0);
+    test_box_sliced(world, OMEGA_H_HYPERCUBE, 2., 1., 1., 2, 2, 4);
+    test_adapt_rebalance(world);
+    test_unghost_mesh(world);
+    test_adapt_unghost_locally(world);
+  }
+  test_xdmf_aggregated(world);
   test_rib(world);
 }
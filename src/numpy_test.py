@@ -0,0 +1,28 @@
+import numpy
+import PyOmega_h as omega_h
+
+comm = omega_h.world()
+mesh = omega_h.build_box(comm, omega_h.Family.SIMPLEX, 1.0, 1.0, 0.0, 4, 4, 0)
+nverts = mesh.nents(omega_h.VERT)
+
+# arrays built from NumPy share its memory
+values = numpy.arange(nverts, dtype=numpy.float64)
+array = omega_h.Write_float64(values)
+values[0] = 42.0
+assert array.numpy()[0] == 42.0
+
+# tags come back as read-only views
+mesh.add_tag_float64(omega_h.VERT, "field", 1, omega_h.Reals(values))
+field = mesh.get_array_float64(omega_h.VERT, "field").numpy()
+assert numpy.array_equal(field, values)
+assert not field.flags.writeable
+
+# arrays that would need a converted copy are refused
+for bad in [numpy.arange(nverts, dtype=numpy.int32), values[::2],
+            numpy.zeros((2, 2))]:
+    try:
+        omega_h.Reals(bad)
+    except TypeError:
+        pass
+    else:
+        raise AssertionError("Reals accepted " + repr(bad))
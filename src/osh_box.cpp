@@ -43,7 +43,11 @@ int main(int argc, char** argv) {
     }
   }
   auto symmetric = cmdline.parsed("--symmetric");
-  auto mesh = Omega_h::build_box(world, family, x, y, z, nx, ny, nz, symmetric);
+  auto mesh = (world->size() > 1)
+                  ? Omega_h::build_box_sliced(
+                        world, family, x, y, z, nx, ny, nz, symmetric)
+                  : Omega_h::build_box(
+                        world, family, x, y, z, nx, ny, nz, symmetric);
   Omega_h::binary::write(outdir, &mesh);
   return 0;
 }
@@ -44,22 +44,31 @@ int main(int argc, char** argv) {
   auto is_out = (world->rank() < nparts_out);
   auto comm_out = world->split(int(is_out), 0);
   auto mesh = Omega_h::Mesh(&lib);
-  auto version = Omega_h::binary::read_version(path_in, world);
-  if (is_in) {
-    Omega_h::binary::read_in_comm(path_in, comm_in, &mesh, version);
-    if (nparts_out < nparts_in) {
-      Omega_h_fail(
-          "partitioning to a smaller part count not yet implemented\n");
+  if (nparts_in == 1 && nparts_out > 1) {
+    /* a serial mesh is read in slices straight onto the output ranks,
+       so no rank ever holds all of it */
+    if (is_out) {
+      mesh = Omega_h::binary::read_sliced(path_in, comm_out);
+      Omega_h::binary::write(path_out, &mesh);
+    }
+  } else {
+    auto version = Omega_h::binary::read_version(path_in, world);
+    if (is_in) {
+      Omega_h::binary::read_in_comm(path_in, comm_in, &mesh, version);
+      if (nparts_out < nparts_in) {
+        Omega_h_fail(
+            "partitioning to a smaller part count not yet implemented\n");
+      }
+    }
+    if (is_in || is_out) mesh.set_comm(comm_out);
+    if (is_out) {
+      if (nparts_out != nparts_in) mesh.balance();
+      Omega_h::binary::write(path_out, &mesh);
     }
-  }
-  if (is_in || is_out) mesh.set_comm(comm_out);
-  if (is_out) {
-    if (nparts_out != nparts_in) mesh.balance();
-    Omega_h::binary::write(path_out, &mesh);
   }
   world->barrier();
   auto t1 = Omega_h::now();
-  auto imb = mesh.imbalance();
+  auto imb = is_out ? mesh.imbalance() : 0.0;
   if (!world->rank()) {
     std::cout << "repartitioning took " << (t1 - t0) << " seconds\n";
     std::cout << "imbalance is " << imb << "\n";
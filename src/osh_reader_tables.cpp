@@ -0,0 +1,52 @@
+#include <fstream>
+#include <iostream>
+
+#include <Omega_h_language.hpp>
+#include <Omega_h_math_lang.hpp>
+#include <Omega_h_regex.hpp>
+#include <Omega_h_xml.hpp>
+#include <Omega_h_yaml.hpp>
+
+/* Generates the source file holding the reader tables of the built-in
+   languages. It is built from the parser sources alone, so it always
+   constructs the tables at runtime. */
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "usage: " << argv[0] << " output.cpp\n";
+    return -1;
+  }
+  struct Entry {
+    char const* name;
+    Omega_h::LanguagePtr (*ask_language)();
+    Omega_h::ReaderTablesPtr (*ask_reader_tables)();
+  };
+  Entry const entries[] = {
+      {"regex", Omega_h::regex::ask_language,
+          Omega_h::regex::ask_reader_tables},
+      {"math_lang", Omega_h::math_lang::ask_language,
+          Omega_h::math_lang::ask_reader_tables},
+      {"xml", Omega_h::xml::ask_language, Omega_h::xml::ask_reader_tables},
+      {"yaml", Omega_h::yaml::ask_language, Omega_h::yaml::ask_reader_tables},
+  };
+  std::ofstream file(argv[1]);
+  if (!file) {
+    std::cerr << "could not open " << argv[1] << " for writing\n";
+    return -1;
+  }
+  file << "/* generated by osh_reader_tables, do not edit */\n\n";
+  file << "#include \"Omega_h_language.hpp\"\n\n";
+  file << "namespace Omega_h {\n\n";
+  for (auto& entry : entries) {
+    Omega_h::write_compiled_reader_tables(
+        file, entry.name, *entry.ask_language(), *entry.ask_reader_tables());
+  }
+  file << "CompiledReaderTables const* find_compiled_reader_tables(\n"
+     << "    std::string const& name) {\n";
+  for (auto& entry : entries) {
+    file << "  if (name == \"" << entry.name << "\") return &" << entry.name
+       << "_tables;\n";
+  }
+  file << "  return nullptr;\n}\n\n}  // end namespace Omega_h\n";
+  return 0;
+}
@@ -18,6 +18,7 @@ int main(int argc, char** argv) {
   char const* filea = nullptr;
   char const* fileb = nullptr;
   bool allow_superset = false;
+  bool early_exit = false;
   for (int i = 1; i < argc; ++i) {
     if (get_tol) {
       tol = atof(argv[i]);
@@ -45,6 +46,10 @@ int main(int argc, char** argv) {
       allow_superset = true;
       continue;
     }
+    if (!strcmp(argv[i], "-early-exit")) {
+      early_exit = true;
+      continue;
+    }
     if (!filea) {
       filea = argv[i];
       continue;
@@ -73,6 +78,7 @@ int main(int argc, char** argv) {
     std::cout << "    -Floor <$val> (Overrides the default floor tolerance of "
                  "0.0.)\n";
     std::cout << "    -superset (Allow result to have more arrays than gold)\n";
+    std::cout << "    -early-exit (Stop at the first array that differs)\n";
     return -1;
   }
   Omega_h::Mesh a(&lib);
@@ -81,6 +87,7 @@ int main(int argc, char** argv) {
   Omega_h::binary::read(fileb, lib.world(), &b);
   auto opts = MeshCompareOpts::init(
       &a, VarCompareOpts{VarCompareOpts::RELATIVE, tol, floor});
+  opts.early_exit = early_exit;
   auto res = compare_meshes(&a, &b, opts, true);
   if (res == OMEGA_H_SAME) return 0;
   if (allow_superset && res == OMEGA_H_MORE) return 0;
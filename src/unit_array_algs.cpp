@@ -293,6 +293,96 @@ static void test_expr2() {
       Reals({1.0, std::exp(1.0), std::exp(2.0), std::exp(3.0)})));
 }
 
+static void test_compiled_expr(ExprEnv& env, std::string const& expr) {
+  ExprOpsReader reader;
+  auto op = reader.read_ops(expr);
+  CompiledExpr compiled(op, env);
+  auto result = compiled.eval(env);
+  auto expected = op->eval(env);
+  OMEGA_H_CHECK(are_close(result, any_cast<Reals>(expected)));
+}
+
+static void test_compiled_expr() {
+  using Omega_h::any;
+  using Omega_h::any_cast;
+  ExprEnv env(4, 3);
+  env.register_variable("j", any(vector_3(0, 1, 0)));
+  env.register_variable("x", any(Reals({0, 1, 2, 3})));
+  env.register_variable("v", any(Reals({0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 3, 0})));
+  test_compiled_expr(env, "x^2");
+  test_compiled_expr(env, "-x + 1");
+  test_compiled_expr(env, "v - 1.5 * j");
+  test_compiled_expr(env, "pi * j * x");
+  test_compiled_expr(env, "vector(x, 0, 0)");
+  test_compiled_expr(env, "vector(x)");
+  test_compiled_expr(env, "exp(x) + sqrt(x) + sin(x) * cos(x) + erf(x)");
+  test_compiled_expr(env, "norm(v) + v(1) + v * v");
+  test_compiled_expr(env, "I * v");
+  test_compiled_expr(env, "matrix(x, 1, 0, 0, 1, 0, 0, 0, 1) * v");
+  test_compiled_expr(env, "v / (x + 1)");
+  test_compiled_expr(env, "((x > 1.5) || (x < 0.5)) ? 1 : x");
+  test_compiled_expr(env, "(x > 0.5) && (x < 2.5) ? x : 2 * x");
+  test_compiled_expr(env, "a = x * 2; b = a + 1; a * b");
+  /* uniforms are read at evaluation time */
+  env.register_variable("t", any(Real(1.0)));
+  ExprOpsReader reader;
+  CompiledExpr compiled(reader.read_ops("t * x"), env);
+  env.register_variable("t", any(Real(2.0)));
+  OMEGA_H_CHECK(are_close(compiled.eval(env), Reals({0, 2, 4, 6})));
+  /* user functions can't be lowered */
+  env.register_function("f", [](ExprEnv::Args& args) { return args.at(0); });
+  bool failed = false;
+  try {
+    CompiledExpr(reader.read_ops("f(x)"), env);
+  } catch (ParserFail const&) {
+    failed = true;
+  }
+  OMEGA_H_CHECK(failed);
+  /* more entities than fit in one block, with a partial last block */
+  ExprEnv env2(37, 2);
+  env2.register_variable("x", any(Reals(37, 0.5)));
+  env2.register_variable("v", any(Reals(37 * 2, 0.25)));
+  test_compiled_expr(env2, "matrix(x, 1, 0, x) * (matrix(1, 0, x, 1) * v)");
+}
+
+static void test_field_expr() {
+  using Omega_h::any;
+  ExprEnv env(4, 3);
+  env.register_variable("x", any(Reals({0, 1, 2, 3})));
+  env.register_variable("t", any(Real(1.0)));
+  FieldExpr expr("t * x + 1");
+  OMEGA_H_CHECK(are_close(expr.eval(env), Reals({1, 2, 3, 4})));
+  OMEGA_H_CHECK(expr.is_compiled());
+  /* a variable changing type recompiles */
+  env.register_variable("t", any(Reals({1, 1, 2, 2})));
+  OMEGA_H_CHECK(are_close(expr.eval(env), Reals({1, 2, 5, 7})));
+  OMEGA_H_CHECK(expr.is_compiled());
+  /* constants are repeated per entity */
+  FieldExpr constant("vector(1, 2, 3)");
+  OMEGA_H_CHECK(are_close(
+      constant.eval(env), Reals({1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3})));
+  /* user functions are interpreted */
+  env.register_function("f", [](ExprEnv::Args& args) { return args.at(0); });
+  FieldExpr user("f(x) * 2");
+  OMEGA_H_CHECK(are_close(user.eval(env), Reals({0, 2, 4, 6})));
+  OMEGA_H_CHECK(!user.is_compiled());
+}
+
+static void test_borrowed_write() {
+#if !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+  Real data[3] = {1, 2, 3};
+  int nreleased = 0;
+  {
+    Reals a(Write<Real>(data, 3, [&nreleased]() { ++nreleased; }));
+    auto b = a;
+    OMEGA_H_CHECK(b.data() == data);
+    OMEGA_H_CHECK(are_close(a, Reals({1, 2, 3})));
+    OMEGA_H_CHECK(nreleased == 0);
+  }
+  OMEGA_H_CHECK(nreleased == 1);
+#endif
+}
+
 static void test_array_from_kokkos() {
 #ifdef OMEGA_H_USE_KOKKOS
   Kokkos::View<double**> managed(
@@ -331,5 +421,8 @@ int main(int argc, char** argv) {
   test_scalar_ptr();
   test_expr();
   test_expr2();
+  test_compiled_expr();
+  test_field_expr();
+  test_borrowed_write();
   test_array_from_kokkos();
 }
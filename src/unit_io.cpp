@@ -1,4 +1,5 @@
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_base64.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_vtk.hpp"
@@ -986,6 +987,114 @@ static void test_file(Library* lib) {
   }
 }
 
+static void test_compare_meshes(Library* lib) {
+  auto a = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  auto b = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  a.add_tag(VERT, "field", 1, Reals(a.nverts(), 1.0));
+  a.add_tag(VERT, "ids", 1, LOs(a.nverts(), 0, 1));
+  b.add_tag(VERT, "field", 1, Reals(b.nverts(), 1.0 + 1e-9));
+  b.add_tag(VERT, "ids", 1, LOs(b.nverts(), 0, 1));
+  auto opts = MeshCompareOpts::init(&a, VarCompareOpts::defaults());
+  OMEGA_H_CHECK(compare_meshes(&a, &b, opts, false) == OMEGA_H_SAME);
+  b.set_tag(VERT, "field", Reals(b.nverts(), 1.1));
+  OMEGA_H_CHECK(compare_meshes(&a, &b, opts, false) == OMEGA_H_DIFF);
+  b.set_tag(VERT, "ids", LOs(b.nverts(), 1, 1));
+  opts.early_exit = true;
+  OMEGA_H_CHECK(compare_meshes(&a, &b, opts, false) == OMEGA_H_DIFF);
+  opts.tags2opts[VERT]["field"] = VarCompareOpts::none();
+  opts.tags2opts[VERT]["ids"] = VarCompareOpts::none();
+  OMEGA_H_CHECK(compare_meshes(&a, &b, opts, false) == OMEGA_H_SAME);
+}
+
+static std::streamoff file_size(filesystem::path const& path) {
+  std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+  OMEGA_H_CHECK(file.is_open());
+  return file.tellg();
+}
+
+static void test_incremental_file(Library* lib, Mesh* mesh,
+    filesystem::path const& path, filesystem::path const& previous) {
+  OMEGA_H_CHECK(binary::write_incremental(path, mesh, previous));
+  Mesh mesh1(lib);
+  binary::read(path, lib->world(), &mesh1);
+  auto opts = MeshCompareOpts::init(mesh, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(compare_meshes(mesh, &mesh1, opts, true) == OMEGA_H_SAME);
+}
+
+static void test_incremental_file(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  mesh.add_tag(VERT, "field", 1, Reals(mesh.nverts(), 1.0));
+  test_incremental_file(lib, &mesh, "incremental_0.osh", "");
+  mesh.set_tag(VERT, "field", Reals(mesh.nverts(), 2.0));
+  test_incremental_file(lib, &mesh, "incremental_1.osh", "incremental_0.osh");
+  mesh.set_tag(VERT, "field", Reals(mesh.nverts(), 3.0));
+  test_incremental_file(lib, &mesh, "incremental_2.osh", "incremental_1.osh");
+  OMEGA_H_CHECK(file_size("incremental_2.osh/0.osh") <
+                file_size("incremental_0.osh/0.osh") / 4);
+}
+
+static void test_shared_geometry_writer(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  mesh.add_tag(VERT, "field", 1, Reals(mesh.nverts(), 1.0));
+  if (filesystem::exists("shared_geometry")) {
+    filesystem::remove_all("shared_geometry");
+  }
+  vtk::Writer writer("shared_geometry", &mesh, -1, 0.0,
+      OMEGA_H_DEFAULT_COMPRESS, true);
+  writer.write();
+  mesh.set_tag(VERT, "field", Reals(mesh.nverts(), 2.0));
+  writer.write();
+  OMEGA_H_CHECK(filesystem::exists("shared_geometry/steps.xmf"));
+  OMEGA_H_CHECK(
+      filesystem::exists("shared_geometry/geometry_0/coordinates_0.bin"));
+  OMEGA_H_CHECK(!filesystem::exists("shared_geometry/geometry_1"));
+  OMEGA_H_CHECK(
+      filesystem::exists("shared_geometry/steps/step_1/vertices_field_0.bin"));
+  OMEGA_H_CHECK(
+      file_size("shared_geometry/steps/step_1/vertices_field_0.bin") ==
+      std::streamoff(mesh.nverts()) * std::streamoff(sizeof(Real)));
+  mesh.set_coords(multiply_each_by(mesh.coords(), 2.0));
+  writer.write();
+  OMEGA_H_CHECK(
+      filesystem::exists("shared_geometry/geometry_1/connectivity_0.bin"));
+  /* restarting keeps the two steps before time 1.5 and the geometry they
+     use, so the new step gets a new geometry */
+  filesystem::remove_all("shared_geometry/geometry_1");
+  vtk::Writer restarted("shared_geometry", &mesh, -1, 1.5,
+      OMEGA_H_DEFAULT_COMPRESS, true);
+  restarted.write(2, 2.0, vtk::get_all_vtk_tags(&mesh, mesh.dim()));
+  OMEGA_H_CHECK(
+      filesystem::exists("shared_geometry/geometry_1/connectivity_0.bin"));
+  std::ifstream xmf("shared_geometry/steps.xmf");
+  std::stringstream contents;
+  contents << xmf.rdbuf();
+  auto const text = contents.str();
+  Int nsteps = 0;
+  for (auto pos = text.find("<Time "); pos != std::string::npos;
+       pos = text.find("<Time ", pos + 1)) {
+    ++nsteps;
+  }
+  OMEGA_H_CHECK(nsteps == 3);
+}
+
+static void test_xdmf(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  xdmf::write("xdmf_mesh", &mesh);
+  OMEGA_H_CHECK(filesystem::exists("xdmf_mesh/mesh.xmf"));
+  /* connectivity comes first, then the coordinates */
+  std::ifstream file("xdmf_mesh/0.bin", std::ios::binary);
+  OMEGA_H_CHECK(file.is_open());
+  file.seekg(std::streamoff(mesh.nelems()) * 4 * std::streamoff(sizeof(LO)));
+  HostWrite<Real> coords(mesh.nverts() * 3);
+  file.read(reinterpret_cast<char*>(coords.data()),
+      std::streamsize(coords.size()) * std::streamsize(sizeof(Real)));
+  OMEGA_H_CHECK(bool(file));
+  if (!is_little_endian_cpu()) {
+    for (LO i = 0; i < coords.size(); ++i) binary::swap_bytes(coords[i]);
+  }
+  OMEGA_H_CHECK(Reals(coords.write()) == mesh.coords());
+}
+
 #ifdef OMEGA_H_USE_GMSH
 Omega_h_Comparison light_compare_meshes(Mesh& a, Mesh& b) {
   OMEGA_H_CHECK(a.comm()->size() == b.comm()->size());
@@ -1055,6 +1164,60 @@ static void test_gmsh_parallel(Library* lib) {
 
 #endif  // OMEGA_H_USE_GMSH
 
+static const char* GMSH_TWO_TRIS_MSH41 = R"GMSH(
+$MeshFormat
+4.1 0 8
+$EndMeshFormat
+$Nodes
+1 4 10 40
+2 1 0 4
+10
+20
+30
+40
+0 0 0
+1 0 0
+1 1 0
+0 1 0
+$EndNodes
+$Elements
+1 2 1 2
+2 1 2 2
+1 10 20 30
+2 10 30 40
+$EndElements
+)GMSH";
+
+/* the same mesh as GMSH_TWO_TRIS_MSH41, in the binary layout */
+static std::string gmsh_two_tris_binary() {
+  std::stringstream stream;
+  auto ints = [&](std::vector<I32> const& values) {
+    for (auto value : values) binary::write_value(stream, value, false);
+  };
+  stream << "$MeshFormat\n4.1 1 8\n";
+  ints({1});
+  stream << "\n$EndMeshFormat\n$Nodes\n";
+  ints({1, 4, 10, 40, 2, 1, 0, 4, 10, 20, 30, 40});
+  for (Real x : {0., 0., 0., 1., 0., 0., 1., 1., 0., 0., 1., 0.}) {
+    binary::write_value(stream, x, false);
+  }
+  stream << "\n$EndNodes\n$Elements\n";
+  ints({1, 2, 1, 2, 2, 1, 2, 2, 1, 10, 20, 30, 2, 10, 30, 40});
+  stream << "\n$EndElements\n";
+  return stream.str();
+}
+
+static void test_gmsh_binary(Library* lib) {
+  std::istringstream text(GMSH_TWO_TRIS_MSH41);
+  auto mesh0 = Omega_h::gmsh::read(text, lib->self());
+  std::istringstream bin(gmsh_two_tris_binary());
+  auto mesh1 = Omega_h::gmsh::read(bin, lib->self());
+  OMEGA_H_CHECK(mesh0.nverts() == 4);
+  OMEGA_H_CHECK(mesh0.nelems() == 2);
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(compare_meshes(&mesh0, &mesh1, opts, true) == OMEGA_H_SAME);
+}
+
 static void test_gmsh(Library* lib) {
   const auto nranks = lib->world()->size();
   {
@@ -1114,6 +1277,20 @@ static void test_gmsh(Library* lib) {
   }
 }
 
+static void test_base64() {
+  std::string const bytes = "Omega_h streams base64";
+  for (std::size_t size = 0; size <= bytes.size(); ++size) {
+    std::stringstream stream;
+    base64::encode(stream, bytes.data(), size);
+    stream << '\n';
+    OMEGA_H_CHECK(stream.str().size() == base64::encoded_size(size) + 1);
+    std::string decoded(size, '\0');
+    base64::read_decoded(stream, &decoded[0], size);
+    OMEGA_H_CHECK(decoded == bytes.substr(0, size));
+    OMEGA_H_CHECK(stream.get() == '\n');
+  }
+}
+
 static void test_xml() {
   xml_lite::Tag tag;
   OMEGA_H_CHECK(!xml_lite::parse_tag("AQAAAAAAAADABg", &tag));
@@ -1134,10 +1311,10 @@ static void test_xml() {
   OMEGA_H_CHECK(tag.type == xml_lite::Tag::END);
 }
 
-static void test_read_vtu(Mesh* mesh0) {
+static void test_read_vtu(Mesh* mesh0, bool compress, bool appended) {
   std::stringstream stream;
-  vtk::write_vtu(
-      stream, mesh0, mesh0->dim(), vtk::get_all_vtk_tags(mesh0, mesh0->dim()));
+  vtk::write_vtu(stream, mesh0, mesh0->dim(),
+      vtk::get_all_vtk_tags(mesh0, mesh0->dim()), compress, appended);
   Mesh mesh1(mesh0->library());
   vtk::read_vtu(stream, mesh0->comm(), &mesh1);
   auto opts = MeshCompareOpts::init(mesh0, VarCompareOpts::zero_tolerance());
@@ -1147,7 +1324,24 @@ static void test_read_vtu(Mesh* mesh0) {
 
 static void test_read_vtu(Library* lib) {
   auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 1, 1, 1);
-  test_read_vtu(&mesh0);
+  test_read_vtu(&mesh0, OMEGA_H_DEFAULT_COMPRESS, false);
+  test_read_vtu(&mesh0, false, true);
+#ifdef OMEGA_H_USE_ZLIB
+  test_read_vtu(&mesh0, true, true);
+#endif
+}
+
+static void test_appended_writer(Library* lib) {
+  auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 1, 1, 1);
+  vtk::Writer writer("appended_writer", &mesh0, -1, 0.0,
+      OMEGA_H_DEFAULT_COMPRESS, false, true);
+  writer.write();
+  Mesh mesh1(lib);
+  vtk::read_parallel(
+      "appended_writer/steps/step_0/pieces.pvtu", lib->world(), &mesh1);
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&mesh0, &mesh1, opts, true, false));
 }
 
 int main(int argc, char** argv) {
@@ -1156,10 +1350,17 @@ int main(int argc, char** argv) {
   if (lib.world()->size() == 1) {
     test_file_components();
     test_file(&lib);
+    test_compare_meshes(&lib);
+    test_incremental_file(&lib);
+    test_shared_geometry_writer(&lib);
+    test_xdmf(&lib);
     test_xml();
+    test_base64();
     test_read_vtu(&lib);
+    test_appended_writer(&lib);
   }
   test_gmsh(&lib);
+  test_gmsh_binary(&lib);
 #ifdef OMEGA_H_USE_GMSH
   test_gmsh_parallel(&lib);
 #endif  // OMEGA_H_USE_GMSH
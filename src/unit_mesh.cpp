@@ -2,18 +2,27 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_bbox.hpp"
 #include "Omega_h_build.hpp"
+#include "Omega_h_coarsen.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_confined.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_hilbert.hpp"
+#include "Omega_h_histogram.hpp"
 #include "Omega_h_hypercube.hpp"
+#include "Omega_h_indset.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_random.hpp"
 #include "Omega_h_recover.hpp"
+#include "Omega_h_refine.hpp"
 #include "Omega_h_refine_qualities.hpp"
 #include "Omega_h_shape.hpp"
+#include "Omega_h_smooth.hpp"
+#include "Omega_h_swap.hpp"
 #include "Omega_h_swap2d.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
@@ -304,6 +313,52 @@ static void test_star(Library* lib) {
   }
 }
 
+static bool is_maximal_indset(
+    Graph graph, Read<I8> candidates, Read<I8> indset) {
+  auto h_offsets = HostRead<LO>(graph.a2ab);
+  auto h_adj = HostRead<LO>(graph.ab2b);
+  auto h_cands = HostRead<I8>(candidates);
+  auto h_indset = HostRead<I8>(indset);
+  for (LO i = 0; i < h_cands.size(); ++i) {
+    if (h_indset[i] && !h_cands[i]) return false;
+    bool has_neighbor_in = false;
+    for (auto j = h_offsets[i]; j < h_offsets[i + 1]; ++j) {
+      if (h_indset[h_adj[j]]) has_neighbor_in = true;
+    }
+    if (h_indset[i] && has_neighbor_in) return false;
+    if (h_cands[i] && !h_indset[i] && !has_neighbor_in) return false;
+  }
+  return true;
+}
+
+static void test_indset(Library* lib) {
+  for (Int dim = 2; dim <= 3; ++dim) {
+    auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1.,
+        (dim == 3) ? 1. : 0., 4, 4, (dim == 3) ? 4 : 0);
+    for (Int ent_dim = VERT; ent_dim <= EDGE; ++ent_dim) {
+      auto nents = mesh.nents(ent_dim);
+      Write<I8> cands_w(nents);
+      Write<Real> quals_w(nents);
+      auto f = OMEGA_H_LAMBDA(LO i) {
+        cands_w[i] = I8((i % 3) != 1);
+        quals_w[i] = Real((i * 7) % 11);
+      };
+      parallel_for(nents, f);
+      Read<I8> cands(cands_w);
+      Reals quals(quals_w);
+      /* the first call builds only the candidate rows of the star */
+      auto indset = find_indset(&mesh, ent_dim, quals, cands);
+      auto expected =
+          find_indset(&mesh, ent_dim, mesh.ask_star(ent_dim), quals, cands);
+      OMEGA_H_CHECK(indset == expected);
+      OMEGA_H_CHECK(get_max(indset) == 1);
+      auto randomized = find_indset(&mesh, ent_dim, quals, cands, 4);
+      OMEGA_H_CHECK(
+          is_maximal_indset(mesh.ask_star(ent_dim), cands, randomized));
+    }
+  }
+}
+
 static void test_dual(Library* lib) {
   Mesh mesh(lib);
   build_from_elems2verts(&mesh, OMEGA_H_SIMPLEX, 2, LOs({0, 1, 2, 2, 3, 0}), 4);
@@ -390,6 +445,139 @@ static void test_refine_qualities(Library* lib) {
       quals, Reals({0.494872, 0.494872, 0.866025, 0.494872, 0.494872}), 1e-4));
 }
 
+static void test_refine_and_coarsen(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  auto coords = mesh.coords();
+  Write<Real> metrics_w(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto h = (coords[v * 2] < 0.3) ? 0.05 : 0.3;
+    metrics_w[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "metric", 1, Reals(metrics_w));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  while (refine_and_coarsen_by_size(&mesh, opts))
+    ;
+  OMEGA_H_CHECK(are_close(get_sum(mesh.ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) >= opts.min_quality_allowed);
+  OMEGA_H_CHECK(get_max(mesh.ask_lengths()) <= opts.max_length_desired);
+}
+
+static Int refine_uniformly(Mesh* mesh, bool multiple_edges) {
+  mesh->add_tag(VERT, "metric", 1,
+      Reals(mesh->nverts(), metric_eigenvalue_from_length(0.1)));
+  mesh->add_tag(VERT, "u", mesh->dim(), mesh->coords());
+  auto opts = AdaptOpts(mesh);
+  opts.verbosity = SILENT;
+  opts.should_refine_multiple_edges = multiple_edges;
+  opts.xfer_opts.type_map["u"] = OMEGA_H_LINEAR_INTERP;
+  Int npasses = 0;
+  while (refine_by_size(mesh, opts)) ++npasses;
+  OMEGA_H_CHECK(are_close(get_sum(mesh->ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh->ask_qualities()) >= opts.min_quality_allowed);
+  OMEGA_H_CHECK(get_max(mesh->ask_lengths()) <= opts.max_length_desired);
+  OMEGA_H_CHECK(are_close(mesh->get_array<Real>(VERT, "u"), mesh->coords()));
+  return npasses;
+}
+
+static void test_refine_multiple_edges(Library* lib) {
+  auto single = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  auto multiple =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  auto nsingle_passes = refine_uniformly(&single, false);
+  auto nmultiple_passes = refine_uniformly(&multiple, true);
+  OMEGA_H_CHECK(nmultiple_passes < nsingle_passes);
+  OMEGA_H_CHECK(multiple.nelems() == single.nelems());
+}
+
+static void test_adapt_budget(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 2, 2, 0);
+  mesh.add_tag(VERT, "metric", 1,
+      Reals(mesh.nverts(), metric_eigenvalue_from_length(0.05)));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.max_adapt_rebuilds = 2;
+  OMEGA_H_CHECK(adapt(&mesh, opts) == ADAPT_OUT_OF_REBUILDS);
+  OMEGA_H_CHECK(are_close(get_sum(mesh.ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) >= opts.min_quality_allowed);
+  auto nelems = mesh.nelems();
+  opts.max_adapt_rebuilds = -1;
+  OMEGA_H_CHECK(adapt(&mesh, opts) == ADAPT_SATISFIED);
+  OMEGA_H_CHECK(mesh.nelems() > nelems);
+  OMEGA_H_CHECK(adapt(&mesh, opts) == ADAPT_UNCHANGED);
+}
+
+static Mesh build_perturbed_box(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  auto coords = mesh.coords();
+  auto class_dims = mesh.get_array<I8>(VERT, "class_dim");
+  auto random =
+      unit_uniform_random_reals_from_globals(mesh.globals(VERT), 7, 0);
+  Write<Real> new_coords(coords.size());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    for (Int i = 0; i < 3; ++i) new_coords[v * 3 + i] = coords[v * 3 + i];
+    if (class_dims[v] == 3) new_coords[v * 3] += (random[v] - 0.5) * 0.225;
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.set_coords(new_coords);
+  add_implied_isos_tag(&mesh);
+  return mesh;
+}
+
+static Int swap_perturbed_box(Library* lib, Int nrebuilds) {
+  auto mesh = build_perturbed_box(lib);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.min_quality_desired = 0.5;
+  opts.nswap_rebuilds_per_ghost = nrebuilds;
+  auto old_min_qual = get_min(mesh.ask_qualities());
+  Int nghostings = 0;
+  while (swap_edges(&mesh, opts)) ++nghostings;
+  OMEGA_H_CHECK(are_close(get_sum(mesh.ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) >= old_min_qual);
+  return nghostings;
+}
+
+static void test_swap_rebuilds(Library* lib) {
+  OMEGA_H_CHECK(swap_perturbed_box(lib, 4) < swap_perturbed_box(lib, 1));
+}
+
+static void test_smooth_verts(Library* lib) {
+  auto mesh = build_perturbed_box(lib);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.min_quality_desired = 0.5;
+  auto nelems = mesh.nelems();
+  auto old_min_qual = get_min(mesh.ask_qualities());
+  auto old_coords = mesh.coords();
+  auto linear_field = [](Reals coords) {
+    Write<Real> out(divide_no_remainder(coords.size(), 3));
+    auto f = OMEGA_H_LAMBDA(LO v) {
+      out[v] = coords[v * 3] + 2.0 * coords[v * 3 + 1] - coords[v * 3 + 2];
+    };
+    parallel_for(out.size(), f);
+    return Reals(out);
+  };
+  mesh.add_tag(VERT, "u", 1, linear_field(old_coords));
+  opts.xfer_opts.type_map["u"] = OMEGA_H_LINEAR_INTERP;
+  mesh.add_tag(mesh.dim(), "density", 1, Reals(mesh.nelems(), 1.0));
+  opts.xfer_opts.type_map["density"] = OMEGA_H_CONSERVE;
+  opts.xfer_opts.integral_map["density"] = "mass";
+  OMEGA_H_CHECK(!smooth_verts(&mesh, opts));
+  opts.xfer_opts.type_map.erase("density");
+  OMEGA_H_CHECK(smooth_verts(&mesh, opts));
+  OMEGA_H_CHECK(mesh.nelems() == nelems);
+  OMEGA_H_CHECK(are_close(get_sum(mesh.ask_sizes()), 1.0));
+  OMEGA_H_CHECK(get_min(mesh.ask_qualities()) > old_min_qual);
+  auto bdry2verts =
+      collect_marked(invert_marks(mark_by_class_dim(&mesh, VERT, 3)));
+  OMEGA_H_CHECK(read(unmap(bdry2verts, mesh.coords(), 3)) ==
+                read(unmap(bdry2verts, old_coords, 3)));
+  OMEGA_H_CHECK(are_close(
+      mesh.get_array<Real>(VERT, "u"), linear_field(mesh.coords())));
+}
+
 static void test_mark_up_down(Library* lib) {
   auto mesh = Mesh(lib);
   build_box_internal(&mesh, OMEGA_H_SIMPLEX, 1., 1., 0., 1, 1, 0);
@@ -408,6 +596,23 @@ static void test_compare_meshes(Library* lib) {
   OMEGA_H_CHECK(!(a == b));
 }
 
+static void test_field_stats(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 2, 2, 0);
+  Reals values(Read<Real>(mesh.nverts(), 0.0, 1.0));
+  FieldStatsInput input = {VERT, values, 4, 0.0, 6.0, {1.0, 7.0}};
+  auto stats = get_field_stats(&mesh, {input})[0];
+  OMEGA_H_CHECK(stats.count == 9);
+  OMEGA_H_CHECK(stats.minmax.min == 0.0 && stats.minmax.max == 8.0);
+  OMEGA_H_CHECK(are_close(stats.mean, 4.0));
+  OMEGA_H_CHECK(stats.nlow == 1 && stats.nhigh == 1);
+  OMEGA_H_CHECK(stats.nunder == 0 && stats.nover == 2);
+  OMEGA_H_CHECK(stats.histogram.bins == std::vector<GO>({2, 1, 2, 2}));
+  OMEGA_H_CHECK(are_close(stats.quantile(0.5), 4.125));
+  OMEGA_H_CHECK(are_close(stats.quantile(1.0), 8.0));
+  auto histogram = get_histogram(&mesh, VERT, 4, 0.0, 6.0, values);
+  OMEGA_H_CHECK(histogram.bins == stats.histogram.bins);
+}
+
 static void test_swap2d_topology(Library* lib) {
   auto mesh = Mesh(lib);
   build_box_internal(&mesh, OMEGA_H_SIMPLEX, 1., 1., 0., 1, 1, 0);
@@ -753,13 +958,20 @@ int main(int argc, char** argv) {
   test_bbox();
   test_build(&lib);
   test_star(&lib);
+  test_indset(&lib);
   test_dual(&lib);
   test_quality();
   test_inertial_bisect(&lib);
   test_average_field(&lib);
   test_refine_qualities(&lib);
+  test_refine_and_coarsen(&lib);
+  test_refine_multiple_edges(&lib);
+  test_swap_rebuilds(&lib);
+  test_smooth_verts(&lib);
+  test_adapt_budget(&lib);
   test_mark_up_down(&lib);
   test_compare_meshes(&lib);
+  test_field_stats(&lib);
   test_swap2d_topology(&lib);
   test_swap3d_loop(&lib);
   test_element_implied_metric();
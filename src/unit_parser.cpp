@@ -4,6 +4,7 @@
 #include <Omega_h_finite_automaton.hpp>
 #include <Omega_h_language.hpp>
 #include <Omega_h_library.hpp>
+#include <Omega_h_math_lang.hpp>
 #include <Omega_h_parser.hpp>
 #include <Omega_h_reader.hpp>
 #include <Omega_h_regex.hpp>
@@ -229,6 +230,52 @@ static void test_yaml_reader() {
   test_yaml_reader("---\npressure: -1.9e-6\nvolume: 0.7e+10\n...\n");
 }
 
+static void test_compiled_reader_tables(
+    std::string const& name, LanguagePtr lang) {
+  auto compiled = get_compiled_reader_tables(name, *lang);
+#ifdef OMEGA_H_COMPILED_READER_TABLES
+  OMEGA_H_CHECK(compiled);
+#else
+  if (!compiled) return;
+#endif
+  auto built = build_reader_tables(*lang);
+  auto& actions = compiled->parser.terminal_table.data;
+  auto& built_actions = built->parser.terminal_table.data;
+  OMEGA_H_CHECK(actions.size() == built_actions.size());
+  for (std::size_t i = 0; i < actions.size(); ++i) {
+    OMEGA_H_CHECK(actions[i].kind == built_actions[i].kind);
+    if (actions[i].kind == ACTION_SHIFT) {
+      OMEGA_H_CHECK(actions[i].next_state == built_actions[i].next_state);
+    } else if (actions[i].kind == ACTION_REDUCE) {
+      OMEGA_H_CHECK(actions[i].production == built_actions[i].production);
+    }
+  }
+  OMEGA_H_CHECK(compiled->parser.nonterminal_table.data ==
+                built->parser.nonterminal_table.data);
+  OMEGA_H_CHECK(compiled->lexer.table.data == built->lexer.table.data);
+  OMEGA_H_CHECK(
+      compiled->lexer.accepted_tokens == built->lexer.accepted_tokens);
+  OMEGA_H_CHECK(compiled->indent_info.is_sensitive ==
+                built->indent_info.is_sensitive);
+  OMEGA_H_CHECK(compiled->indent_info.indent_token ==
+                built->indent_info.indent_token);
+  OMEGA_H_CHECK(compiled->indent_info.dedent_token ==
+                built->indent_info.dedent_token);
+  OMEGA_H_CHECK(compiled->indent_info.newline_token ==
+                built->indent_info.newline_token);
+  /* a changed language must not pick up stale tables */
+  auto changed = *lang;
+  changed.tokens.back().name += "_changed";
+  OMEGA_H_CHECK(!get_compiled_reader_tables(name, changed));
+}
+
+static void test_compiled_reader_tables() {
+  test_compiled_reader_tables("math_lang", math_lang::ask_language());
+  test_compiled_reader_tables("xml", xml::ask_language());
+  test_compiled_reader_tables("yaml", yaml::ask_language());
+  OMEGA_H_CHECK(!find_compiled_reader_tables("no_such_language"));
+}
+
 static void test_hydro() {
   auto str = "vector((x > 0.5) ? 0.01 : 0.0)";
   ExprOpsReader reader;
@@ -254,5 +301,6 @@ int main(int argc, char** argv) {
   test_xml_reader();
   test_yaml_language();
   test_yaml_reader();
+  test_compiled_reader_tables();
   test_hydro();
 }